@@ -0,0 +1,103 @@
+#include "NN-CLI_CheckpointWriter.hpp"
+
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <iostream>
+#include <stdexcept>
+
+namespace NN_CLI {
+
+//===================================================================================================================//
+
+CheckpointWriter::CheckpointWriter(LogLevel logLevel)
+    : logLevel(logLevel), pool(std::make_unique<QThreadPool>()) {
+  this->pool->setMaxThreadCount(1);
+}
+
+//===================================================================================================================//
+
+CheckpointWriter::~CheckpointWriter() {
+  this->wait();
+}
+
+//===================================================================================================================//
+
+void CheckpointWriter::submit(const std::string& filePath, Job job) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  if (this->pending.has_value()) {
+    this->numSkipped++;
+    if (this->logLevel >= LogLevel::WARNING) {
+      std::cerr << "\nWarning: checkpoint " << this->pending->filePath
+                << " skipped; the previous checkpoint is still being written.\n";
+    }
+  }
+  this->pending = Pending{filePath, std::move(job)};
+
+  if (!this->writing) {
+    this->writing = true;
+    this->worker = QtConcurrent::run(this->pool.get(), [this]() { this->drain(); });
+  }
+}
+
+//===================================================================================================================//
+
+void CheckpointWriter::wait() {
+  for (;;) {
+    QFuture<void> current;
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (!this->writing) return;
+      current = this->worker;
+    }
+    current.waitForFinished();
+  }
+}
+
+//===================================================================================================================//
+
+ulong CheckpointWriter::getNumWritten() const {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->numWritten;
+}
+
+//===================================================================================================================//
+
+ulong CheckpointWriter::getNumSkipped() const {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->numSkipped;
+}
+
+//===================================================================================================================//
+
+void CheckpointWriter::drain() {
+  for (;;) {
+    Pending next;
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (!this->pending.has_value()) {
+        this->writing = false;
+        return;
+      }
+      next = std::move(*this->pending);
+      this->pending.reset();
+    }
+
+    // A failed checkpoint is reported but does not stop training
+    try {
+      next.job();
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->numWritten++;
+      if (this->logLevel > LogLevel::QUIET) std::cout << "\nCheckpoint saved to: " << next.filePath << "\n";
+    } catch (const std::exception& e) {
+      if (this->logLevel >= LogLevel::ERROR) {
+        std::cerr << "\nError: failed to save checkpoint " << next.filePath << ": " << e.what() << "\n";
+      }
+    }
+  }
+}
+
+//===================================================================================================================//
+
+} // namespace NN_CLI
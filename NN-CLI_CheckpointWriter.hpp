@@ -0,0 +1,70 @@
+#ifndef NN_CLI_CHECKPOINTWRITER_HPP
+#define NN_CLI_CHECKPOINTWRITER_HPP
+
+#include "NN-CLI_LogLevel.hpp"
+
+#include <QFuture>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include <sys/types.h>
+
+class QThreadPool;
+
+//===================================================================================================================//
+
+namespace NN_CLI {
+
+/**
+ * CheckpointWriter: writes training checkpoints on a background thread.
+ *
+ * The training callback snapshots the model (document and a copy of the parameters) into a job
+ * and submits it; serialising and writing happen off the training thread. At most one job is
+ * written and one waits at any time: a job submitted while another is still waiting replaces it,
+ * so a slow disk skips intermediate checkpoints instead of queuing parameter copies without bound.
+ */
+class CheckpointWriter {
+  public:
+    // Writes a snapshot to the file passed to submit(). Throws on failure.
+    using Job = std::function<void()>;
+
+    explicit CheckpointWriter(LogLevel logLevel);
+    ~CheckpointWriter();
+
+    // Queue a snapshot for writing to filePath, replacing any snapshot not yet started.
+    void submit(const std::string& filePath, Job job);
+
+    // Block until every submitted snapshot has been written or replaced.
+    void wait();
+
+    ulong getNumWritten() const;
+    ulong getNumSkipped() const;
+
+  private:
+    struct Pending {
+      std::string filePath;
+      Job job;
+    };
+
+    LogLevel logLevel;
+    std::unique_ptr<QThreadPool> pool;
+
+    mutable std::mutex mutex;
+    std::optional<Pending> pending;
+    bool writing = false;
+    QFuture<void> worker;
+    ulong numWritten = 0;
+    ulong numSkipped = 0;
+
+    void drain();
+};
+
+} // namespace NN_CLI
+
+//===================================================================================================================//
+
+#endif // NN_CLI_CHECKPOINTWRITER_HPP
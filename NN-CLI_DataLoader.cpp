@@ -1,15 +1,15 @@
 #include "NN-CLI_DataLoader.hpp"
+#include "NN-CLI_Parallel.hpp"
+#include "NN-CLI_SamplesReader.hpp"
 
-#include <QFile>
 #include <QFileInfo>
 
-#include <json.hpp>
-
 #include <QThreadPool>
 #include <QtConcurrent>
 
 #include <algorithm>
 #include <iostream>
+#include <numeric>
 #include <stdexcept>
 
 namespace NN_CLI {
@@ -31,44 +31,41 @@ void DataLoader<SampleT>::loadManifest(const std::string& samplesFilePath, const
   this->outputW = outputW;
   this->baseDir = QFileInfo(QString::fromStdString(samplesFilePath)).absolutePath().toStdString();
 
-  QFile file(QString::fromStdString(samplesFilePath));
-  if (!file.open(QIODevice::ReadOnly))
-    throw std::runtime_error("Failed to open samples file: " + samplesFilePath);
-
-  QByteArray fileData = file.readAll();
-  nlohmann::json json = nlohmann::json::parse(fileData.toStdString());
-  const nlohmann::json& samplesArray = json.at("samples");
+  // Stream the samples array straight into manifest entries — no JSON DOM is built
+  SamplesReader reader(samplesFilePath);
+  ulong numSamples = reader.openArray("samples");
 
   this->manifest.clear();
-  this->manifest.reserve(samplesArray.size());
+  this->manifest.resize(numSamples);
 
-  for (const auto& sampleJson : samplesArray) {
-    SampleManifest entry;
+  // Elements are parsed concurrently, each into its own preallocated slot
+  Parallel::forEach(numSamples, [&](ulong i) {
+    StreamedSample streamed = reader.readSample(i);
+    SampleManifest& entry = this->manifest[i];
 
     // Store input reference (path or raw data — but do NOT load images)
     if (ioConfig.inputType == DataType::IMAGE) {
-      entry.inputPath = sampleJson.at("input").get<std::string>();
+      entry.inputPath = SamplesReader::takePath(streamed.input, "input");
       entry.inputIsImage = true;
     } else {
-      entry.inputData = sampleJson.at("input").get<std::vector<float>>();
+      entry.inputData = SamplesReader::takeData(streamed.input, "input");
       entry.inputIsImage = false;
     }
 
     // Store output reference
     if (ioConfig.outputType == DataType::IMAGE) {
-      entry.outputPath = sampleJson.at("output").get<std::string>();
+      entry.outputPath = SamplesReader::takePath(streamed.output, "output");
       entry.outputIsImage = true;
     } else {
-      entry.output = sampleJson.at("output").get<std::vector<float>>();
+      entry.output = SamplesReader::takeData(streamed.output, "output");
       entry.outputIsImage = false;
     }
-
-    this->manifest.push_back(std::move(entry));
-  }
+  }, "", 0, this->ioPool.get());
 
   // Initialize entries as 1:1 mapping to manifest (no augmentation yet)
-  this->fromMemory = false;
+  this->source = SampleSource::MANIFEST;
   this->memorySamples.clear();
+  this->mapped.reset();
   this->entries.clear();
   this->entries.reserve(this->manifest.size());
   for (ulong i = 0; i < this->manifest.size(); i++) {
@@ -82,12 +79,14 @@ void DataLoader<SampleT>::loadManifest(const std::string& samplesFilePath, const
 
 template <typename SampleT>
 void DataLoader<SampleT>::loadFromMemory(std::vector<SampleT>&& samples,
-                                          int inputC, int inputH, int inputW) {
+                                          int inputC, int inputH, int inputW,
+                                          PackedElementType storage) {
   this->inputC = inputC;
   this->inputH = inputH;
   this->inputW = inputW;
-  this->fromMemory = true;
+  this->source = SampleSource::MEMORY;
   this->manifest.clear();
+  this->mapped.reset();
   this->memorySamples = std::move(samples);
 
   this->entries.clear();
@@ -95,19 +94,177 @@ void DataLoader<SampleT>::loadFromMemory(std::vector<SampleT>&& samples,
   for (ulong i = 0; i < this->memorySamples.size(); i++) {
     this->entries.push_back({i, false});
   }
+
+  if (storage != PackedElementType::FLOAT32) this->makeResident(storage);
 }
 
 //===================================================================================================================//
-//-- planAugmentation --//
+//-- loadPacked --//
+//===================================================================================================================//
+
+template <typename SampleT>
+void DataLoader<SampleT>::loadPacked(const std::string& packedFilePath,
+                                      int inputC, int inputH, int inputW) {
+  auto dataset = std::make_shared<PackedDataset>();
+  dataset->open(packedFilePath);
+  this->useMapped(std::move(dataset), "Packed dataset input", inputC, inputH, inputW);
+}
+
+//===================================================================================================================//
+//-- loadIDX --//
+//===================================================================================================================//
+
+template <typename SampleT>
+void DataLoader<SampleT>::loadIDX(const std::string& dataPath, const std::string& labelsPath,
+                                   int inputC, int inputH, int inputW) {
+  auto dataset = std::make_shared<IDXDataset>();
+  dataset->open(dataPath, labelsPath);
+  this->useMapped(std::move(dataset), "IDX data item", inputC, inputH, inputW);
+}
+
+//===================================================================================================================//
+//-- loadNpy --//
+//===================================================================================================================//
+
+template <typename SampleT>
+void DataLoader<SampleT>::loadNpy(const std::string& inputsPath, const std::string& outputsPath,
+                                   int inputC, int inputH, int inputW) {
+  auto dataset = std::make_shared<NpyDataset>();
+  dataset->open(inputsPath, outputsPath);
+  this->useMapped(std::move(dataset), "NumPy input row", inputC, inputH, inputW);
+}
+
+//===================================================================================================================//
+//-- loadShards --//
+//===================================================================================================================//
+
+template <typename SampleT>
+void DataLoader<SampleT>::loadShards(const std::vector<std::string>& shardPaths,
+                                      int inputC, int inputH, int inputW, ulong shuffleBufferSize,
+                                      bool streamed) {
+  auto dataset = std::make_shared<ShardedDataset>();
+  dataset->open(shardPaths);
+  this->useMapped(std::move(dataset), "Shard input", inputC, inputH, inputW);
+  this->shuffleBufferSize = shuffleBufferSize;
+  this->streamShards = streamed;
+}
+
+//===================================================================================================================//
+
+template <typename SampleT>
+void DataLoader<SampleT>::useMapped(std::shared_ptr<MappedDataset> dataset, const std::string& kind,
+                                     int inputC, int inputH, int inputW) {
+  ulong expectedSize = static_cast<ulong>(inputC) * inputH * inputW;
+  if (expectedSize > 0 && dataset->numSamples() > 0 && dataset->inputSize() != expectedSize) {
+    throw std::runtime_error(kind + " size (" + std::to_string(dataset->inputSize()) +
+      ") does not match expected input shape size (" + std::to_string(expectedSize) + ")");
+  }
+
+  this->inputC = inputC;
+  this->inputH = inputH;
+  this->inputW = inputW;
+  this->source = SampleSource::MAPPED;
+  this->manifest.clear();
+  this->memorySamples.clear();
+  this->mapped = std::move(dataset);
+
+  this->entries.clear();
+  this->entries.reserve(this->mapped->numSamples());
+  for (ulong i = 0; i < this->mapped->numSamples(); i++) {
+    this->entries.push_back({i, false});
+  }
+}
+
+//===================================================================================================================//
+//-- Source helpers --//
 //===================================================================================================================//
 
-// Helper to get the output vector from a sample (works for both ANN and CNN).
+// Helpers to get the flat input/output vectors from a sample (works for both ANN and CNN).
+static const std::vector<float>& sampleInput(const ANN::Sample<float>& s) { return s.input; }
+static const std::vector<float>& sampleInput(const CNN::Sample<float>& s) { return s.input.data; }
 static const std::vector<float>& sampleOutput(const ANN::Sample<float>& s) { return s.output; }
 static const std::vector<float>& sampleOutput(const CNN::Sample<float>& s) { return s.output; }
 
+template <typename SampleT>
+ulong DataLoader<SampleT>::numOriginalSamples() const {
+  switch (this->source) {
+    case SampleSource::MEMORY: return this->memorySamples.size();
+    case SampleSource::MAPPED: return this->mapped->numSamples();
+    case SampleSource::MANIFEST: break;
+  }
+  return this->manifest.size();
+}
+
+template <typename SampleT>
+std::vector<float> DataLoader<SampleT>::originalOutput(ulong sourceIndex) const {
+  switch (this->source) {
+    case SampleSource::MEMORY: return sampleOutput(this->memorySamples[sourceIndex]);
+    case SampleSource::MAPPED: return this->mapped->output(sourceIndex);
+    case SampleSource::MANIFEST: break;
+  }
+  return this->manifest[sourceIndex].output;
+}
+
+//===================================================================================================================//
+//-- makeResident --//
+//===================================================================================================================//
+
+template <typename SampleT>
+size_t DataLoader<SampleT>::makeResident(PackedElementType inputType, PackedElementType outputType) {
+  ulong count = this->numOriginalSamples();
+  if (this->entries.size() != count) {
+    throw std::runtime_error("Resident storage must be set up before augmentation is planned");
+  }
+  if (count == 0) return 0;
+
+  // Decode in bounded chunks (in parallel on ioPool), so only one chunk is ever held as float
+  const ulong chunkSize = 256;
+  std::shared_ptr<ResidentDataset> dataset;
+  std::vector<ulong> indices;
+
+  for (ulong start = 0; start < count; start += chunkSize) {
+    indices.resize(std::min(chunkSize, count - start));
+    std::iota(indices.begin(), indices.end(), start);
+
+    std::vector<SampleT> chunk = this->loadBatch(indices, {}, 0.0f);
+
+    for (ulong i = 0; i < chunk.size(); i++) {
+      const std::vector<float>& input = sampleInput(chunk[i]);
+      const std::vector<float>& output = sampleOutput(chunk[i]);
+
+      if (!dataset) {
+        dataset = std::make_shared<ResidentDataset>(count, input.size(), inputType, output.size(), outputType);
+      }
+      if (input.size() != dataset->inputSize() || output.size() != dataset->outputSize()) {
+        throw std::runtime_error("Resident storage requires all samples to have the same input and output sizes");
+      }
+
+      dataset->setSample(start + i, input.data(), output.data());
+    }
+  }
+
+  size_t bytes = dataset->byteSize();
+  this->useMapped(std::move(dataset), "Resident dataset input", this->inputC, this->inputH, this->inputW);
+  return bytes;
+}
+
+//===================================================================================================================//
+//-- setCacheBudget --//
+//===================================================================================================================//
+
+template <typename SampleT>
+void DataLoader<SampleT>::setCacheBudget(size_t byteBudget) {
+  if (byteBudget == 0) this->sampleCache.reset();
+  else this->sampleCache = std::make_shared<SampleCache<SampleT>>(byteBudget);
+}
+
+//===================================================================================================================//
+//-- planAugmentation --//
+//===================================================================================================================//
+
 template <typename SampleT>
 void DataLoader<SampleT>::planAugmentation(ulong augmentationFactor, bool balanceAugmentation) {
-  ulong originalCount = this->fromMemory ? this->memorySamples.size() : this->manifest.size();
+  ulong originalCount = this->numOriginalSamples();
   if (augmentationFactor == 0 && !balanceAugmentation) return;
   if (originalCount == 0) return;
 
@@ -119,10 +276,7 @@ void DataLoader<SampleT>::planAugmentation(ulong augmentationFactor, bool balanc
 
   std::map<ulong, std::vector<ulong>> classIndices;
   for (ulong i = 0; i < originalCount; i++) {
-    const std::vector<float>& output = this->fromMemory
-        ? sampleOutput(this->memorySamples[i])
-        : this->manifest[i].output;
-    ulong cls = getClassIndex(output);
+    ulong cls = getClassIndex(this->originalOutput(i));
     classIndices[cls].push_back(i);
   }
 
@@ -169,10 +323,7 @@ std::vector<std::vector<float>> DataLoader<SampleT>::getAllOutputs() const {
   std::vector<std::vector<float>> outputs;
   outputs.reserve(this->entries.size());
   for (const auto& entry : this->entries) {
-    if (this->fromMemory)
-      outputs.push_back(sampleOutput(this->memorySamples[entry.sourceIndex]));
-    else
-      outputs.push_back(this->manifest[entry.sourceIndex].output);
+    outputs.push_back(this->originalOutput(entry.sourceIndex));
   }
   return outputs;
 }
@@ -213,7 +364,7 @@ DataLoader<SampleT>::loadBatch(const std::vector<ulong>& entryIndices,
       std::mt19937 rng(std::random_device{}());
 
       for (ulong i = chunkStart; i < chunkEnd; i++) {
-        batch[i] = this->loadSample(entryIndices[i], rng, transforms, augmentationProbability);
+        this->loadSample(entryIndices[i], batch[i], rng, transforms, augmentationProbability);
       }
     }));
   }
@@ -227,6 +378,12 @@ template <typename SampleT>
 typename DataLoader<SampleT>::ProviderT
 DataLoader<SampleT>::makeSampleProvider(const Loader::AugmentationTransforms& transforms,
                                        float augmentationProbability) const {
+  // Sharded sources are streamed in file order rather than read at the trainer's random indices
+  auto sharded = std::dynamic_pointer_cast<const ShardedDataset>(this->mapped);
+  if (sharded && this->streamShards) {
+    return this->makeStreamingProvider(*sharded, transforms, augmentationProbability);
+  }
+
   // Dedicated single-thread pool for prefetch orchestration — independent of
   // both the global pool (used by training) and ioPool (used by loadBatch).
   auto prefetchPool = std::make_shared<QThreadPool>();
@@ -274,35 +431,163 @@ DataLoader<SampleT>::makeSampleProvider(const Loader::AugmentationTransforms& tr
   };
 }
 
+//===================================================================================================================//
+//-- Streaming provider (sharded source) --//
+//===================================================================================================================//
+
+template <typename SampleT>
+typename DataLoader<SampleT>::ProviderT
+DataLoader<SampleT>::makeStreamingProvider(const ShardedDataset& shardedDataset,
+                                           const Loader::AugmentationTransforms& transforms,
+                                           float augmentationProbability) const {
+  auto prefetchPool = std::make_shared<QThreadPool>();
+  prefetchPool->setMaxThreadCount(1);
+
+  // Original entries map 1:1 to records; augmented copies are streamed right after their source record
+  auto state = std::make_shared<StreamState>();
+  for (ulong i = this->numOriginalSamples(); i < this->entries.size(); i++) {
+    state->augmentedEntries.push_back(i);
+  }
+  std::stable_sort(state->augmentedEntries.begin(), state->augmentedEntries.end(),
+                   [this](ulong a, ulong b) { return this->entries[a].sourceIndex < this->entries[b].sourceIndex; });
+
+  using BatchPtr = std::shared_ptr<std::vector<SampleT>>;
+  auto prefetch = std::make_shared<QFuture<BatchPtr>>();
+  auto hasPrefetch = std::make_shared<bool>(false);
+  const ShardedDataset* sharded = &shardedDataset;
+
+  return [this, sharded, prefetchPool, state, prefetch, hasPrefetch, transforms, augmentationProbability](
+      const std::vector<ulong>& sampleIndices, ulong batchSize, ulong batchIndex) -> std::vector<SampleT> {
+    ulong numSamples = sampleIndices.size();
+    ulong start = batchIndex * batchSize;
+    ulong end = std::min(start + batchSize, numSamples);
+
+    // Batches are drawn in sequence, so only the first one of an epoch is never prefetched
+    BatchPtr batchPtr;
+    if (*hasPrefetch) {
+      prefetch->waitForFinished();
+      batchPtr = prefetch->result();
+      *hasPrefetch = false;
+    } else {
+      if (batchIndex == 0) this->startStreamEpoch(*sharded, *state);
+      batchPtr = std::make_shared<std::vector<SampleT>>(
+          this->nextStreamedBatch(*state, end - start, transforms, augmentationProbability));
+    }
+
+    // Prefetch the next batch. The stream state is only touched by one call at a time:
+    // the next prefetch is started after this one has been collected.
+    if (end < numSamples) {
+      ulong nextCount = std::min(end + batchSize, numSamples) - end;
+      *prefetch = QtConcurrent::run(prefetchPool.get(),
+          [this, state, nextCount, transforms, augmentationProbability]() -> BatchPtr {
+            return std::make_shared<std::vector<SampleT>>(
+                this->nextStreamedBatch(*state, nextCount, transforms, augmentationProbability));
+          });
+      *hasPrefetch = true;
+    }
+
+    return std::move(*batchPtr);
+  };
+}
+
+//===================================================================================================================//
+
+template <typename SampleT>
+void DataLoader<SampleT>::startStreamEpoch(const ShardedDataset& shardedDataset, StreamState& state) const {
+  std::vector<ulong> shardOrder(shardedDataset.numShards());
+  std::iota(shardOrder.begin(), shardOrder.end(), 0);
+  std::shuffle(shardOrder.begin(), shardOrder.end(), state.rng);
+
+  state.order.clear();
+  state.order.reserve(this->entries.size());
+  state.cursor = 0;
+  state.buffer.clear();
+
+  auto bySource = [this](ulong entryIndex, ulong record) { return this->entries[entryIndex].sourceIndex < record; };
+
+  for (ulong shard : shardOrder) {
+    ulong begin = shardedDataset.shardBegin(shard);
+    ulong end = shardedDataset.shardEnd(shard);
+    auto augmented = std::lower_bound(state.augmentedEntries.begin(), state.augmentedEntries.end(), begin, bySource);
+
+    for (ulong record = begin; record < end; record++) {
+      state.order.push_back(record);
+      for (; augmented != state.augmentedEntries.end() && this->entries[*augmented].sourceIndex == record; ++augmented) {
+        state.order.push_back(*augmented);
+      }
+    }
+  }
+}
+
+//===================================================================================================================//
+
+template <typename SampleT>
+std::vector<SampleT> DataLoader<SampleT>::nextStreamedBatch(StreamState& state, ulong count,
+                                                            const Loader::AugmentationTransforms& transforms,
+                                                            float augmentationProbability) const {
+  // Keep shuffleBufferSize samples in the buffer after this batch is drawn. The refill reads the next
+  // stretch of the stream in order, so shards are read front to back (decoded in parallel on ioPool).
+  ulong target = this->shuffleBufferSize + count;
+  ulong toLoad = std::min(target - std::min(target, static_cast<ulong>(state.buffer.size())),
+                          static_cast<ulong>(state.order.size() - state.cursor));
+
+  if (toLoad > 0) {
+    std::vector<ulong> indices(state.order.begin() + state.cursor, state.order.begin() + state.cursor + toLoad);
+    state.cursor += toLoad;
+
+    std::vector<SampleT> loaded = this->loadBatch(indices, transforms, augmentationProbability);
+    for (auto& sample : loaded) state.buffer.push_back(std::move(sample));
+  }
+
+  std::vector<SampleT> batch;
+  batch.reserve(std::min(count, static_cast<ulong>(state.buffer.size())));
+
+  while (batch.size() < count && !state.buffer.empty()) {
+    std::uniform_int_distribution<ulong> dist(0, state.buffer.size() - 1);
+    std::swap(state.buffer[dist(state.rng)], state.buffer.back());
+    batch.push_back(std::move(state.buffer.back()));
+    state.buffer.pop_back();
+  }
+
+  return batch;
+}
+
 //===================================================================================================================//
 //-- loadSample specializations --//
 //===================================================================================================================//
 
 template <>
-ANN::Sample<float> DataLoader<ANN::Sample<float>>::loadSample(
-    ulong entryIndex, std::mt19937& rng,
+void DataLoader<ANN::Sample<float>>::loadSample(
+    ulong entryIndex, ANN::Sample<float>& sample, std::mt19937& rng,
     const Loader::AugmentationTransforms& transforms,
     float augmentationProbability) const {
   const AugmentedEntry& entry = this->entries[entryIndex];
 
-  ANN::Sample<float> sample;
-
-  if (this->fromMemory) {
+  if (this->source == SampleSource::MEMORY) {
     sample = this->memorySamples[entry.sourceIndex]; // copy
+  } else if (this->source == SampleSource::MAPPED) {
+    sample.input = this->mapped->input(entry.sourceIndex);
+    sample.output = this->mapped->output(entry.sourceIndex);
+  } else if (this->sampleCache && this->sampleCache->get(entry.sourceIndex, sample)) {
+    // Decoded in an earlier epoch — sample is a copy, so augmentation below leaves the cache intact
   } else {
     const SampleManifest& m = this->manifest[entry.sourceIndex];
     if (m.inputIsImage) {
       std::string fullPath = ImageLoader::resolvePath(m.inputPath, this->baseDir);
-      sample.input = ImageLoader::loadImage(fullPath, this->inputC, this->inputH, this->inputW);
+      sample.input.resize(static_cast<size_t>(this->inputC) * this->inputH * this->inputW);
+      ImageLoader::loadImage(fullPath, this->inputC, this->inputH, this->inputW, sample.input.data());
     } else {
       sample.input = m.inputData;
     }
     if (m.outputIsImage) {
       std::string fullPath = ImageLoader::resolvePath(m.outputPath, this->baseDir);
-      sample.output = ImageLoader::loadImage(fullPath, this->outputC, this->outputH, this->outputW);
+      sample.output.resize(static_cast<size_t>(this->outputC) * this->outputH * this->outputW);
+      ImageLoader::loadImage(fullPath, this->outputC, this->outputH, this->outputW, sample.output.data());
     } else {
       sample.output = m.output;
     }
+
+    if (this->sampleCache) this->sampleCache->put(entry.sourceIndex, sample);
   }
 
   // Apply augmentation if this is an augmented entry
@@ -315,46 +600,51 @@ ANN::Sample<float> DataLoader<ANN::Sample<float>>::loadSample(
       ImageLoader::addGaussianNoise(sample.input, transforms.gaussianNoise, rng);
     }
   }
-
-  return sample;
 }
 
 //===================================================================================================================//
 
 template <>
-CNN::Sample<float> DataLoader<CNN::Sample<float>>::loadSample(
-    ulong entryIndex, std::mt19937& rng,
+void DataLoader<CNN::Sample<float>>::loadSample(
+    ulong entryIndex, CNN::Sample<float>& sample, std::mt19937& rng,
     const Loader::AugmentationTransforms& transforms,
     float augmentationProbability) const {
   const AugmentedEntry& entry = this->entries[entryIndex];
 
-  CNN::Sample<float> sample;
-
-  if (this->fromMemory) {
+  if (this->source == SampleSource::MEMORY) {
     sample = this->memorySamples[entry.sourceIndex]; // copy
+  } else if (this->source == SampleSource::MAPPED) {
+    // Records are read straight into the slot's tensor, keeping its storage when it already has the right size
+    sample.input.shape = CNN::Shape3D{static_cast<ulong>(this->inputC),
+                                      static_cast<ulong>(this->inputH),
+                                      static_cast<ulong>(this->inputW)};
+    sample.input.data.resize(sample.input.shape.size());
+    this->mapped->readInput(entry.sourceIndex, sample.input.data.data());
+    sample.output = this->mapped->output(entry.sourceIndex);
+  } else if (this->sampleCache && this->sampleCache->get(entry.sourceIndex, sample)) {
+    // Decoded in an earlier epoch — sample is a copy, so augmentation below leaves the cache intact
   } else {
     const SampleManifest& m = this->manifest[entry.sourceIndex];
+    sample.input.shape = CNN::Shape3D{static_cast<ulong>(this->inputC),
+                                      static_cast<ulong>(this->inputH),
+                                      static_cast<ulong>(this->inputW)};
     if (m.inputIsImage) {
+      // The tensor is the only allocation: the image is decoded straight into it
       std::string fullPath = ImageLoader::resolvePath(m.inputPath, this->baseDir);
-      std::vector<float> flatInput = ImageLoader::loadImage(fullPath, this->inputC, this->inputH, this->inputW);
-      CNN::Shape3D shape{static_cast<ulong>(this->inputC),
-                         static_cast<ulong>(this->inputH),
-                         static_cast<ulong>(this->inputW)};
-      sample.input = CNN::Input<float>(shape);
-      sample.input.data = std::move(flatInput);
+      sample.input.data.resize(sample.input.shape.size());
+      ImageLoader::loadImage(fullPath, this->inputC, this->inputH, this->inputW, sample.input.data.data());
     } else {
-      CNN::Shape3D shape{static_cast<ulong>(this->inputC),
-                         static_cast<ulong>(this->inputH),
-                         static_cast<ulong>(this->inputW)};
-      sample.input = CNN::Input<float>(shape);
       sample.input.data = m.inputData;
     }
     if (m.outputIsImage) {
       std::string fullPath = ImageLoader::resolvePath(m.outputPath, this->baseDir);
-      sample.output = ImageLoader::loadImage(fullPath, this->outputC, this->outputH, this->outputW);
+      sample.output.resize(static_cast<size_t>(this->outputC) * this->outputH * this->outputW);
+      ImageLoader::loadImage(fullPath, this->outputC, this->outputH, this->outputW, sample.output.data());
     } else {
       sample.output = m.output;
     }
+
+    if (this->sampleCache) this->sampleCache->put(entry.sourceIndex, sample);
   }
 
   // Apply augmentation if this is an augmented entry
@@ -362,8 +652,6 @@ CNN::Sample<float> DataLoader<CNN::Sample<float>>::loadSample(
     ImageLoader::applyRandomTransforms(sample.input.data, this->inputC, this->inputH, this->inputW,
                                         rng, transforms, augmentationProbability);
   }
-
-  return sample;
 }
 
 //===================================================================================================================//
@@ -1,8 +1,14 @@
 #ifndef NN_CLI_DATALOADER_HPP
 #define NN_CLI_DATALOADER_HPP
 
+#include "NN-CLI_IDXDataset.hpp"
 #include "NN-CLI_ImageLoader.hpp"
 #include "NN-CLI_Loader.hpp"
+#include "NN-CLI_NpyDataset.hpp"
+#include "NN-CLI_PackedDataset.hpp"
+#include "NN-CLI_ResidentDataset.hpp"
+#include "NN-CLI_SampleCache.hpp"
+#include "NN-CLI_ShardedDataset.hpp"
 
 #include <ANN_Sample.hpp>
 #include <CNN_Sample.hpp>
@@ -30,11 +36,18 @@ struct SampleManifest {
   bool outputIsImage = false;           // Whether output is an image path
 };
 
+// Where the original (non-augmented) samples are read from.
+enum class SampleSource {
+  MANIFEST,  // JSON manifest — images decoded on demand
+  MEMORY,    // Fully loaded samples
+  MAPPED     // Packed/IDX/.npy file mapping or resident compact records — expanded to float per batch
+};
+
 // Entry in the expanded (augmented) sample list.
 // For original samples: sourceIndex == own index in the original list, augmented == false.
 // For augmented samples: sourceIndex == original sample index, augmented == true.
 struct AugmentedEntry {
-  ulong sourceIndex;  // Index into the original sample list (manifest or memorySamples)
+  ulong sourceIndex;  // Index into the original sample list (manifest, memorySamples or mapped)
   bool augmented;     // Whether to apply random transforms when loading
 };
 
@@ -53,8 +66,36 @@ class DataLoader {
                       int inputC, int inputH, int inputW,
                       int outputC = 0, int outputH = 0, int outputW = 0);
 
-    // Load from pre-loaded samples (e.g. IDX format). Stores samples in memory.
-    void loadFromMemory(std::vector<SampleT>&& samples, int inputC, int inputH, int inputW);
+    // Load from pre-loaded samples. Stores samples in memory, re-encoded compactly unless storage is FLOAT32.
+    void loadFromMemory(std::vector<SampleT>&& samples, int inputC, int inputH, int inputW,
+                        PackedElementType storage = PackedElementType::FLOAT32);
+
+    // Memory-map a packed dataset file (see PackedDataset). Samples are served straight from the mapping.
+    void loadPacked(const std::string& packedFilePath, int inputC, int inputH, int inputW);
+
+    // Memory-map an IDX data/labels pair (see IDXDataset). Items stay uint8 until a batch is assembled.
+    void loadIDX(const std::string& dataPath, const std::string& labelsPath, int inputC, int inputH, int inputW);
+
+    // Memory-map NumPy inputs and outputs/labels arrays (see NpyDataset). Rows are converted per batch.
+    void loadNpy(const std::string& inputsPath, const std::string& outputsPath, int inputC, int inputH, int inputW);
+
+    // Memory-map a dataset split into packed shard files (see ShardedDataset). The sample provider then streams
+    // the shards sequentially, in a new random shard order each epoch, drawing samples at random from a window
+    // of shuffleBufferSize loaded samples instead of following the trainer's shuffled indices.
+    // With streamed = false the shards are read like one packed file, at exactly the indices given (e.g. to re-pack).
+    void loadShards(const std::vector<std::string>& shardPaths, int inputC, int inputH, int inputW,
+                    ulong shuffleBufferSize, bool streamed = true);
+
+    // Decode every original sample once and keep it resident in RAM in the given encodings
+    // (UINT8 for images, FLOAT16 for vectors). Call before planAugmentation(). Returns the bytes held.
+    size_t makeResident(PackedElementType inputType, PackedElementType outputType = PackedElementType::FLOAT32);
+
+    // Keep decoded manifest samples in an LRU cache of up to byteBudget bytes across epochs
+    // (0 disables it). Augmented entries are transformed on a copy of the cached base sample.
+    void setCacheBudget(size_t byteBudget);
+
+    // The sample cache, or nullptr when disabled.
+    std::shared_ptr<SampleCache<SampleT>> getCache() const { return this->sampleCache; }
 
     // Compute augmentation plan (expand entries without loading data).
     void planAugmentation(ulong augmentationFactor, bool balanceAugmentation);
@@ -68,33 +109,74 @@ class DataLoader {
     // Build a SampleProvider with async prefetching for use with train().
     // The provider receives the full shuffled index array, batch size, and current batch index.
     // It returns the current batch's samples and prefetches the next batch in the background
-    // using a persistent worker thread.
+    // using a persistent worker thread. For a streamed sharded source only the array's size is used (see loadShards).
     ProviderT makeSampleProvider(const Loader::AugmentationTransforms& transforms = {},
                                  float augmentationProbability = 0.5f) const;
 
   private:
     std::vector<SampleManifest> manifest;   // Original samples — paths + labels (JSON path)
     std::vector<SampleT> memorySamples;     // Original samples — fully loaded (memory path)
-    bool fromMemory = false;                // Which source to use
+    std::shared_ptr<MappedDataset> mapped;  // Original samples — fixed-size records (packed/sharded/IDX/.npy/resident path)
+    SampleSource source = SampleSource::MANIFEST; // Which source to use
+    std::shared_ptr<SampleCache<SampleT>> sampleCache; // Decoded manifest samples (optional)
     std::vector<AugmentedEntry> entries;    // Expanded list (original + augmented)
     std::string baseDir;                    // Base directory for resolving relative paths
     int inputC = 0, inputH = 0, inputW = 0;
     int outputC = 0, outputH = 0, outputW = 0;
     IOConfig ioConfig;
+    ulong shuffleBufferSize = 0;            // Streaming window for sharded sources
+    bool streamShards = true;               // Sharded source read through the streaming provider
 
     // Dedicated thread pool for image loading — separate from the global pool
     // used by the training loop, so prefetch work doesn't compete with training.
-    std::shared_ptr<QThreadPool> ioPool = std::make_shared<QThreadPool>();
+    // Its workers never expire, so their ImageLoader scratch buffers are reused across batches.
+    std::shared_ptr<QThreadPool> ioPool = []() {
+      auto pool = std::make_shared<QThreadPool>();
+      pool->setExpiryTimeout(-1);
+      return pool;
+    }();
+
+    // Switch to a memory-mapped source, checking its input size against the given shape (if any).
+    void useMapped(std::shared_ptr<MappedDataset> dataset, const std::string& kind,
+                   int inputC, int inputH, int inputW);
+
+    // Number of original (non-augmented) samples in the active source.
+    ulong numOriginalSamples() const;
+
+    // Expected output vector of an original sample (no image decoding).
+    std::vector<float> originalOutput(ulong sourceIndex) const;
 
     // Load a batch of samples by their entry indices.
     std::vector<SampleT> loadBatch(const std::vector<ulong>& entryIndices,
                                    const Loader::AugmentationTransforms& transforms,
                                    float augmentationProbability) const;
 
-    // Retrieve a single sample by entry index, optionally applying augmentation.
-    SampleT loadSample(ulong entryIndex, std::mt19937& rng,
-                       const Loader::AugmentationTransforms& transforms,
-                       float augmentationProbability) const;
+    // Read position of the streaming provider within the current epoch (sharded source).
+    struct StreamState {
+      std::mt19937 rng{std::random_device{}()};
+      std::vector<ulong> augmentedEntries;  // Indices of augmented entries, sorted by sourceIndex
+      std::vector<ulong> order;             // This epoch's entry indices in shard-stream order
+      ulong cursor = 0;                     // Next position in order to load
+      std::vector<SampleT> buffer;          // Loaded samples waiting to be drawn
+    };
+
+    ProviderT makeStreamingProvider(const ShardedDataset& shardedDataset,
+                                    const Loader::AugmentationTransforms& transforms,
+                                    float augmentationProbability) const;
+
+    // Shuffle the shard order and lay out the epoch's entries shard by shard.
+    void startStreamEpoch(const ShardedDataset& shardedDataset, StreamState& state) const;
+
+    // Top the shuffle buffer up from the stream, then draw up to `count` samples from it at random.
+    std::vector<SampleT> nextStreamedBatch(StreamState& state, ulong count,
+                                           const Loader::AugmentationTransforms& transforms,
+                                           float augmentationProbability) const;
+
+    // Load a single sample by entry index into its batch slot, optionally applying augmentation.
+    // Images are decoded straight into the slot's tensors.
+    void loadSample(ulong entryIndex, SampleT& sample, std::mt19937& rng,
+                    const Loader::AugmentationTransforms& transforms,
+                    float augmentationProbability) const;
 };
 
 } // namespace NN_CLI
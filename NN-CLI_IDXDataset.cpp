@@ -0,0 +1,108 @@
+#include "NN-CLI_IDXDataset.hpp"
+#include "NN-CLI_PackedDataset.hpp"
+
+#include <QFile>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+namespace NN_CLI {
+
+//===================================================================================================================//
+
+static uint32_t readBigEndianUInt32(const unsigned char* bytes) {
+  return (static_cast<uint32_t>(bytes[0]) << 24) |
+         (static_cast<uint32_t>(bytes[1]) << 16) |
+         (static_cast<uint32_t>(bytes[2]) << 8) |
+         (static_cast<uint32_t>(bytes[3]));
+}
+
+//===================================================================================================================//
+
+// Map a whole file read-only. Returns nullptr for empty files; throws if the file cannot be opened.
+static const unsigned char* mapFile(QFile& file, const std::string& path, const std::string& description,
+                                    qint64& fileSize) {
+  if (!file.open(QIODevice::ReadOnly)) {
+    throw std::runtime_error("Failed to open IDX " + description + " file: " + path);
+  }
+
+  fileSize = file.size();
+  if (fileSize == 0) return nullptr;
+
+  const unsigned char* mapped = file.map(0, fileSize);
+  if (!mapped) {
+    throw std::runtime_error("Failed to memory-map IDX " + description + " file: " + path);
+  }
+  return mapped;
+}
+
+//===================================================================================================================//
+
+IDXDataset::IDXDataset() = default;
+
+IDXDataset::~IDXDataset() = default;
+
+//===================================================================================================================//
+
+void IDXDataset::open(const std::string& dataPath, const std::string& labelsPath) {
+  qint64 dataSize = 0, labelsSize = 0;
+
+  this->dataFile = std::make_unique<QFile>(QString::fromStdString(dataPath));
+  const unsigned char* data = mapFile(*this->dataFile, dataPath, "data", dataSize);
+
+  if (dataSize < 16 || readBigEndianUInt32(data) != 0x00000803) {
+    throw std::runtime_error("Invalid IDX3 data file magic number");
+  }
+
+  this->numItems = readBigEndianUInt32(data + 4);
+  this->numRows = readBigEndianUInt32(data + 8);
+  this->numCols = readBigEndianUInt32(data + 12);
+  this->itemSize = this->numRows * this->numCols;
+  this->images = data + 16;
+
+  if (16 + static_cast<uint64_t>(this->numItems) * this->itemSize > static_cast<uint64_t>(dataSize)) {
+    throw std::runtime_error("IDX data file is truncated: " + dataPath);
+  }
+
+  this->labelsFile = std::make_unique<QFile>(QString::fromStdString(labelsPath));
+  const unsigned char* labelData = mapFile(*this->labelsFile, labelsPath, "labels", labelsSize);
+
+  if (labelsSize < 8 || readBigEndianUInt32(labelData) != 0x00000801) {
+    throw std::runtime_error("Invalid IDX1 labels file magic number");
+  }
+
+  ulong numLabels = readBigEndianUInt32(labelData + 4);
+  this->labels = labelData + 8;
+
+  if (8 + static_cast<uint64_t>(numLabels) > static_cast<uint64_t>(labelsSize)) {
+    throw std::runtime_error("IDX labels file is truncated: " + labelsPath);
+  }
+
+  if (numLabels != this->numItems) {
+    throw std::runtime_error("IDX data and labels count mismatch");
+  }
+
+  // Determine the number of unique labels for one-hot encoding
+  unsigned char maxLabel = 0;
+  if (this->numItems > 0) maxLabel = *std::max_element(this->labels, this->labels + this->numItems);
+  this->numClasses = static_cast<ulong>(maxLabel) + 1;
+}
+
+//===================================================================================================================//
+
+void IDXDataset::readInput(ulong index, float* dst) const {
+  // Same uint8 -> [0, 1] conversion as packed datasets (a tight loop the compiler vectorises)
+  PackedDataset::decode(this->item(index), PackedElementType::UINT8, this->itemSize, dst);
+}
+
+//===================================================================================================================//
+
+void IDXDataset::readOutput(ulong index, float* dst) const {
+  std::fill(dst, dst + this->numClasses, 0.0f);
+  dst[this->labels[index]] = 1.0f;
+}
+
+//===================================================================================================================//
+
+} // namespace NN_CLI
@@ -0,0 +1,60 @@
+#ifndef NN_CLI_IDXDATASET_HPP
+#define NN_CLI_IDXDATASET_HPP
+
+#include "NN-CLI_MappedDataset.hpp"
+
+#include <memory>
+#include <string>
+
+class QFile;
+
+//===================================================================================================================//
+
+namespace NN_CLI {
+
+/**
+ * IDXDataset: memory-mapped IDX3 images + IDX1 labels (MNIST layout).
+ *
+ * Both files are mapped whole and left in their uint8 encoding — the images are one
+ * contiguous block of numSamples() * inputSize() bytes. readInput() normalises a single
+ * item to [0, 1] and readOutput() expands its label to a one-hot vector of numClasses().
+ */
+class IDXDataset : public MappedDataset {
+  public:
+    IDXDataset();
+    ~IDXDataset() override;
+
+    // Map and validate an IDX data/labels pair. Throws on I/O errors or malformed headers.
+    void open(const std::string& dataPath, const std::string& labelsPath);
+
+    ulong numSamples() const override { return this->numItems; }
+    ulong inputSize() const override { return this->itemSize; }
+    ulong outputSize() const override { return this->numClasses; }
+
+    ulong rows() const { return this->numRows; }
+    ulong cols() const { return this->numCols; }
+
+    // Raw access to the mapped bytes of one item / its label.
+    const unsigned char* item(ulong index) const { return this->images + index * this->itemSize; }
+    unsigned char label(ulong index) const { return this->labels[index]; }
+
+    void readInput(ulong index, float* dst) const override;
+    void readOutput(ulong index, float* dst) const override;
+
+  private:
+    std::unique_ptr<QFile> dataFile;
+    std::unique_ptr<QFile> labelsFile;
+    const unsigned char* images = nullptr;
+    const unsigned char* labels = nullptr;
+    ulong numItems = 0;
+    ulong numRows = 0;
+    ulong numCols = 0;
+    ulong itemSize = 0;
+    ulong numClasses = 0;
+};
+
+} // namespace NN_CLI
+
+//===================================================================================================================//
+
+#endif // NN_CLI_IDXDATASET_HPP
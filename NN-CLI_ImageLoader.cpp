@@ -1,4 +1,5 @@
 #include "NN-CLI_ImageLoader.hpp"
+#include "NN-CLI_PixelConvert.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -10,34 +11,374 @@
 #include <stb_image_resize2.h>
 
 #include <QDir>
+#include <QFile>
 #include <QFileInfo>
+#include <QSaveFile>
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <numeric>
 #include <stdexcept>
 
+#ifdef NN_CLI_HAVE_LIBJPEG
+#include <csetjmp>
+#include <jpeglib.h>
+#endif
+
 namespace NN_CLI {
 
+//===================================================================================================================//
+//-- Per-thread scratch buffers --//
+//===================================================================================================================//
+
+// Working buffers of the load path. Each thread keeps its own (DataLoader's ioPool workers live as long as
+// the loader), and they only grow, so once they fit the largest image loading a sample allocates nothing
+// here; only the sample's own tensor and the decoder's internal buffers remain.
+struct LoadScratch {
+  std::vector<char> fileBytes;          // Encoded file (libjpeg) or cache entry header
+  std::vector<unsigned char> decoded;   // Full-size (or DCT-scaled) decode, before resizing (libjpeg)
+  std::vector<unsigned char> pixels;    // HWC pixels at the target size
+  std::vector<float> transformed;       // Destination of rotation and translation, swapped with the input
+};
+
+static LoadScratch& loadScratch() {
+  thread_local LoadScratch scratch;
+  return scratch;
+}
+
+//===================================================================================================================//
+//-- Decoded image cache --//
+//===================================================================================================================//
+
+static const char cacheMagic[8] = {'N', 'N', 'C', 'L', 'I', 'I', 'C', '\0'};
+
+static std::string& cacheDirectory() {
+  static std::string directory;
+  return directory;
+}
+
+//===================================================================================================================//
+
+void ImageLoader::setCacheDirectory(const std::string& dirPath) {
+  if (!dirPath.empty() && !QDir().mkpath(QString::fromStdString(dirPath))) {
+    throw std::runtime_error("Failed to create image cache directory: " + dirPath);
+  }
+  cacheDirectory() = dirPath;
+}
+
+//===================================================================================================================//
+
+const std::string& ImageLoader::getCacheDirectory() {
+  return cacheDirectory();
+}
+
+//===================================================================================================================//
+
+// Identity of a decoded tensor: the source file (absolute path, mtime, size), the target shape and, when it
+// is not stb, the decoder (scaled decodes differ slightly from full-size ones).
+static std::string cacheKey(const std::string& imagePath, int c, int h, int w) {
+  QFileInfo info(QString::fromStdString(imagePath));
+  std::string key = info.absoluteFilePath().toStdString() + "|" +
+                    std::to_string(info.lastModified().toMSecsSinceEpoch()) + "|" + std::to_string(info.size()) +
+                    "|" + std::to_string(c) + "x" + std::to_string(h) + "x" + std::to_string(w);
+
+  ImageLoader::DecoderBackend backend = ImageLoader::getDecoderBackend();
+  if (backend != ImageLoader::DecoderBackend::STB) key += "|" + ImageLoader::decoderBackendName(backend);
+  return key;
+}
+
+//===================================================================================================================//
+
+static std::string cacheFilePath(const std::string& key) {
+  // FNV-1a is stable across runs and platforms; the full key is stored in the entry to rule out collisions
+  uint64_t hash = 14695981039346656037ULL;
+  for (char ch : key) {
+    hash ^= static_cast<unsigned char>(ch);
+    hash *= 1099511628211ULL;
+  }
+
+  char name[32];
+  std::snprintf(name, sizeof(name), "%016llx.nnic", static_cast<unsigned long long>(hash));
+  return QDir(QString::fromStdString(cacheDirectory())).filePath(QString(name)).toStdString();
+}
+
+//===================================================================================================================//
+
+// Entry layout: magic, uint32 key length, key bytes, then the HWC uint8 pixels.
+static bool readCachedPixels(const std::string& cachePath, const std::string& key, size_t size,
+                             std::vector<unsigned char>& pixels) {
+  QFile file(QString::fromStdString(cachePath));
+  if (!file.open(QIODevice::ReadOnly)) return false;
+
+  size_t headerSize = sizeof(cacheMagic) + sizeof(uint32_t) + key.size();
+  if (static_cast<size_t>(file.size()) != headerSize + size) return false;
+
+  std::vector<char>& header = loadScratch().fileBytes;
+  header.resize(headerSize);
+  if (file.read(header.data(), static_cast<qint64>(headerSize)) != static_cast<qint64>(headerSize)) return false;
+
+  const char* data = header.data();
+  uint32_t keyLength;
+  std::memcpy(&keyLength, data + sizeof(cacheMagic), sizeof(keyLength));
+
+  if (std::memcmp(data, cacheMagic, sizeof(cacheMagic)) != 0 || keyLength != key.size() ||
+      std::memcmp(data + sizeof(cacheMagic) + sizeof(uint32_t), key.data(), key.size()) != 0) {
+    return false;
+  }
+
+  pixels.resize(size);
+  return file.read(reinterpret_cast<char*>(pixels.data()), static_cast<qint64>(size)) == static_cast<qint64>(size);
+}
+
+//===================================================================================================================//
+
+// Best effort: a cache that cannot be written only costs a re-decode next time.
+static void writeCachedPixels(const std::string& cachePath, const std::string& key,
+                              const std::vector<unsigned char>& pixels) {
+  // QSaveFile writes to a temporary file and renames on commit, so readers never see partial entries
+  QSaveFile file(QString::fromStdString(cachePath));
+  if (!file.open(QIODevice::WriteOnly)) return;
+
+  uint32_t keyLength = static_cast<uint32_t>(key.size());
+  file.write(cacheMagic, sizeof(cacheMagic));
+  file.write(reinterpret_cast<const char*>(&keyLength), sizeof(keyLength));
+  file.write(key.data(), static_cast<qint64>(key.size()));
+  file.write(reinterpret_cast<const char*>(pixels.data()), static_cast<qint64>(pixels.size()));
+  file.commit();
+}
+
 //===================================================================================================================//
 
 std::vector<float> ImageLoader::loadImage(const std::string& imagePath,
                                            int targetC, int targetH, int targetW) {
+  std::vector<float> result(static_cast<size_t>(targetC) * targetH * targetW);
+  loadImage(imagePath, targetC, targetH, targetW, result.data());
+  return result;
+}
+
+//===================================================================================================================//
+
+void ImageLoader::loadImage(const std::string& imagePath, int targetC, int targetH, int targetW, float* out) {
+  std::vector<unsigned char>& pixels = loadScratch().pixels;
+  loadPixelsInto(imagePath, targetC, targetH, targetW, pixels);
+  PixelConvert::toPlanar(pixels.data(), out, targetC, static_cast<size_t>(targetH) * targetW);
+}
+
+//===================================================================================================================//
+
+std::vector<unsigned char> ImageLoader::loadPixels(const std::string& imagePath,
+                                                    int targetC, int targetH, int targetW) {
+  std::vector<unsigned char> pixels;
+  loadPixelsInto(imagePath, targetC, targetH, targetW, pixels);
+  return pixels;
+}
+
+//===================================================================================================================//
+
+void ImageLoader::loadPixelsInto(const std::string& imagePath, int targetC, int targetH, int targetW,
+                                 std::vector<unsigned char>& pixels) {
+  if (cacheDirectory().empty()) {
+    decodePixels(imagePath, targetC, targetH, targetW, pixels);
+    return;
+  }
+
+  std::string key = cacheKey(imagePath, targetC, targetH, targetW);
+  std::string cachePath = cacheFilePath(key);
+  size_t size = static_cast<size_t>(targetC) * targetH * targetW;
+
+  if (readCachedPixels(cachePath, key, size, pixels)) return;
+
+  decodePixels(imagePath, targetC, targetH, targetW, pixels);
+  writeCachedPixels(cachePath, key, pixels);
+}
+
+//===================================================================================================================//
+//-- Decoder backends --//
+//===================================================================================================================//
+
+static ImageLoader::DecoderBackend& decoderBackend() {
+  static ImageLoader::DecoderBackend backend = ImageLoader::DecoderBackend::STB;
+  return backend;
+}
+
+//===================================================================================================================//
+
+void ImageLoader::setDecoderBackend(DecoderBackend backend) {
+  if (!isDecoderBackendAvailable(backend)) {
+    throw std::runtime_error("Image decoder '" + decoderBackendName(backend) +
+                             "' is not available: NN-CLI was built without libjpeg");
+  }
+  decoderBackend() = backend;
+}
+
+//===================================================================================================================//
+
+ImageLoader::DecoderBackend ImageLoader::getDecoderBackend() {
+  return decoderBackend();
+}
+
+//===================================================================================================================//
+
+bool ImageLoader::isDecoderBackendAvailable(DecoderBackend backend) {
+  if (backend == DecoderBackend::STB) return true;
+#ifdef NN_CLI_HAVE_LIBJPEG
+  return true;
+#else
+  return false;
+#endif
+}
+
+//===================================================================================================================//
+
+ImageLoader::DecoderBackend ImageLoader::parseDecoderBackend(const std::string& name) {
+  if (name == "stb") return DecoderBackend::STB;
+  if (name == "libjpeg") return DecoderBackend::LIBJPEG;
+  throw std::runtime_error("Unknown image decoder '" + name + "' (expected stb or libjpeg)");
+}
+
+//===================================================================================================================//
+
+std::string ImageLoader::decoderBackendName(DecoderBackend backend) {
+  return (backend == DecoderBackend::LIBJPEG) ? "libjpeg" : "stb";
+}
+
+//===================================================================================================================//
+
+#ifdef NN_CLI_HAVE_LIBJPEG
+
+// libjpeg reports fatal errors through error_exit, which must not return: jump back to the decode call.
+struct JpegErrorManager {
+  jpeg_error_mgr base;
+  std::jmp_buf jump;
+};
+
+static void jpegErrorExit(j_common_ptr cinfo) {
+  std::longjmp(reinterpret_cast<JpegErrorManager*>(cinfo->err)->jump, 1);
+}
+
+//===================================================================================================================//
+
+static void jpegOutputMessage(j_common_ptr) {
+  // Warnings about corrupt data are not fatal; stay quiet like stb
+}
+
+//===================================================================================================================//
+
+// Output colour space giving c interleaved channels, or JCS_UNKNOWN if libjpeg cannot produce them.
+static J_COLOR_SPACE jpegColorSpace(int c) {
+  if (c == 1) return JCS_GRAYSCALE;
+  if (c == 3) return JCS_RGB;
+#ifdef JCS_ALPHA_EXTENSIONS
+  if (c == 4) return JCS_EXT_RGBA;  // libjpeg-turbo fills alpha with 255, as stb does
+#endif
+  return JCS_UNKNOWN;
+}
+
+//===================================================================================================================//
+
+// Decode a JPEG as interleaved pixels with c channels. When the target is at most half the source in both
+// dimensions, the IDCT produces the image at 1/2, 1/4 or 1/8 scale directly, never below the target size.
+// Returns false if libjpeg cannot decode it (e.g. CMYK), so the caller can fall back to stb.
+static bool decodeJpeg(const std::vector<char>& bytes, int c, int targetH, int targetW,
+                       std::vector<unsigned char>& pixels, int& width, int& height) {
+  if (jpegColorSpace(c) == JCS_UNKNOWN) return false;
+
+  jpeg_decompress_struct cinfo;
+  JpegErrorManager error;
+  cinfo.err = jpeg_std_error(&error.base);
+  error.base.error_exit = jpegErrorExit;
+  error.base.output_message = jpegOutputMessage;
+
+  if (setjmp(error.jump)) {
+    jpeg_destroy_decompress(&cinfo);
+    return false;
+  }
+
+  jpeg_create_decompress(&cinfo);
+  jpeg_mem_src(&cinfo, reinterpret_cast<unsigned char*>(const_cast<char*>(bytes.data())),
+               static_cast<unsigned long>(bytes.size()));
+  jpeg_read_header(&cinfo, TRUE);
+
+  cinfo.out_color_space = jpegColorSpace(c);
+  cinfo.scale_num = 1;
+  cinfo.scale_denom = 1;
+  while (cinfo.scale_denom < 8 && cinfo.image_width / (cinfo.scale_denom * 2) >= static_cast<unsigned>(targetW) &&
+         cinfo.image_height / (cinfo.scale_denom * 2) >= static_cast<unsigned>(targetH)) {
+    cinfo.scale_denom *= 2;
+  }
+
+  jpeg_start_decompress(&cinfo);
+  width = static_cast<int>(cinfo.output_width);
+  height = static_cast<int>(cinfo.output_height);
+  size_t stride = static_cast<size_t>(width) * c;
+  pixels.resize(stride * height);
+
+  while (cinfo.output_scanline < cinfo.output_height) {
+    JSAMPROW row = pixels.data() + cinfo.output_scanline * stride;
+    jpeg_read_scanlines(&cinfo, &row, 1);
+  }
+
+  jpeg_finish_decompress(&cinfo);
+  jpeg_destroy_decompress(&cinfo);
+  return true;
+}
+
+#endif // NN_CLI_HAVE_LIBJPEG
+
+//===================================================================================================================//
+
+// Decode with libjpeg when that backend is selected and the file is a JPEG it can read. Returns false to fall
+// back to stb.
+#ifdef NN_CLI_HAVE_LIBJPEG
+static bool decodeWithLibjpeg(const std::string& imagePath, int c, int targetH, int targetW,
+                              std::vector<unsigned char>& pixels, int& width, int& height) {
+  if (decoderBackend() != ImageLoader::DecoderBackend::LIBJPEG) return false;
+
+  QFile file(QString::fromStdString(imagePath));
+  if (!file.open(QIODevice::ReadOnly)) return false;
+
+  std::vector<char>& bytes = loadScratch().fileBytes;
+  bytes.resize(static_cast<size_t>(file.size()));
+  if (file.read(bytes.data(), file.size()) != file.size()) return false;
+
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(bytes.data());
+  if (bytes.size() < 3 || data[0] != 0xFF || data[1] != 0xD8 || data[2] != 0xFF) return false;
+
+  return decodeJpeg(bytes, c, targetH, targetW, pixels, width, height);
+}
+#else
+static bool decodeWithLibjpeg(const std::string&, int, int, int, std::vector<unsigned char>&, int&, int&) {
+  return false;
+}
+#endif
+
+//===================================================================================================================//
+
+void ImageLoader::decodePixels(const std::string& imagePath, int targetC, int targetH, int targetW,
+                               std::vector<unsigned char>& result) {
   int origW = 0, origH = 0, origC = 0;
-  unsigned char* pixels = stbi_load(imagePath.c_str(), &origW, &origH, &origC, targetC);
+  std::vector<unsigned char>& decoded = loadScratch().decoded;
+  unsigned char* stbPixels = nullptr;
+  const unsigned char* pixels = nullptr;
 
-  if (!pixels) {
-    throw std::runtime_error("Failed to load image: " + imagePath +
-                              " (" + stbi_failure_reason() + ")");
+  if (decodeWithLibjpeg(imagePath, targetC, targetH, targetW, decoded, origW, origH)) {
+    pixels = decoded.data();
+  } else {
+    stbPixels = stbi_load(imagePath.c_str(), &origW, &origH, &origC, targetC);
+    if (!stbPixels) {
+      throw std::runtime_error("Failed to load image: " + imagePath +
+                                " (" + stbi_failure_reason() + ")");
+    }
+    pixels = stbPixels;
   }
 
-  // Resize if the loaded image doesn't match target dimensions
-  std::vector<unsigned char> resizedBuf;
-  unsigned char* source = pixels;
+  result.resize(static_cast<size_t>(targetW) * targetH * targetC);
 
+  // Resize if the loaded image doesn't match target dimensions
   if (origW != targetW || origH != targetH) {
-    resizedBuf.resize(static_cast<size_t>(targetW) * targetH * targetC);
-
     stbir_pixel_layout layout;
     if (targetC == 1)      layout = STBIR_1CHANNEL;
     else if (targetC == 3) layout = STBIR_RGB;
@@ -45,27 +386,135 @@ std::vector<float> ImageLoader::loadImage(const std::string& imagePath,
     else                   layout = STBIR_1CHANNEL; // fallback
 
     stbir_resize_uint8_linear(pixels, origW, origH, 0,
-                               resizedBuf.data(), targetW, targetH, 0,
+                               result.data(), targetW, targetH, 0,
                                layout);
-    source = resizedBuf.data();
+  } else {
+    std::copy(pixels, pixels + result.size(), result.begin());
   }
 
+  stbi_image_free(stbPixels);
+}
+
+//===================================================================================================================//
+
+std::vector<float> ImageLoader::pixelsToNCHW(const unsigned char* pixels, int c, int h, int w) {
   // Convert to flat NCHW float vector, normalised to [0, 1]
-  std::vector<float> result(static_cast<size_t>(targetC) * targetH * targetW);
+  // stb_image stores as interleaved HWC; each channel becomes one plane of the NCHW result
+  std::vector<float> result(static_cast<size_t>(c) * h * w);
+  PixelConvert::toPlanar(pixels, result.data(), c, static_cast<size_t>(h) * w);
 
-  for (int c = 0; c < targetC; ++c) {
-    for (int h = 0; h < targetH; ++h) {
-      for (int w = 0; w < targetW; ++w) {
-        // stb_image stores as interleaved HWC: pixel[h * W * C + w * C + c]
-        float val = static_cast<float>(source[h * targetW * targetC + w * targetC + c]) / 255.0f;
-        // NCHW layout: data[c * H * W + h * W + w]
-        result[c * targetH * targetW + h * targetW + w] = val;
-      }
+  return result;
+}
+
+//===================================================================================================================//
+//-- PNG output --//
+//===================================================================================================================//
+
+void ImageLoader::setPngCompressionLevel(int level) {
+  if (level < 0 || level > 9) {
+    throw std::runtime_error("PNG compression level must be between 0 and 9, got " + std::to_string(level));
+  }
+  stbi_write_png_compression_level = level;
+}
+
+//===================================================================================================================//
+
+int ImageLoader::getPngCompressionLevel() {
+  return stbi_write_png_compression_level;
+}
+
+//===================================================================================================================//
+
+static uint32_t crc32(uint32_t crc, const unsigned char* data, size_t size) {
+  static const std::vector<uint32_t> table = []() {
+    std::vector<uint32_t> entries(256);
+    for (uint32_t n = 0; n < 256; n++) {
+      uint32_t c = n;
+      for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      entries[n] = c;
     }
+    return entries;
+  }();
+
+  crc = ~crc;
+  for (size_t i = 0; i < size; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  return ~crc;
+}
+
+//===================================================================================================================//
+
+static void appendBigEndian(std::string& out, uint32_t value) {
+  out += static_cast<char>(value >> 24);
+  out += static_cast<char>(value >> 16);
+  out += static_cast<char>(value >> 8);
+  out += static_cast<char>(value);
+}
+
+//===================================================================================================================//
+
+static void appendChunk(std::string& out, const char* type, const std::string& data) {
+  appendBigEndian(out, static_cast<uint32_t>(data.size()));
+  size_t start = out.size();
+  out.append(type, 4);
+  out += data;
+  appendBigEndian(out, crc32(0, reinterpret_cast<const unsigned char*>(out.data() + start), out.size() - start));
+}
+
+//===================================================================================================================//
+
+// PNG with every row unfiltered and stored in uncompressed deflate blocks: several times larger than a
+// compressed PNG, but written at memory speed. Any PNG reader decodes it.
+static bool writeStoredPng(const std::string& imagePath, const unsigned char* pixels, int c, int h, int w) {
+  static const char colorTypes[5] = {0, 0, 4, 2, 6}; // By channel count: gray, gray+alpha, RGB, RGBA
+  if (c < 1 || c > 4) return false;
+
+  // Filter byte 0 (none) before each row
+  size_t rowSize = static_cast<size_t>(w) * c;
+  std::string raw;
+  raw.reserve((rowSize + 1) * h);
+  for (int y = 0; y < h; y++) {
+    raw += '\0';
+    raw.append(reinterpret_cast<const char*>(pixels) + y * rowSize, rowSize);
   }
 
-  stbi_image_free(pixels);
-  return result;
+  // zlib stream of stored blocks (at most 65535 bytes each), then the Adler-32 of the raw data
+  std::string zlib = "\x78\x01";
+  zlib.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+  uint32_t a = 1, b = 0;
+  for (size_t offset = 0;; offset += 65535) {
+    size_t length = std::min<size_t>(65535, raw.size() - offset);
+    bool last = (offset + length >= raw.size());
+    zlib += static_cast<char>(last ? 1 : 0);
+    zlib += static_cast<char>(length & 0xFF);
+    zlib += static_cast<char>(length >> 8);
+    zlib += static_cast<char>(~length & 0xFF);
+    zlib += static_cast<char>((~length >> 8) & 0xFF);
+    zlib.append(raw, offset, length);
+    for (size_t i = offset; i < offset + length; i++) {
+      a = (a + static_cast<unsigned char>(raw[i])) % 65521;
+      b = (b + a) % 65521;
+    }
+    if (last) break;
+  }
+  appendBigEndian(zlib, (b << 16) | a);
+
+  std::string header;
+  appendBigEndian(header, static_cast<uint32_t>(w));
+  appendBigEndian(header, static_cast<uint32_t>(h));
+  header += '\x08';                // Bit depth
+  header += colorTypes[c];
+  header.append(3, '\0');          // Deflate, adaptive filtering, no interlace
+
+  std::string png = "\x89PNG\r\n\x1a\n";
+  appendChunk(png, "IHDR", header);
+  appendChunk(png, "IDAT", zlib);
+  appendChunk(png, "IEND", std::string());
+
+  QFile file(QString::fromStdString(imagePath));
+  if (!file.open(QIODevice::WriteOnly)) return false;
+  bool written = file.write(png.data(), static_cast<qint64>(png.size())) == static_cast<qint64>(png.size());
+  file.close();
+  return written;
 }
 
 //===================================================================================================================//
@@ -75,16 +524,7 @@ void ImageLoader::saveImage(const std::string& imagePath,
                              int c, int h, int w) {
   // Convert from NCHW float [0,1] to interleaved HWC uint8 [0,255]
   std::vector<unsigned char> pixels(static_cast<size_t>(c) * h * w);
-
-  for (int ch = 0; ch < c; ++ch) {
-    for (int y = 0; y < h; ++y) {
-      for (int x = 0; x < w; ++x) {
-        float val = data[ch * h * w + y * w + x];
-        val = std::max(0.0f, std::min(1.0f, val));
-        pixels[y * w * c + x * c + ch] = static_cast<unsigned char>(val * 255.0f + 0.5f);
-      }
-    }
-  }
+  PixelConvert::toInterleaved(data.data(), pixels.data(), c, static_cast<size_t>(h) * w);
 
   // Determine format from extension
   std::string ext;
@@ -99,6 +539,8 @@ void ImageLoader::saveImage(const std::string& imagePath,
     result = stbi_write_jpg(imagePath.c_str(), w, h, c, pixels.data(), 90);
   } else if (ext == ".bmp") {
     result = stbi_write_bmp(imagePath.c_str(), w, h, c, pixels.data());
+  } else if (stbi_write_png_compression_level == 0) {
+    result = writeStoredPng(imagePath, pixels.data(), c, h, w);
   } else {
     // Default to PNG
     result = stbi_write_png(imagePath.c_str(), w, h, c, pixels.data(), w * c);
@@ -147,7 +589,8 @@ void ImageLoader::randomRotation(std::vector<float>& data, int c, int h, int w,
   float cx = static_cast<float>(w) / 2.0f;
   float cy = static_cast<float>(h) / 2.0f;
 
-  std::vector<float> result(data.size(), 0.0f);
+  std::vector<float>& result = loadScratch().transformed;
+  result.assign(data.size(), 0.0f);
 
   for (int ch = 0; ch < c; ch++) {
     int chOffset = ch * h * w;
@@ -178,7 +621,7 @@ void ImageLoader::randomRotation(std::vector<float>& data, int c, int h, int w,
       }
     }
   }
-  data = std::move(result);
+  data.swap(result);
 }
 
 //===================================================================================================================//
@@ -225,7 +668,8 @@ void ImageLoader::randomTranslation(std::vector<float>& data, int c, int h, int
   int dx = distX(rng);
   int dy = distY(rng);
 
-  std::vector<float> result(data.size(), 0.0f);
+  std::vector<float>& result = loadScratch().transformed;
+  result.assign(data.size(), 0.0f);
   for (int ch = 0; ch < c; ch++) {
     int chOffset = ch * h * w;
     for (int y = 0; y < h; y++) {
@@ -238,7 +682,7 @@ void ImageLoader::randomTranslation(std::vector<float>& data, int c, int h, int
       }
     }
   }
-  data = std::move(result);
+  data.swap(result);
 }
 
 //===================================================================================================================//
@@ -23,18 +23,53 @@ namespace NN_CLI {
  */
 class ImageLoader {
 public:
+  // Decoder used for image files. STB decodes every format at full resolution (default). LIBJPEG decodes
+  // JPEG with libjpeg(-turbo), straight at 1/2, 1/4 or 1/8 scale when the target is that much smaller;
+  // other formats, and JPEGs libjpeg rejects, still go through stb.
+  enum class DecoderBackend { STB, LIBJPEG };
+
   // Load an image and convert to a flat NCHW float vector normalised to [0,1].
   // targetC: desired channels (1=grayscale, 3=RGB)
   // targetH, targetW: desired spatial dimensions (resized if necessary)
   static std::vector<float> loadImage(const std::string& imagePath,
                                        int targetC, int targetH, int targetW);
 
+  // The same, written to out (targetC * targetH * targetW floats). Decoding and resizing use per-thread
+  // scratch buffers, so loading into an existing tensor allocates nothing once they have grown.
+  static void loadImage(const std::string& imagePath, int targetC, int targetH, int targetW, float* out);
+
+  // Load an image as interleaved HWC uint8 pixels at the target size.
+  // Served from the decoded-image cache when one is set (see setCacheDirectory).
+  static std::vector<unsigned char> loadPixels(const std::string& imagePath,
+                                                int targetC, int targetH, int targetW);
+
+  // Convert interleaved HWC uint8 pixels to a flat NCHW float vector normalised to [0,1].
+  static std::vector<float> pixelsToNCHW(const unsigned char* pixels, int c, int h, int w);
+
+  // Opt-in persistent cache of decoded, resized images, keyed by (path, mtime, size, C, H, W).
+  // An empty path disables it (default). Set once at startup, before any image is loaded.
+  static void setCacheDirectory(const std::string& dirPath);
+  static const std::string& getCacheDirectory();
+
+  // Select the decoder backend. Process-wide; set once at startup, before any image is loaded.
+  // Throws if LIBJPEG is requested but libjpeg was not found at build time.
+  static void setDecoderBackend(DecoderBackend backend);
+  static DecoderBackend getDecoderBackend();
+  static bool isDecoderBackendAvailable(DecoderBackend backend);
+  static DecoderBackend parseDecoderBackend(const std::string& name);
+  static std::string decoderBackendName(DecoderBackend backend);
+
   // Save a flat NCHW float vector ([0,1]) as an image file.
   // Format determined by extension: .png, .jpg/.jpeg, .bmp (default: PNG).
   static void saveImage(const std::string& imagePath,
                         const std::vector<float>& data,
                         int c, int h, int w);
 
+  // PNG compression used by saveImage: 0 stores the pixels uncompressed (fastest), 1-9 are zlib
+  // levels (default 8). Process-wide; set once at startup, before any image is saved.
+  static void setPngCompressionLevel(int level);
+  static int getPngCompressionLevel();
+
   // Resolve imagePath relative to baseDirPath (directory).
   // Returns imagePath unchanged if it is already absolute.
   static std::string resolvePath(const std::string& imagePath,
@@ -60,6 +95,15 @@ public:
   static void randomTranslation(std::vector<float>& data, int c, int h, int w,
                                  float maxFraction, std::mt19937& rng);
   static void addGaussianNoise(std::vector<float>& data, float stddev, std::mt19937& rng);
+
+private:
+  // loadPixels into an existing buffer (resized to fit, its capacity reused).
+  static void loadPixelsInto(const std::string& imagePath, int targetC, int targetH, int targetW,
+                             std::vector<unsigned char>& pixels);
+
+  // Decode and resize with the selected backend (no cache) into result.
+  static void decodePixels(const std::string& imagePath, int targetC, int targetH, int targetW,
+                           std::vector<unsigned char>& result);
 };
 
 } // namespace NN_CLI
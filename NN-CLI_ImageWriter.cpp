@@ -0,0 +1,74 @@
+#include "NN-CLI_ImageWriter.hpp"
+#include "NN-CLI_ImageLoader.hpp"
+
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace NN_CLI {
+
+//===================================================================================================================//
+
+ImageWriter::ImageWriter(int c, int h, int w, ulong numThreads, ulong maxPending)
+    : c(c), h(h), w(w), pool(std::make_unique<QThreadPool>()) {
+  if (numThreads == 0) numThreads = static_cast<ulong>(std::max(1, QThread::idealThreadCount()));
+  this->pool->setMaxThreadCount(static_cast<int>(numThreads));
+  this->maxPending = (maxPending == 0) ? numThreads * 4 : maxPending;
+}
+
+//===================================================================================================================//
+
+ImageWriter::~ImageWriter() {
+  // Workers still touch the mutex after their last notification; wait for them to return
+  this->pool->waitForDone();
+}
+
+//===================================================================================================================//
+
+void ImageWriter::submit(const std::string& imagePath, std::vector<float> data) {
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->changed.wait(lock, [this]() { return this->numPending < this->maxPending; });
+    this->numPending++;
+  }
+
+  QtConcurrent::run(this->pool.get(), [this, imagePath, data = std::move(data)]() {
+    std::string failure;
+    try {
+      ImageLoader::saveImage(imagePath, data, this->c, this->h, this->w);
+    } catch (const std::exception& e) {
+      failure = e.what();
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (failure.empty()) {
+      this->numWritten++;
+    } else if (this->error.empty()) {
+      this->error = failure;
+    }
+    this->numPending--;
+    this->changed.notify_all();
+  });
+}
+
+//===================================================================================================================//
+
+void ImageWriter::wait() {
+  std::unique_lock<std::mutex> lock(this->mutex);
+  this->changed.wait(lock, [this]() { return this->numPending == 0; });
+  if (!this->error.empty()) throw std::runtime_error(this->error);
+}
+
+//===================================================================================================================//
+
+ulong ImageWriter::getNumWritten() const {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->numWritten;
+}
+
+//===================================================================================================================//
+
+} // namespace NN_CLI
@@ -0,0 +1,58 @@
+#ifndef NN_CLI_IMAGEWRITER_HPP
+#define NN_CLI_IMAGEWRITER_HPP
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+class QThreadPool;
+
+//===================================================================================================================//
+
+namespace NN_CLI {
+
+/**
+ * ImageWriter: encodes and saves predicted images on a pool of worker threads.
+ *
+ * Predict submits each output as soon as it is available, so PNG encoding overlaps with the
+ * remaining inference instead of running serially after it. At most maxPending images wait to
+ * be encoded; submit() blocks beyond that, so a slow disk throttles predict rather than letting
+ * finished outputs pile up in memory.
+ */
+class ImageWriter {
+  public:
+    // Images are c x h x w. numThreads 0 = one per core; maxPending 0 = four per thread.
+    ImageWriter(int c, int h, int w, ulong numThreads = 0, ulong maxPending = 0);
+    ~ImageWriter();
+
+    // Queue an NCHW [0, 1] output for saving to imagePath (format from its extension). Thread-safe.
+    void submit(const std::string& imagePath, std::vector<float> data);
+
+    // Block until every submitted image is saved. Throws the first failure, if any.
+    void wait();
+
+    ulong getNumWritten() const;
+
+  private:
+    int c;
+    int h;
+    int w;
+    ulong maxPending;
+    std::unique_ptr<QThreadPool> pool;
+
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    ulong numPending = 0;
+    ulong numWritten = 0;
+    std::string error;  // First failure, reported by wait()
+};
+
+} // namespace NN_CLI
+
+//===================================================================================================================//
+
+#endif // NN_CLI_IMAGEWRITER_HPP
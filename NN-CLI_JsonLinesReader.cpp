@@ -0,0 +1,90 @@
+#include "NN-CLI_JsonLinesReader.hpp"
+#include "NN-CLI_Parallel.hpp"
+
+#include <QFile>
+#include <QFileInfo>
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <stdexcept>
+#include <utility>
+
+namespace NN_CLI {
+
+//===================================================================================================================//
+
+JsonLinesReader::JsonLinesReader(const std::string& filePath)
+    : sourceName(filePath == "-" ? "standard input" : filePath), fromStdin(filePath == "-") {
+  bool opened = false;
+  if (filePath == "-") {
+    // By descriptor rather than FILE*, so lines already read ahead sit in QFile's buffer, where stdinReady() sees them
+    this->file = std::make_unique<QFile>();
+    opened = this->file->open(STDIN_FILENO, QIODevice::ReadOnly);
+  } else {
+    this->file = std::make_unique<QFile>(QString::fromStdString(filePath));
+    opened = this->file->open(QIODevice::ReadOnly);
+  }
+
+  if (!opened) {
+    throw std::runtime_error("Failed to open input file: " + filePath);
+  }
+}
+
+JsonLinesReader::~JsonLinesReader() = default;
+
+//===================================================================================================================//
+
+bool JsonLinesReader::isJsonLinesPath(const std::string& filePath) {
+  if (filePath == "-") return true;
+
+  QString suffix = QFileInfo(QString::fromStdString(filePath)).suffix().toLower();
+  return suffix == "jsonl" || suffix == "ndjson";
+}
+
+//===================================================================================================================//
+
+std::vector<StreamedValue> JsonLinesReader::readChunk(ulong maxValues) {
+  // Pull raw lines first (I/O is sequential), remembering each one's line number for errors
+  std::vector<std::pair<QByteArray, ulong>> lines;
+  lines.reserve(maxValues);
+
+  while (lines.size() < maxValues) {
+    // Hand over what has arrived rather than wait for the rest of the chunk
+    if (this->fromStdin && !lines.empty() && !this->stdinReady()) break;
+
+    QByteArray line = this->file->readLine();
+    if (line.isEmpty()) break; // End of input: every other line holds at least its '\n'
+    this->lineNumber++;
+
+    const char* first = line.constData();
+    const char* last = first + line.size();
+    while (first < last && (*first == ' ' || *first == '\t' || *first == '\r' || *first == '\n')) first++;
+    if (first == last) continue;
+
+    lines.emplace_back(std::move(line), this->lineNumber);
+  }
+
+  std::vector<StreamedValue> values(lines.size());
+  Parallel::forEach(lines.size(), [&](ulong i) {
+    const QByteArray& line = lines[i].first;
+    values[i] = SamplesReader::parseValue(line.constData(), line.constData() + line.size(),
+                                          this->sourceName + " line " + std::to_string(lines[i].second));
+  });
+
+  return values;
+}
+
+//===================================================================================================================//
+
+bool JsonLinesReader::stdinReady() const {
+  // Input QFile has already read ahead can be returned without touching the descriptor
+  if (this->file->bytesAvailable() > 0) return true;
+
+  pollfd descriptor{STDIN_FILENO, POLLIN, 0};
+  return ::poll(&descriptor, 1, 0) > 0;
+}
+
+//===================================================================================================================//
+
+} // namespace NN_CLI
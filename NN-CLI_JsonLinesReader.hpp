@@ -0,0 +1,59 @@
+#ifndef NN_CLI_JSONLINESREADER_HPP
+#define NN_CLI_JSONLINESREADER_HPP
+
+#include "NN-CLI_SamplesReader.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+class QFile;
+
+//===================================================================================================================//
+
+namespace NN_CLI {
+
+/**
+ * JsonLinesReader: incremental reader for JSON Lines (NDJSON) predict inputs.
+ *
+ * Every non-blank line holds one input, written like an element of an "inputs" array:
+ * a flat numeric array or an image path string. Lines are pulled from the file (or from
+ * standard input for "-") a chunk at a time, so memory is bounded by the chunk size no
+ * matter how long the stream is. The lines of a chunk are parsed concurrently.
+ *
+ * On standard input a chunk also ends as soon as no further line is waiting, so inputs typed
+ * or piped in one at a time are predicted as they arrive instead of once a chunk has filled.
+ */
+class JsonLinesReader {
+  public:
+    // "-" reads standard input.
+    explicit JsonLinesReader(const std::string& filePath);
+    ~JsonLinesReader();
+
+    // True for "-" and for *.jsonl / *.ndjson paths.
+    static bool isJsonLinesPath(const std::string& filePath);
+
+    // Read and parse up to maxValues more non-blank lines (fewer from standard input when the next line
+    // has not arrived yet). Returns an empty vector at end of input. Throws on malformed lines, naming the line number.
+    std::vector<StreamedValue> readChunk(ulong maxValues);
+
+    // Lines consumed so far, including blank ones.
+    ulong getLineNumber() const { return this->lineNumber; }
+
+  private:
+    std::string sourceName;
+    std::unique_ptr<QFile> file;
+    bool fromStdin = false;
+    ulong lineNumber = 0;
+
+    // True if reading the next line from standard input would not block.
+    bool stdinReady() const;
+};
+
+} // namespace NN_CLI
+
+//===================================================================================================================//
+
+#endif // NN_CLI_JSONLINESREADER_HPP
@@ -1,8 +1,12 @@
 #include "NN-CLI_Loader.hpp"
 #include "NN-CLI_ImageLoader.hpp"
+#include "NN-CLI_ModelFile.hpp"
+#include "NN-CLI_NpyDataset.hpp"
+#include "NN-CLI_PackedDataset.hpp"
+#include "NN-CLI_Parallel.hpp"
 #include "NN-CLI_ProgressBar.hpp"
+#include "NN-CLI_SamplesReader.hpp"
 
-#include <QFile>
 #include <QFileInfo>
 #include <json.hpp>
 
@@ -14,15 +18,8 @@ namespace NN_CLI {
 // Network type detection
 //===================================================================================================================//
 
-NetworkType Loader::detectNetworkType(const std::string& configFilePath) {
-    QFile file(QString::fromStdString(configFilePath));
-
-    if (!file.open(QIODevice::ReadOnly)) {
-        throw std::runtime_error("Failed to open config file: " + configFilePath);
-    }
-
-    QByteArray fileData = file.readAll();
-    nlohmann::json json = nlohmann::json::parse(fileData.toStdString());
+NetworkType Loader::detectNetworkType(const ModelFile& config) {
+    const auto& json = config.getDocument();
 
     // CNN configs have "inputShape" and/or "convolutionalLayersConfig"
     if (json.contains("inputShape") || json.contains("convolutionalLayersConfig")) {
@@ -36,17 +33,10 @@ NetworkType Loader::detectNetworkType(const std::string& configFilePath) {
 // I/O config loading
 //===================================================================================================================//
 
-IOConfig Loader::loadIOConfig(const std::string& configFilePath,
+IOConfig Loader::loadIOConfig(const ModelFile& config,
                                std::optional<std::string> inputTypeOverride,
                                std::optional<std::string> outputTypeOverride) {
-    QFile file(QString::fromStdString(configFilePath));
-
-    if (!file.open(QIODevice::ReadOnly)) {
-        throw std::runtime_error("Failed to open config file: " + configFilePath);
-    }
-
-    QByteArray fileData = file.readAll();
-    nlohmann::json json = nlohmann::json::parse(fileData.toStdString());
+    const auto& json = config.getDocument();
 
     IOConfig ioConfig;
 
@@ -89,17 +79,10 @@ IOConfig Loader::loadIOConfig(const std::string& configFilePath,
 // ANN config loading (unchanged logic, renamed)
 //===================================================================================================================//
 
-ANN::CoreConfig<float> Loader::loadANNConfig(const std::string& configFilePath,
+ANN::CoreConfig<float> Loader::loadANNConfig(const ModelFile& config,
                                                std::optional<ANN::ModeType> modeType,
                                                std::optional<ANN::DeviceType> deviceType) {
-    QFile file(QString::fromStdString(configFilePath));
-
-    if (!file.open(QIODevice::ReadOnly)) {
-        throw std::runtime_error("Failed to open config file: " + configFilePath);
-    }
-
-    QByteArray fileData = file.readAll();
-    nlohmann::json json = nlohmann::json::parse(fileData.toStdString());
+    const auto& json = config.getDocument();
 
     ANN::CoreConfig<float> coreConfig;
 
@@ -122,7 +105,7 @@ ANN::CoreConfig<float> Loader::loadANNConfig(const std::string& configFilePath,
     if (deviceType.has_value()) coreConfig.deviceType = deviceType.value();
 
     if (!json.contains("layersConfig")) {
-        throw std::runtime_error("Config file missing 'layersConfig': " + configFilePath);
+        throw std::runtime_error("Config file missing 'layersConfig': " + config.getFilePath());
     }
 
     for (const auto& layerJson : json.at("layersConfig")) {
@@ -153,13 +136,13 @@ ANN::CoreConfig<float> Loader::loadANNConfig(const std::string& configFilePath,
 
     if (json.contains("parameters")) {
         const auto& p = json.at("parameters");
-        coreConfig.parameters.weights = p.at("weights").get<ANN::Tensor3D<float>>();
-        coreConfig.parameters.biases = p.at("biases").get<ANN::Tensor2D<float>>();
+        coreConfig.parameters.weights = config.getTensor<ANN::Tensor3D<float>>(p.at("weights"));
+        coreConfig.parameters.biases = config.getTensor<ANN::Tensor2D<float>>(p.at("biases"));
     }
 
     bool isPredictOrTest = (coreConfig.modeType == ANN::ModeType::PREDICT || coreConfig.modeType == ANN::ModeType::TEST);
     if (isPredictOrTest && !json.contains("parameters")) {
-        throw std::runtime_error("Config file missing 'parameters' required for predict/test modes: " + configFilePath);
+        throw std::runtime_error("Config file missing 'parameters' required for predict/test modes: " + config.getFilePath());
     }
 
     return coreConfig;
@@ -169,17 +152,10 @@ ANN::CoreConfig<float> Loader::loadANNConfig(const std::string& configFilePath,
 // CNN config loading
 //===================================================================================================================//
 
-CNN::CoreConfig<float> Loader::loadCNNConfig(const std::string& configFilePath,
+CNN::CoreConfig<float> Loader::loadCNNConfig(const ModelFile& config,
                                                std::optional<std::string> modeOverride,
                                                std::optional<std::string> deviceOverride) {
-    QFile file(QString::fromStdString(configFilePath));
-
-    if (!file.open(QIODevice::ReadOnly)) {
-        throw std::runtime_error("Failed to open config file: " + configFilePath);
-    }
-
-    QByteArray fileData = file.readAll();
-    nlohmann::json json = nlohmann::json::parse(fileData.toStdString());
+    const auto& json = config.getDocument();
 
     CNN::CoreConfig<float> coreConfig;
 
@@ -206,7 +182,7 @@ CNN::CoreConfig<float> Loader::loadCNNConfig(const std::string& configFilePath,
 
     // Input shape (required for CNN)
     if (!json.contains("inputShape")) {
-        throw std::runtime_error("CNN config file missing 'inputShape': " + configFilePath);
+        throw std::runtime_error("CNN config file missing 'inputShape': " + config.getFilePath());
     }
     const auto& shapeJson = json.at("inputShape");
     coreConfig.inputShape.c = shapeJson.at("c").get<ulong>();
@@ -294,22 +270,22 @@ CNN::CoreConfig<float> Loader::loadCNNConfig(const std::string& configFilePath,
                 cp.inputC = convJson.at("inputC").get<ulong>();
                 cp.filterH = convJson.at("filterH").get<ulong>();
                 cp.filterW = convJson.at("filterW").get<ulong>();
-                cp.filters = convJson.at("filters").get<std::vector<float>>();
-                cp.biases = convJson.at("biases").get<std::vector<float>>();
+                cp.filters = config.getTensor<std::vector<float>>(convJson.at("filters"));
+                cp.biases = config.getTensor<std::vector<float>>(convJson.at("biases"));
                 coreConfig.parameters.convParams.push_back(std::move(cp));
             }
         }
 
         if (paramsJson.contains("dense")) {
             const auto& denseJson = paramsJson.at("dense");
-            coreConfig.parameters.denseParams.weights = denseJson.at("weights").get<ANN::Tensor3D<float>>();
-            coreConfig.parameters.denseParams.biases = denseJson.at("biases").get<ANN::Tensor2D<float>>();
+            coreConfig.parameters.denseParams.weights = config.getTensor<ANN::Tensor3D<float>>(denseJson.at("weights"));
+            coreConfig.parameters.denseParams.biases = config.getTensor<ANN::Tensor2D<float>>(denseJson.at("biases"));
         }
     }
 
     bool isPredictOrTest = (coreConfig.modeType == CNN::ModeType::PREDICT || coreConfig.modeType == CNN::ModeType::TEST);
     if (isPredictOrTest && !json.contains("parameters")) {
-        throw std::runtime_error("CNN config file missing 'parameters' required for predict/test modes: " + configFilePath);
+        throw std::runtime_error("CNN config file missing 'parameters' required for predict/test modes: " + config.getFilePath());
     }
 
     return coreConfig;
@@ -322,61 +298,79 @@ CNN::CoreConfig<float> Loader::loadCNNConfig(const std::string& configFilePath,
 ANN::Samples<float> Loader::loadANNSamples(const std::string& samplesFilePath,
                                              const IOConfig& ioConfig,
                                              ulong progressReports) {
-    QFile file(QString::fromStdString(samplesFilePath));
-
-    if (!file.open(QIODevice::ReadOnly)) {
-        throw std::runtime_error("Failed to open samples file: " + samplesFilePath);
+    // Packed datasets are already preprocessed — copy records straight out of the mapping
+    if (PackedDataset::isPackedFile(samplesFilePath)) {
+        PackedDataset dataset;
+        dataset.open(samplesFilePath);
+
+        size_t totalSamples = dataset.numSamples();
+        ANN::Samples<float> samples(totalSamples);
+
+        for (size_t i = 0; i < totalSamples; ++i) {
+            samples[i].input = dataset.input(i);
+            samples[i].output = dataset.output(i);
+            ProgressBar::printLoadingProgress("Loading samples:", i + 1, totalSamples, progressReports);
+        }
+        return samples;
     }
 
-    QByteArray fileData = file.readAll();
-    nlohmann::json json = nlohmann::json::parse(fileData.toStdString());
+    // Stream the samples array straight into Sample objects — no JSON DOM is built
+    SamplesReader reader(samplesFilePath);
+    size_t totalSamples = reader.openArray("samples");
 
     // Resolve base directory for relative image paths
     std::string baseDir = QFileInfo(QString::fromStdString(samplesFilePath)).absolutePath().toStdString();
 
-    const auto& samplesArray = json.at("samples");
-    size_t totalSamples = samplesArray.size();
+    bool imageInput = (ioConfig.inputType == DataType::IMAGE);
+    bool imageOutput = (ioConfig.outputType == DataType::IMAGE);
+    bool hasImages = imageInput || imageOutput;
 
-    ANN::Samples<float> samples;
-    samples.reserve(totalSamples);
-    size_t idx = 0;
+    ANN::Samples<float> samples(totalSamples);
+    std::vector<std::string> inputPaths(imageInput ? totalSamples : 0);
+    std::vector<std::string> outputPaths(imageOutput ? totalSamples : 0);
 
-    for (const auto& sampleJson : samplesArray) {
-        ANN::Sample<float> sample;
+    // Parse elements concurrently, each into its own slot (image paths are decoded in a second pass)
+    Parallel::forEach(totalSamples, [&](ulong i) {
+        StreamedSample streamed = reader.readSample(i);
 
         // Input
-        if (ioConfig.inputType == DataType::IMAGE) {
+        if (imageInput) {
             if (!ioConfig.hasInputShape()) {
                 throw std::runtime_error("inputType is 'image' but no inputShape provided in config.");
             }
-            std::string imgPath = ImageLoader::resolvePath(
-                sampleJson.at("input").get<std::string>(), baseDir);
-            sample.input = ImageLoader::loadImage(imgPath,
-                static_cast<int>(ioConfig.inputC),
-                static_cast<int>(ioConfig.inputH),
-                static_cast<int>(ioConfig.inputW));
+            inputPaths[i] = ImageLoader::resolvePath(SamplesReader::takePath(streamed.input, "input"), baseDir);
         } else {
-            sample.input = sampleJson.at("input").get<std::vector<float>>();
+            samples[i].input = SamplesReader::takeData(streamed.input, "input");
         }
 
         // Output
-        if (ioConfig.outputType == DataType::IMAGE) {
+        if (imageOutput) {
             if (!ioConfig.hasOutputShape()) {
                 throw std::runtime_error("outputType is 'image' but no outputShape provided in config.");
             }
-            std::string imgPath = ImageLoader::resolvePath(
-                sampleJson.at("output").get<std::string>(), baseDir);
-            sample.output = ImageLoader::loadImage(imgPath,
+            outputPaths[i] = ImageLoader::resolvePath(SamplesReader::takePath(streamed.output, "output"), baseDir);
+        } else {
+            samples[i].output = SamplesReader::takeData(streamed.output, "output");
+        }
+    }, "Loading samples:", hasImages ? 0 : progressReports);
+
+    if (!hasImages) return samples;
+
+    // Decode images concurrently; each lands in its sample's slot, so order is preserved
+    Parallel::forEach(totalSamples, [&](ulong i) {
+        if (imageInput) {
+            samples[i].input = ImageLoader::loadImage(inputPaths[i],
+                static_cast<int>(ioConfig.inputC),
+                static_cast<int>(ioConfig.inputH),
+                static_cast<int>(ioConfig.inputW));
+        }
+        if (imageOutput) {
+            samples[i].output = ImageLoader::loadImage(outputPaths[i],
                 static_cast<int>(ioConfig.outputC),
                 static_cast<int>(ioConfig.outputH),
                 static_cast<int>(ioConfig.outputW));
-        } else {
-            sample.output = sampleJson.at("output").get<std::vector<float>>();
         }
-
-        samples.push_back(std::move(sample));
-        ProgressBar::printLoadingProgress("Loading samples:", ++idx, totalSamples, progressReports);
-    }
+    }, "Loading samples:", progressReports);
     return samples;
 }
 
@@ -386,65 +380,89 @@ CNN::Samples<float> Loader::loadCNNSamples(const std::string& samplesFilePath,
                                              const CNN::Shape3D& inputShape,
                                              const IOConfig& ioConfig,
                                              ulong progressReports) {
-    QFile file(QString::fromStdString(samplesFilePath));
+    // Packed datasets are already preprocessed — copy records straight out of the mapping
+    if (PackedDataset::isPackedFile(samplesFilePath)) {
+        PackedDataset dataset;
+        dataset.open(samplesFilePath);
+
+        if (dataset.inputSize() != inputShape.size()) {
+            throw std::runtime_error("Packed dataset input size (" + std::to_string(dataset.inputSize()) +
+              ") does not match expected input shape size (" + std::to_string(inputShape.size()) + ")");
+        }
+
+        size_t totalSamples = dataset.numSamples();
+        CNN::Samples<float> samples(totalSamples);
 
-    if (!file.open(QIODevice::ReadOnly)) {
-        throw std::runtime_error("Failed to open samples file: " + samplesFilePath);
+        for (size_t i = 0; i < totalSamples; ++i) {
+            samples[i].input = CNN::Input<float>(inputShape);
+            dataset.readInput(i, samples[i].input.data.data());
+            samples[i].output = dataset.output(i);
+            ProgressBar::printLoadingProgress("Loading samples:", i + 1, totalSamples, progressReports);
+        }
+        return samples;
     }
 
-    QByteArray fileData = file.readAll();
-    nlohmann::json json = nlohmann::json::parse(fileData.toStdString());
+    // Stream the samples array straight into Sample objects — no JSON DOM is built
+    SamplesReader reader(samplesFilePath);
+    size_t totalSamples = reader.openArray("samples");
 
     std::string baseDir = QFileInfo(QString::fromStdString(samplesFilePath)).absolutePath().toStdString();
 
-    const nlohmann::json& samplesArray = json.at("samples");
-    size_t totalSamples = samplesArray.size();
+    bool imageInput = (ioConfig.inputType == DataType::IMAGE);
+    bool imageOutput = (ioConfig.outputType == DataType::IMAGE);
+    bool hasImages = imageInput || imageOutput;
 
-    CNN::Samples<float> samples;
-    samples.reserve(totalSamples);
-    size_t idx = 0;
+    CNN::Samples<float> samples(totalSamples);
+    std::vector<std::string> inputPaths(imageInput ? totalSamples : 0);
+    std::vector<std::string> outputPaths(imageOutput ? totalSamples : 0);
 
-    for (const auto& sampleJson : samplesArray) {
-        CNN::Sample<float> sample;
+    // Parse elements concurrently, each into its own slot (image paths are decoded in a second pass)
+    Parallel::forEach(totalSamples, [&](ulong i) {
+        StreamedSample streamed = reader.readSample(i);
 
         // Input
-        if (ioConfig.inputType == DataType::IMAGE) {
-            std::string imgPath = ImageLoader::resolvePath(
-                sampleJson.at("input").get<std::string>(), baseDir);
-            std::vector<float> flatInput = ImageLoader::loadImage(imgPath,
-                static_cast<int>(inputShape.c),
-                static_cast<int>(inputShape.h),
-                static_cast<int>(inputShape.w));
-            sample.input = CNN::Input<float>(inputShape);
-            sample.input.data = std::move(flatInput);
+        if (imageInput) {
+            inputPaths[i] = ImageLoader::resolvePath(SamplesReader::takePath(streamed.input, "input"), baseDir);
         } else {
-            std::vector<float> flatInput = sampleJson.at("input").get<std::vector<float>>();
+            std::vector<float> flatInput = SamplesReader::takeData(streamed.input, "input");
             if (flatInput.size() != inputShape.size()) {
                 throw std::runtime_error("Sample input size (" + std::to_string(flatInput.size()) +
                   ") does not match expected input shape size (" + std::to_string(inputShape.size()) + ")");
             }
-            sample.input = CNN::Input<float>(inputShape);
-            sample.input.data = std::move(flatInput);
+            samples[i].input = CNN::Input<float>(inputShape);
+            samples[i].input.data = std::move(flatInput);
         }
 
         // Output
-        if (ioConfig.outputType == DataType::IMAGE) {
+        if (imageOutput) {
             if (!ioConfig.hasOutputShape()) {
                 throw std::runtime_error("outputType is 'image' but no outputShape provided in config.");
             }
-            std::string imgPath = ImageLoader::resolvePath(
-                sampleJson.at("output").get<std::string>(), baseDir);
-            sample.output = ImageLoader::loadImage(imgPath,
+            outputPaths[i] = ImageLoader::resolvePath(SamplesReader::takePath(streamed.output, "output"), baseDir);
+        } else {
+            samples[i].output = SamplesReader::takeData(streamed.output, "output");
+        }
+    }, "Loading samples:", hasImages ? 0 : progressReports);
+
+    if (!hasImages) return samples;
+
+    // Decode images concurrently; each lands in its sample's slot, so order is preserved
+    Parallel::forEach(totalSamples, [&](ulong i) {
+        if (imageInput) {
+            samples[i].input = CNN::Input<float>(inputShape);
+            ImageLoader::loadImage(inputPaths[i],
+                static_cast<int>(inputShape.c),
+                static_cast<int>(inputShape.h),
+                static_cast<int>(inputShape.w),
+                samples[i].input.data.data());
+        }
+        if (imageOutput) {
+            samples[i].output = ImageLoader::loadImage(outputPaths[i],
                 static_cast<int>(ioConfig.outputC),
                 static_cast<int>(ioConfig.outputH),
                 static_cast<int>(ioConfig.outputW));
-        } else {
-            sample.output = sampleJson.at("output").get<CNN::Output<float>>();
         }
-
-        samples.push_back(std::move(sample));
-        ProgressBar::printLoadingProgress("Loading samples:", ++idx, totalSamples, progressReports);
-    }
+    }, "Loading samples:", progressReports);
 
     return samples;
 }
@@ -454,42 +472,55 @@ CNN::Samples<float> Loader::loadCNNSamples(const std::string& samplesFilePath,
 std::vector<ANN::Input<float>> Loader::loadANNInputs(const std::string& inputFilePath,
                                                        const IOConfig& ioConfig,
                                                        ulong progressReports) {
-    QFile file(QString::fromStdString(inputFilePath));
+    if (NpyDataset::isNpyFile(inputFilePath)) {
+        // Numeric rows straight from the mapped array — no text parsing
+        NpyDataset dataset;
+        dataset.open(inputFilePath);
+        if (dataset.numSamples() == 0) {
+            throw std::runtime_error("NumPy inputs array is empty: " + inputFilePath);
+        }
 
-    if (!file.open(QIODevice::ReadOnly)) {
-        throw std::runtime_error("Failed to open input file: " + inputFilePath);
+        std::vector<ANN::Input<float>> inputs(dataset.numSamples());
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            inputs[i].resize(dataset.inputSize());
+            dataset.readInput(i, inputs[i].data());
+            ProgressBar::printLoadingProgress("Loading inputs:", i + 1, inputs.size(), progressReports);
+        }
+        return inputs;
     }
 
-    QByteArray fileData = file.readAll();
-    nlohmann::json json = nlohmann::json::parse(fileData.toStdString());
-
-    const auto& inputsArray = json.at("inputs");
-    if (!inputsArray.is_array() || inputsArray.empty()) {
+    SamplesReader reader(inputFilePath, "input");
+    if (reader.openArray("inputs") == 0) {
         throw std::runtime_error("'inputs' must be a non-empty array in: " + inputFilePath);
     }
 
     std::string baseDir = QFileInfo(QString::fromStdString(inputFilePath)).absolutePath().toStdString();
-    size_t totalInputs = inputsArray.size();
-    std::vector<ANN::Input<float>> inputs;
-    inputs.reserve(totalInputs);
-    size_t idx = 0;
+    size_t totalInputs = reader.size();
+    std::vector<ANN::Input<float>> inputs(totalInputs);
 
-    for (const auto& entry : inputsArray) {
-        if (ioConfig.inputType == DataType::IMAGE) {
-            if (!ioConfig.hasInputShape()) {
-                throw std::runtime_error("inputType is 'image' but no inputShape provided in config.");
-            }
-            std::string imgPath = ImageLoader::resolvePath(entry.get<std::string>(), baseDir);
-            inputs.push_back(ImageLoader::loadImage(imgPath,
-                static_cast<int>(ioConfig.inputC),
-                static_cast<int>(ioConfig.inputH),
-                static_cast<int>(ioConfig.inputW)));
-        } else {
-            inputs.push_back(entry.get<std::vector<float>>());
-        }
-        ProgressBar::printLoadingProgress("Loading inputs:", ++idx, totalInputs, progressReports);
+    if (ioConfig.inputType != DataType::IMAGE) {
+        // Numeric arrays: parse elements concurrently, each into its own slot
+        Parallel::forEach(totalInputs, [&](ulong i) {
+            StreamedValue entry = reader.readValue(i);
+            inputs[i] = SamplesReader::takeData(entry, "inputs");
+        }, "Loading inputs:", progressReports);
+        return inputs;
     }
 
+    if (!ioConfig.hasInputShape()) {
+        throw std::runtime_error("inputType is 'image' but no inputShape provided in config.");
+    }
+
+    // Images: parse and decode concurrently, each into its own slot so input order is preserved
+    Parallel::forEach(totalInputs, [&](ulong i) {
+        StreamedValue entry = reader.readValue(i);
+        std::string imgPath = ImageLoader::resolvePath(SamplesReader::takePath(entry, "inputs"), baseDir);
+        inputs[i] = ImageLoader::loadImage(imgPath,
+            static_cast<int>(ioConfig.inputC),
+            static_cast<int>(ioConfig.inputH),
+            static_cast<int>(ioConfig.inputW));
+    }, "Loading inputs:", progressReports);
+
     return inputs;
 }
 
@@ -499,49 +530,67 @@ std::vector<CNN::Input<float>> Loader::loadCNNInputs(const std::string& inputFil
                                                        const CNN::Shape3D& inputShape,
                                                        const IOConfig& ioConfig,
                                                        ulong progressReports) {
-    QFile file(QString::fromStdString(inputFilePath));
+    if (NpyDataset::isNpyFile(inputFilePath)) {
+        // Numeric rows straight from the mapped array — no text parsing
+        NpyDataset dataset;
+        dataset.open(inputFilePath);
+        if (dataset.numSamples() == 0) {
+            throw std::runtime_error("NumPy inputs array is empty: " + inputFilePath);
+        }
+        if (dataset.inputSize() != inputShape.size()) {
+            throw std::runtime_error("Input size (" + std::to_string(dataset.inputSize()) +
+              ") does not match expected input shape size (" + std::to_string(inputShape.size()) + ")");
+        }
 
-    if (!file.open(QIODevice::ReadOnly)) {
-        throw std::runtime_error("Failed to open input file: " + inputFilePath);
+        std::vector<CNN::Input<float>> inputs;
+        inputs.reserve(dataset.numSamples());
+        for (size_t i = 0; i < dataset.numSamples(); ++i) {
+            CNN::Input<float> input(inputShape);
+            dataset.readInput(i, input.data.data());
+            inputs.push_back(std::move(input));
+            ProgressBar::printLoadingProgress("Loading inputs:", i + 1, dataset.numSamples(), progressReports);
+        }
+        return inputs;
     }
 
-    QByteArray fileData = file.readAll();
-    nlohmann::json json = nlohmann::json::parse(fileData.toStdString());
-
-    const auto& inputsArray = json.at("inputs");
-    if (!inputsArray.is_array() || inputsArray.empty()) {
+    SamplesReader reader(inputFilePath, "input");
+    if (reader.openArray("inputs") == 0) {
         throw std::runtime_error("'inputs' must be a non-empty array in: " + inputFilePath);
     }
 
     std::string baseDir = QFileInfo(QString::fromStdString(inputFilePath)).absolutePath().toStdString();
-    size_t totalInputs = inputsArray.size();
-    std::vector<CNN::Input<float>> inputs;
-    inputs.reserve(totalInputs);
-    size_t idx = 0;
-
-    for (const auto& entry : inputsArray) {
-        std::vector<float> flatInput;
-
-        if (ioConfig.inputType == DataType::IMAGE) {
-            std::string imgPath = ImageLoader::resolvePath(entry.get<std::string>(), baseDir);
-            flatInput = ImageLoader::loadImage(imgPath,
-                static_cast<int>(inputShape.c),
-                static_cast<int>(inputShape.h),
-                static_cast<int>(inputShape.w));
-        } else {
-            flatInput = entry.get<std::vector<float>>();
-        }
+    size_t totalInputs = reader.size();
+    std::vector<CNN::Input<float>> inputs(totalInputs);
+    bool imageInput = (ioConfig.inputType == DataType::IMAGE);
 
+    auto storeInput = [&](size_t i, std::vector<float>&& flatInput) {
         if (flatInput.size() != inputShape.size()) {
             throw std::runtime_error("Input size (" + std::to_string(flatInput.size()) +
               ") does not match expected input shape size (" + std::to_string(inputShape.size()) + ")");
         }
 
-        CNN::Input<float> input(inputShape);
-        input.data = std::move(flatInput);
-        inputs.push_back(std::move(input));
-        ProgressBar::printLoadingProgress("Loading inputs:", ++idx, totalInputs, progressReports);
-    }
+        inputs[i] = CNN::Input<float>(inputShape);
+        inputs[i].data = std::move(flatInput);
+    };
+
+    if (!imageInput) {
+        // Numeric arrays: parse elements concurrently, each into its own slot
+        Parallel::forEach(totalInputs, [&](ulong i) {
+            StreamedValue entry = reader.readValue(i);
+            storeInput(i, SamplesReader::takeData(entry, "inputs"));
+        }, "Loading inputs:", progressReports);
+        return inputs;
+    }
+
+    // Images: parse and decode concurrently, each into its own slot so input order is preserved
+    Parallel::forEach(totalInputs, [&](ulong i) {
+        StreamedValue entry = reader.readValue(i);
+        std::string imgPath = ImageLoader::resolvePath(SamplesReader::takePath(entry, "inputs"), baseDir);
+        storeInput(i, ImageLoader::loadImage(imgPath,
+            static_cast<int>(inputShape.c),
+            static_cast<int>(inputShape.h),
+            static_cast<int>(inputShape.w)));
+    }, "Loading inputs:", progressReports);
 
     return inputs;
 }
@@ -550,15 +599,8 @@ std::vector<CNN::Input<float>> Loader::loadCNNInputs(const std::string& inputFil
 // progressReports loading
 //===================================================================================================================//
 
-ulong Loader::loadProgressReports(const std::string& configFilePath) {
-    QFile file(QString::fromStdString(configFilePath));
-
-    if (!file.open(QIODevice::ReadOnly)) {
-        throw std::runtime_error("Failed to open config file: " + configFilePath);
-    }
-
-    QByteArray fileData = file.readAll();
-    nlohmann::json json = nlohmann::json::parse(fileData.toStdString());
+ulong Loader::loadProgressReports(const ModelFile& config) {
+    const auto& json = config.getDocument();
 
     if (json.contains("progressReports")) {
         return json.at("progressReports").get<ulong>();
@@ -571,15 +613,8 @@ ulong Loader::loadProgressReports(const std::string& configFilePath) {
 // saveModelInterval loading
 //===================================================================================================================//
 
-ulong Loader::loadSaveModelInterval(const std::string& configFilePath) {
-    QFile file(QString::fromStdString(configFilePath));
-
-    if (!file.open(QIODevice::ReadOnly)) {
-        throw std::runtime_error("Failed to open config file: " + configFilePath);
-    }
-
-    QByteArray fileData = file.readAll();
-    nlohmann::json json = nlohmann::json::parse(fileData.toStdString());
+ulong Loader::loadSaveModelInterval(const ModelFile& config) {
+    const auto& json = config.getDocument();
 
     if (json.contains("saveModelInterval")) {
         return json.at("saveModelInterval").get<ulong>();
@@ -590,15 +625,8 @@ ulong Loader::loadSaveModelInterval(const std::string& configFilePath) {
 
 //===================================================================================================================//
 
-Loader::AugmentationConfig Loader::loadAugmentationConfig(const std::string& configFilePath) {
-    QFile file(QString::fromStdString(configFilePath));
-
-    if (!file.open(QIODevice::ReadOnly)) {
-        throw std::runtime_error("Failed to open config file: " + configFilePath);
-    }
-
-    QByteArray fileData = file.readAll();
-    nlohmann::json json = nlohmann::json::parse(fileData.toStdString());
+Loader::AugmentationConfig Loader::loadAugmentationConfig(const ModelFile& modelFile) {
+    const auto& json = modelFile.getDocument();
 
     AugmentationConfig config;
 
@@ -24,23 +24,28 @@
 
 namespace NN_CLI {
 
+class ModelFile;
+
 class Loader {
 public:
+  // The config readers below take the config/model file parsed once by ModelFile, so a trained
+  // model's weights are read a single time however many settings are extracted from it.
+
   // Detect whether a config file defines an ANN or CNN network.
-  static NetworkType detectNetworkType(const std::string& configFilePath);
+  static NetworkType detectNetworkType(const ModelFile& config);
 
   // Load I/O configuration (inputType, outputType, shapes) with optional CLI overrides
-  static IOConfig loadIOConfig(const std::string& configFilePath,
+  static IOConfig loadIOConfig(const ModelFile& config,
                                 std::optional<std::string> inputTypeOverride  = std::nullopt,
                                 std::optional<std::string> outputTypeOverride = std::nullopt);
 
   // Load ANN configuration with optional CLI overrides
-  static ANN::CoreConfig<float> loadANNConfig(const std::string& configFilePath,
+  static ANN::CoreConfig<float> loadANNConfig(const ModelFile& config,
                                                std::optional<ANN::ModeType> modeType = std::nullopt,
                                                std::optional<ANN::DeviceType> deviceType = std::nullopt);
 
   // Load CNN configuration with optional CLI overrides
-  static CNN::CoreConfig<float> loadCNNConfig(const std::string& configFilePath,
+  static CNN::CoreConfig<float> loadCNNConfig(const ModelFile& config,
                                                std::optional<std::string> modeOverride = std::nullopt,
                                                std::optional<std::string> deviceOverride = std::nullopt);
 
@@ -56,21 +61,23 @@ public:
                                              ulong progressReports = 1000);
 
   // Load ANN inputs from JSON (batch: "inputs" array; supports image paths when ioConfig.inputType is IMAGE)
+  // or from a NumPy .npy array with one input per row (detected by its magic bytes)
   static std::vector<ANN::Input<float>> loadANNInputs(const std::string& inputFilePath,
                                                        const IOConfig& ioConfig,
                                                        ulong progressReports = 1000);
 
   // Load CNN inputs from JSON (batch: "inputs" array; supports image paths when ioConfig.inputType is IMAGE)
+  // or from a NumPy .npy array with one input per row (detected by its magic bytes)
   static std::vector<CNN::Input<float>> loadCNNInputs(const std::string& inputFilePath,
                                                        const CNN::Shape3D& inputShape,
                                                        const IOConfig& ioConfig,
                                                        ulong progressReports = 1000);
 
   // Load progressReports from config root (returns 1000 if not present)
-  static ulong loadProgressReports(const std::string& configFilePath);
+  static ulong loadProgressReports(const ModelFile& config);
 
   // Load saveModelInterval from config root (returns 10 if not present; 0 = disabled)
-  static ulong loadSaveModelInterval(const std::string& configFilePath);
+  static ulong loadSaveModelInterval(const ModelFile& config);
 
   // Load data augmentation config from trainingConfig (NN-CLI handles augmentation, not ANN/CNN)
   struct AugmentationTransforms {
@@ -89,7 +96,7 @@ public:
     float augmentationProbability = 0.5f; // Probability of applying each enabled transform (default 50%)
     AugmentationTransforms transforms;  // Which transforms to apply and their intensities
   };
-  static AugmentationConfig loadAugmentationConfig(const std::string& configFilePath);
+  static AugmentationConfig loadAugmentationConfig(const ModelFile& modelFile);
 };
 
 } // namespace NN_CLI
@@ -0,0 +1,49 @@
+#ifndef NN_CLI_MAPPEDDATASET_HPP
+#define NN_CLI_MAPPEDDATASET_HPP
+
+#include <vector>
+
+#include <sys/types.h>
+
+//===================================================================================================================//
+
+namespace NN_CLI {
+
+/**
+ * MappedDataset: read-only, fixed-record dataset backed by a memory-mapped file.
+ *
+ * Implementations keep samples in their on-disk encoding and convert one record to float
+ * on request, so DataLoader can normalise lazily while assembling batches.
+ * All methods must be safe to call concurrently.
+ */
+class MappedDataset {
+  public:
+    virtual ~MappedDataset() = default;
+
+    virtual ulong numSamples() const = 0;
+    virtual ulong inputSize() const = 0;
+    virtual ulong outputSize() const = 0;
+
+    // Decode one record into a caller-provided buffer of inputSize()/outputSize() floats.
+    virtual void readInput(ulong index, float* dst) const = 0;
+    virtual void readOutput(ulong index, float* dst) const = 0;
+
+    // Convenience accessors returning a fresh vector.
+    std::vector<float> input(ulong index) const {
+      std::vector<float> result(this->inputSize());
+      this->readInput(index, result.data());
+      return result;
+    }
+
+    std::vector<float> output(ulong index) const {
+      std::vector<float> result(this->outputSize());
+      this->readOutput(index, result.data());
+      return result;
+    }
+};
+
+} // namespace NN_CLI
+
+//===================================================================================================================//
+
+#endif // NN_CLI_MAPPEDDATASET_HPP
@@ -0,0 +1,698 @@
+#include "NN-CLI_ModelFile.hpp"
+#include "NN-CLI_Parallel.hpp"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+namespace NN_CLI {
+
+//===================================================================================================================//
+
+static const char modelMagic[8] = {'N', 'N', 'C', 'L', 'I', 'M', 'D', '\0'};
+static const uint32_t modelVersion = 1;
+
+static uint64_t alignTo64(uint64_t offset) {
+  return (offset + 63) & ~static_cast<uint64_t>(63);
+}
+
+// Number of values in a tensor of the given shape. Returns false if it overflows, as only a corrupt file's can.
+static bool shapeCount(const std::vector<ulong>& shape, uint64_t& count) {
+  count = 1;
+  for (ulong dim : shape) {
+    if (dim != 0 && count > UINT64_MAX / dim) return false;
+    count *= dim;
+  }
+  return true;
+}
+
+//===================================================================================================================//
+//-- ModelFile --//
+//===================================================================================================================//
+
+ModelFile::ModelFile(const std::string& filePath, bool loadParameters) : filePath(filePath) {
+  this->file = std::make_unique<QFile>(QString::fromStdString(filePath));
+
+  if (!this->file->open(QIODevice::ReadOnly)) {
+    throw std::runtime_error("Failed to open config file: " + filePath);
+  }
+
+  char magic[sizeof(modelMagic)];
+  this->binary = this->file->read(magic, sizeof(magic)) == static_cast<qint64>(sizeof(magic)) &&
+                 std::memcmp(magic, modelMagic, sizeof(modelMagic)) == 0;
+
+  if (!this->binary) {
+    this->file->seek(0);
+    QByteArray fileData = this->file->readAll();
+    const char* text = fileData.constData();
+    if (loadParameters) {
+      this->document = nlohmann::ordered_json::parse(text, text + fileData.size());
+    } else {
+      this->parseHeader(text, text + fileData.size());
+    }
+    this->file.reset();
+    return;
+  }
+
+  qint64 fileSize = this->file->size();
+  if (fileSize < static_cast<qint64>(sizeof(ModelHeader))) {
+    throw std::runtime_error("Model file is truncated: " + filePath);
+  }
+
+  this->file->seek(0);
+  this->file->read(reinterpret_cast<char*>(&this->header), sizeof(ModelHeader));
+
+  if (this->header.version != modelVersion) {
+    throw std::runtime_error("Unsupported model file version " + std::to_string(this->header.version) +
+                             ": " + filePath);
+  }
+  if (this->header.elementType != static_cast<uint32_t>(PackedElementType::FLOAT32) &&
+      this->header.elementType != static_cast<uint32_t>(PackedElementType::FLOAT16)) {
+    throw std::runtime_error("Unknown element type in model file: " + filePath);
+  }
+  if (this->header.dataOffset < sizeof(ModelHeader) ||
+      this->header.documentSize > this->header.dataOffset - sizeof(ModelHeader) ||
+      this->header.dataOffset > static_cast<uint64_t>(fileSize) ||
+      this->header.dataSize > static_cast<uint64_t>(fileSize) - this->header.dataOffset) {
+    throw std::runtime_error("Model file is truncated: " + filePath);
+  }
+
+  // Header only: read the document and leave the data block untouched
+  if (!loadParameters) {
+    QByteArray text = this->file->read(static_cast<qint64>(this->header.documentSize));
+    this->document = nlohmann::ordered_json::parse(text.constData(), text.constData() + text.size());
+    this->file.reset();
+    return;
+  }
+
+  this->data = this->file->map(0, fileSize);
+  if (!this->data) {
+    throw std::runtime_error("Failed to memory-map model file: " + filePath);
+  }
+
+  const char* text = reinterpret_cast<const char*>(this->data + sizeof(ModelHeader));
+  this->document = nlohmann::ordered_json::parse(text, text + this->header.documentSize);
+}
+
+ModelFile::~ModelFile() = default;
+
+//===================================================================================================================//
+
+bool ModelFile::isModelFile(const std::string& filePath) {
+  QFile file(QString::fromStdString(filePath));
+  if (!file.open(QIODevice::ReadOnly)) return false;
+
+  char magic[sizeof(modelMagic)];
+  if (file.read(magic, sizeof(magic)) != static_cast<qint64>(sizeof(magic))) return false;
+
+  return std::memcmp(magic, modelMagic, sizeof(modelMagic)) == 0;
+}
+
+//===================================================================================================================//
+
+bool ModelFile::isBinaryModelPath(const std::string& filePath) {
+  return QFileInfo(QString::fromStdString(filePath)).suffix().toLower() == "nnmodel";
+}
+
+//===================================================================================================================//
+
+bool ModelFile::isTensorReference(const nlohmann::ordered_json& node) {
+  return node.is_object() && node.contains("offset") && node.contains("shape");
+}
+
+//===================================================================================================================//
+
+bool ModelFile::hasParameters() const {
+  return this->parametersSkipped || this->document.contains("parameters");
+}
+
+//===================================================================================================================//
+
+ulong ModelFile::getNumParameters() const {
+  if (this->parametersSkipped) return this->skippedParameters;
+  if (!this->document.contains("parameters")) return 0;
+  return this->countParameters(this->document.at("parameters"));
+}
+
+//===================================================================================================================//
+
+ulong ModelFile::countParameters(const nlohmann::ordered_json& node) const {
+  if (isTensorReference(node)) {
+    uint64_t count = 0;
+    if (!shapeCount(node.at("shape").get<std::vector<ulong>>(), count)) {
+      throw std::runtime_error("Tensor shape overflows in model file: " + this->filePath);
+    }
+    return count;
+  }
+  if (node.is_number()) return 1;
+
+  ulong count = 0;
+  if (node.is_structured()) {
+    for (const auto& element : node) count += this->countParameters(element);
+  }
+  return count;
+}
+
+//===================================================================================================================//
+
+// Minimal scanner over JSON text: finds where values end without building them.
+namespace {
+struct JsonScanner {
+  const char* pos;
+  const char* end;
+
+  void skipWhitespace() {
+    while (this->pos < this->end && (*this->pos == ' ' || *this->pos == '\n' || *this->pos == '\r' || *this->pos == '\t')) {
+      this->pos++;
+    }
+  }
+
+  bool consume(char c) {
+    this->skipWhitespace();
+    if (this->pos >= this->end || *this->pos != c) return false;
+    this->pos++;
+    return true;
+  }
+
+  // pos is on the opening quote; leaves pos after the closing one
+  bool skipString() {
+    for (this->pos++; this->pos < this->end; this->pos++) {
+      if (*this->pos == '\\') this->pos++;
+      else if (*this->pos == '"') {
+        this->pos++;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Skip one value, counting the numbers inside it
+  bool skipValue(ulong& numbers) {
+    this->skipWhitespace();
+    if (this->pos >= this->end) return false;
+    if (*this->pos == '"') return this->skipString();
+
+    long depth = 0;
+    bool inNumber = false;
+    while (this->pos < this->end) {
+      char c = *this->pos;
+      if (c == '"') {
+        if (!this->skipString()) return false;
+        inNumber = false;
+        continue;
+      }
+
+      bool numberChar = (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+      if (!inNumber && ((c >= '0' && c <= '9') || c == '-')) numbers++;
+      inNumber = inNumber ? numberChar : ((c >= '0' && c <= '9') || c == '-');
+
+      if (c == '[' || c == '{') {
+        depth++;
+      } else if (c == ']' || c == '}') {
+        if (depth == 0) return true; // End of the enclosing object: a scalar value ended here
+        if (--depth == 0) {
+          this->pos++;
+          return true;
+        }
+      } else if (depth == 0 && (c == ',' || c == ' ' || c == '\n' || c == '\r' || c == '\t')) {
+        return true;
+      }
+      this->pos++;
+    }
+    return depth == 0;
+  }
+};
+} // namespace
+
+//===================================================================================================================//
+
+void ModelFile::parseHeader(const char* text, const char* end) {
+  // Walk the top-level object: parse every member except "parameters", whose value is only scanned
+  JsonScanner scanner{text, end};
+  nlohmann::ordered_json header = nlohmann::ordered_json::object();
+  bool valid = scanner.consume('{');
+
+  if (valid && !scanner.consume('}')) {
+    for (;;) {
+      scanner.skipWhitespace();
+      const char* keyStart = scanner.pos;
+      if (scanner.pos >= scanner.end || *scanner.pos != '"' || !scanner.skipString()) {
+        valid = false;
+        break;
+      }
+      std::string key = nlohmann::ordered_json::parse(keyStart, scanner.pos).get<std::string>();
+      if (!scanner.consume(':')) {
+        valid = false;
+        break;
+      }
+
+      scanner.skipWhitespace();
+      const char* valueStart = scanner.pos;
+      ulong numbers = 0;
+      if (!scanner.skipValue(numbers)) {
+        valid = false;
+        break;
+      }
+
+      if (key == "parameters") {
+        this->parametersSkipped = true;
+        this->skippedParameters = numbers;
+      } else {
+        header[key] = nlohmann::ordered_json::parse(valueStart, scanner.pos);
+      }
+
+      if (scanner.consume(',')) continue;
+      valid = scanner.consume('}');
+      break;
+    }
+  }
+
+  if (valid) {
+    this->document = std::move(header);
+    return;
+  }
+
+  // Not a plain JSON object: parse it whole, for the parser's error message or its result
+  this->parametersSkipped = false;
+  this->document = nlohmann::ordered_json::parse(text, end);
+  if (this->document.is_object() && this->document.contains("parameters")) {
+    this->skippedParameters = this->getNumParameters();
+    this->parametersSkipped = true;
+    this->document.erase("parameters");
+  }
+}
+
+//===================================================================================================================//
+
+const float* ModelFile::tensorValues(const nlohmann::ordered_json& reference, std::vector<ulong>& shape,
+                                     std::vector<float>& scratch) const {
+  if (!this->isBinary()) {
+    throw std::runtime_error("Tensor reference in a JSON model file: " + this->filePath);
+  }
+  if (!this->data) {
+    throw std::runtime_error("Model parameters were not loaded: " + this->filePath);
+  }
+
+  shape = reference.at("shape").get<std::vector<ulong>>();
+  uint64_t offset = reference.at("offset").get<uint64_t>();
+
+  uint64_t count = 0;
+  PackedElementType type = this->getElementType();
+  size_t elementSize = PackedDataset::elementSize(type);
+  if (!shapeCount(shape, count) || offset % 64 != 0 || offset > this->header.dataSize ||
+      count > (this->header.dataSize - offset) / elementSize) {
+    throw std::runtime_error("Tensor reference out of range in model file: " + this->filePath);
+  }
+
+  const unsigned char* src = this->data + this->header.dataOffset + offset;
+
+  // float32 tensors are 64-byte aligned within a page-aligned mapping: read them in place
+  if (type == PackedElementType::FLOAT32) return reinterpret_cast<const float*>(src);
+
+  scratch.resize(count);
+  PackedDataset::decode(src, type, count, scratch.data());
+  return scratch.data();
+}
+
+//===================================================================================================================//
+
+nlohmann::ordered_json ModelFile::expand(const nlohmann::ordered_json& node) const {
+  if (isTensorReference(node)) {
+    std::vector<ulong> shape;
+    std::vector<float> scratch;
+    const float* values = this->tensorValues(node, shape, scratch);
+
+    // Rebuild the nested arrays in row-major order
+    std::function<nlohmann::ordered_json(size_t)> build = [&](size_t dim) {
+      nlohmann::ordered_json array = nlohmann::ordered_json::array();
+      for (ulong i = 0; i < shape[dim]; i++) {
+        if (dim + 1 == shape.size()) array.push_back(*values++);
+        else array.push_back(build(dim + 1));
+      }
+      return array;
+    };
+    return shape.empty() ? nlohmann::ordered_json::array() : build(0);
+  }
+
+  if (node.is_structured()) {
+    nlohmann::ordered_json result = node;
+    for (auto it = result.begin(); it != result.end(); ++it) *it = this->expand(*it);
+    return result;
+  }
+
+  return node;
+}
+
+//===================================================================================================================//
+
+nlohmann::ordered_json ModelFile::toJson() const {
+  if (!this->isBinary()) return this->document;
+
+  nlohmann::ordered_json json = this->document;
+  if (json.contains("parameters")) json["parameters"] = this->expand(json.at("parameters"));
+  return json;
+}
+
+//===================================================================================================================//
+
+void ModelFile::convert(const std::string& inputPath, const std::string& outputPath, bool binary,
+                        PackedElementType elementType) {
+  ModelFile model(inputPath);
+  nlohmann::ordered_json json = model.toJson();
+
+  if (binary) {
+    ModelFileWriter writer(elementType);
+    if (json.contains("parameters")) json["parameters"] = writer.addTensors(json.at("parameters"));
+    writer.write(outputPath, json);
+    return;
+  }
+
+  writeJson(outputPath, json);
+}
+
+//===================================================================================================================//
+
+void ModelFile::writeJson(const std::string& filePath, const nlohmann::ordered_json& document) {
+  QSaveFile file(QString::fromStdString(filePath));
+  if (!file.open(QIODevice::WriteOnly)) {
+    throw std::runtime_error("Failed to open file for writing: " + filePath);
+  }
+  std::string jsonStr = document.dump(4);
+  file.write(jsonStr.c_str(), static_cast<qint64>(jsonStr.size()));
+  if (!file.commit()) {
+    throw std::runtime_error("Failed to write file: " + filePath);
+  }
+}
+
+//===================================================================================================================//
+//-- ModelFileWriter --//
+//===================================================================================================================//
+
+ModelFileWriter::ModelFileWriter(PackedElementType elementType) : elementType(elementType) {
+  if (elementType != PackedElementType::FLOAT32 && elementType != PackedElementType::FLOAT16) {
+    throw std::runtime_error("Model parameters must be stored as float32 or fp16");
+  }
+}
+
+//===================================================================================================================//
+
+nlohmann::ordered_json ModelFileWriter::beginTensor(const std::vector<ulong>& shape) {
+  // Pad so every tensor starts on a 64-byte boundary of the data block
+  size_t elementSize = PackedDataset::elementSize(this->elementType);
+  size_t alignedCount = alignTo64(this->values.size() * elementSize) / elementSize;
+  this->values.resize(alignedCount, 0.0f);
+
+  nlohmann::ordered_json reference;
+  reference["offset"] = this->values.size() * elementSize;
+  reference["shape"] = shape;
+  return reference;
+}
+
+//===================================================================================================================//
+
+nlohmann::ordered_json ModelFileWriter::addTensors(const nlohmann::ordered_json& node) {
+  // Rectangular numeric array: becomes one tensor
+  std::vector<ulong> shape;
+  std::function<bool(const nlohmann::ordered_json&, size_t)> measure = [&](const nlohmann::ordered_json& n, size_t dim) {
+    if (!n.is_array() || n.empty()) return false;
+    if (dim == shape.size()) shape.push_back(n.size());
+    else if (shape[dim] != n.size()) return false;
+
+    bool leaves = n.front().is_number();
+    for (const auto& element : n) {
+      if (leaves ? !element.is_number() : !measure(element, dim + 1)) return false;
+    }
+    return !leaves || dim + 1 == shape.size();
+  };
+
+  if (measure(node, 0)) {
+    size_t start = this->values.size();
+    nlohmann::ordered_json reference = this->beginTensor(shape);
+    size_t first = this->values.size();
+    std::function<void(const nlohmann::ordered_json&)> append = [&](const nlohmann::ordered_json& n) {
+      for (const auto& element : n) {
+        if (element.is_number()) this->values.push_back(element.get<float>());
+        else append(element);
+      }
+    };
+    append(node);
+
+    // Siblings nested to different depths pass the size checks but not this one
+    uint64_t count = 0;
+    if (shapeCount(shape, count) && this->values.size() - first == count) return reference;
+    this->values.resize(start);
+  }
+
+  // Anything else: keep the structure and convert what is inside it
+  if (node.is_structured()) {
+    nlohmann::ordered_json result = node;
+    for (auto it = result.begin(); it != result.end(); ++it) *it = this->addTensors(*it);
+    return result;
+  }
+
+  return node;
+}
+
+//===================================================================================================================//
+
+void ModelFileWriter::write(const std::string& filePath, const nlohmann::ordered_json& document) const {
+  std::string documentText = document.dump();
+
+  // float32 values are written as they are; fp16 is encoded first
+  size_t elementSize = PackedDataset::elementSize(this->elementType);
+  std::vector<unsigned char> encoded;
+  const char* block = reinterpret_cast<const char*>(this->values.data());
+  if (this->elementType != PackedElementType::FLOAT32) {
+    encoded.resize(this->values.size() * elementSize);
+    PackedDataset::encode(this->values.data(), this->elementType, this->values.size(), encoded.data());
+    block = reinterpret_cast<const char*>(encoded.data());
+  }
+  uint64_t blockSize = this->values.size() * elementSize;
+
+  ModelHeader header{};
+  std::memcpy(header.magic, modelMagic, sizeof(modelMagic));
+  header.version = modelVersion;
+  header.elementType = static_cast<uint32_t>(this->elementType);
+  header.documentSize = documentText.size();
+  header.dataOffset = alignTo64(sizeof(ModelHeader) + documentText.size());
+  header.dataSize = blockSize;
+
+  std::string padding(header.dataOffset - sizeof(ModelHeader) - documentText.size(), '\0');
+
+  // QSaveFile writes to a temporary file and renames on commit, so a crash never leaves a partial model
+  QSaveFile file(QString::fromStdString(filePath));
+  if (!file.open(QIODevice::WriteOnly)) {
+    throw std::runtime_error("Failed to open file for writing: " + filePath);
+  }
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(documentText.data(), static_cast<qint64>(documentText.size()));
+  file.write(padding.data(), static_cast<qint64>(padding.size()));
+  file.write(block, static_cast<qint64>(blockSize));
+  if (!file.commit()) {
+    throw std::runtime_error("Failed to write file: " + filePath);
+  }
+}
+
+//===================================================================================================================//
+
+const float* ModelFileWriter::tensorValues(const nlohmann::ordered_json& reference) const {
+  size_t index = reference.at("offset").get<size_t>() / PackedDataset::elementSize(this->elementType);
+  uint64_t count = 0;
+  if (!shapeCount(reference.at("shape").get<std::vector<ulong>>(), count) ||
+      index > this->values.size() || count > this->values.size() - index) {
+    throw std::runtime_error("Tensor reference out of range");
+  }
+  return this->values.data() + index;
+}
+
+//===================================================================================================================//
+
+// The digits nlohmann::json::dump() prints for a float (held there as a double), so streamed files match it byte for byte.
+char* formatFloat(float value, char* out) {
+  if (!std::isfinite(value)) {
+    std::memcpy(out, "null", 4);
+    return out + 4;
+  }
+  return nlohmann::detail::to_chars(out, out + 32, static_cast<double>(value));
+}
+
+//===================================================================================================================//
+
+namespace {
+
+// Pretty-printed JSON written to a file through a buffer, in the layout of dump(4)
+class JsonStreamWriter {
+  public:
+    JsonStreamWriter(QSaveFile& file, const std::function<const float*(const nlohmann::ordered_json&)>& tensorValues)
+        : file(file), tensorValues(tensorValues) {}
+
+    void writeNode(const nlohmann::ordered_json& node, size_t level, bool inParameters);
+    void flush();
+
+  private:
+    QSaveFile& file;
+    std::function<const float*(const nlohmann::ordered_json&)> tensorValues;
+    std::string buffer;
+
+    static constexpr size_t flushSize = 1 << 20;
+    static constexpr size_t valuesPerChunk = 1 << 16;
+
+    void append(const std::string& text);
+    void writeTensor(const float* values, const std::vector<ulong>& shape, size_t level);
+    static void formatBlock(std::string& out, const float* values, const std::vector<ulong>& shape, size_t dim,
+                            size_t level);
+};
+
+//===================================================================================================================//
+
+void JsonStreamWriter::append(const std::string& text) {
+  this->buffer += text;
+  if (this->buffer.size() >= flushSize) this->flush();
+}
+
+//===================================================================================================================//
+
+void JsonStreamWriter::flush() {
+  this->file.write(this->buffer.data(), static_cast<qint64>(this->buffer.size()));
+  this->buffer.clear();
+}
+
+//===================================================================================================================//
+
+void JsonStreamWriter::writeNode(const nlohmann::ordered_json& node, size_t level, bool inParameters) {
+  if (inParameters && ModelFile::isTensorReference(node)) {
+    this->writeTensor(this->tensorValues(node), node.at("shape").get<std::vector<ulong>>(), level);
+    return;
+  }
+
+  if (!node.is_structured()) {
+    this->append(node.dump());
+    return;
+  }
+
+  bool isObject = node.is_object();
+  if (node.empty()) {
+    this->append(isObject ? "{}" : "[]");
+    return;
+  }
+
+  std::string indent((level + 1) * 4, ' ');
+  this->append(isObject ? "{\n" : "[\n");
+
+  size_t remaining = node.size();
+  for (auto it = node.begin(); it != node.end(); ++it) {
+    this->append(indent);
+    bool childInParameters = inParameters;
+    if (isObject) {
+      this->append(nlohmann::ordered_json(it.key()).dump() + ": ");
+      if (level == 0 && it.key() == "parameters") childInParameters = true;
+    }
+    this->writeNode(*it, level + 1, childInParameters);
+    this->append(--remaining > 0 ? ",\n" : "\n");
+  }
+
+  this->append(std::string(level * 4, ' ') + (isObject ? "}" : "]"));
+}
+
+//===================================================================================================================//
+
+void JsonStreamWriter::formatBlock(std::string& out, const float* values, const std::vector<ulong>& shape,
+                                   size_t dim, size_t level) {
+  if (shape[dim] == 0) {
+    out += "[]";
+    return;
+  }
+
+  size_t inner = 1;
+  for (size_t d = dim + 1; d < shape.size(); d++) inner *= shape[d];
+
+  std::string indent((level + 1) * 4, ' ');
+  char number[32];
+  out += "[\n";
+  for (ulong i = 0; i < shape[dim]; i++) {
+    out += indent;
+    if (dim + 1 == shape.size()) {
+      out.append(number, formatFloat(values[i], number));
+    } else {
+      formatBlock(out, values + i * inner, shape, dim + 1, level + 1);
+    }
+    out += (i + 1 < shape[dim]) ? ",\n" : "\n";
+  }
+  out.append(level * 4, ' ');
+  out += ']';
+}
+
+//===================================================================================================================//
+
+void JsonStreamWriter::writeTensor(const float* values, const std::vector<ulong>& shape, size_t level) {
+  if (shape.empty() || shape[0] == 0) {
+    this->append("[]");
+    return;
+  }
+
+  // Rows of the outermost dimension are formatted in chunks of about valuesPerChunk values,
+  // a batch of chunks in parallel at a time, and written in order
+  size_t inner = 1;
+  for (size_t d = 1; d < shape.size(); d++) inner *= shape[d];
+  ulong rowsPerChunk = std::max<ulong>(1, valuesPerChunk / std::max<size_t>(inner, 1));
+  ulong numChunks = (shape[0] + rowsPerChunk - 1) / rowsPerChunk;
+  ulong chunksPerBatch = std::max(1, QThreadPool::globalInstance()->maxThreadCount()) * 4;
+
+  std::string indent((level + 1) * 4, ' ');
+  auto formatChunk = [&](ulong chunk, std::string& out) {
+    ulong rowEnd = std::min<ulong>(shape[0], (chunk + 1) * rowsPerChunk);
+    char number[32];
+    for (ulong row = chunk * rowsPerChunk; row < rowEnd; row++) {
+      out += indent;
+      if (shape.size() == 1) {
+        out.append(number, formatFloat(values[row], number));
+      } else {
+        formatBlock(out, values + row * inner, shape, 1, level + 1);
+      }
+      out += (row + 1 < shape[0]) ? ",\n" : "\n";
+    }
+  };
+
+  this->append("[\n");
+  for (ulong batchStart = 0; batchStart < numChunks; batchStart += chunksPerBatch) {
+    ulong batchSize = std::min(chunksPerBatch, numChunks - batchStart);
+    std::vector<std::string> texts(batchSize);
+    if (batchSize == 1) {
+      formatChunk(batchStart, texts[0]);
+    } else {
+      Parallel::forEach(batchSize, [&](ulong i) { formatChunk(batchStart + i, texts[i]); });
+    }
+    for (const auto& text : texts) this->append(text);
+  }
+  this->append(std::string(level * 4, ' ') + "]");
+}
+
+} // namespace
+
+//===================================================================================================================//
+
+void ModelFileWriter::writeJson(const std::string& filePath, const nlohmann::ordered_json& document) const {
+  QSaveFile file(QString::fromStdString(filePath));
+  if (!file.open(QIODevice::WriteOnly)) {
+    throw std::runtime_error("Failed to open file for writing: " + filePath);
+  }
+
+  JsonStreamWriter writer(file, [this](const nlohmann::ordered_json& reference) { return this->tensorValues(reference); });
+  writer.writeNode(document, 0, false);
+  writer.flush();
+
+  if (!file.commit()) {
+    throw std::runtime_error("Failed to write file: " + filePath);
+  }
+}
+
+//===================================================================================================================//
+
+} // namespace NN_CLI
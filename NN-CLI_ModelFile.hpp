@@ -0,0 +1,253 @@
+#ifndef NN_CLI_MODELFILE_HPP
+#define NN_CLI_MODELFILE_HPP
+
+#include "NN-CLI_PackedDataset.hpp"
+
+#include <json.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <sys/types.h>
+
+class QFile;
+
+//===================================================================================================================//
+
+namespace NN_CLI {
+
+// On-disk header of a binary model file (little-endian). Followed by the model document as compact JSON,
+// then by the parameter data block at a 64-byte aligned offset.
+struct ModelHeader {
+  char     magic[8];       // "NNCLIMD\0"
+  uint32_t version;        // Format version (currently 1)
+  uint32_t elementType;    // PackedElementType of the parameter data (FLOAT32 or FLOAT16)
+  uint64_t documentSize;   // Bytes of JSON document following the header
+  uint64_t dataOffset;     // Byte offset of the parameter data block
+  uint64_t dataSize;       // Bytes of parameter data
+};
+
+/**
+ * ModelFile: read access to a model or config file in either format.
+ *
+ * JSON files are parsed whole. Binary model files (.nnmodel) hold the same document, except that
+ * every rectangular numeric array under "parameters" is replaced by a tensor reference
+ *
+ *   {"offset": <byte offset in the data block>, "shape": [d0, d1, ...]}
+ *
+ * whose values live in the memory-mapped data block. Only the document is parsed; getTensor()
+ * copies tensor values straight out of the mapping, so loading costs little more than the copy.
+ *
+ * Opened without parameters, a model file is read as its header only: the document without
+ * "parameters". That is the header and document of a binary file, or a JSON file with the
+ * parameters value skipped by a bracket scan instead of being parsed, so metadata queries stay
+ * cheap however large the model is.
+ */
+class ModelFile {
+  public:
+    // Open a JSON or binary model file, detected by its magic bytes. Throws on I/O or format errors.
+    // With loadParameters false, "parameters" is left out of the document and getTensor() throws.
+    explicit ModelFile(const std::string& filePath, bool loadParameters = true);
+    ~ModelFile();
+
+    // Returns true if the file starts with the binary model magic.
+    static bool isModelFile(const std::string& filePath);
+
+    // Returns true for paths that should be saved as binary models (*.nnmodel).
+    static bool isBinaryModelPath(const std::string& filePath);
+
+    const std::string& getFilePath() const { return this->filePath; }
+    bool isBinary() const { return this->binary; }
+    bool hasParameters() const;
+    ulong getNumParameters() const; // Number of parameter values, loaded or not
+    PackedElementType getElementType() const { return static_cast<PackedElementType>(this->header.elementType); }
+    const nlohmann::ordered_json& getDocument() const { return this->document; }
+
+    // Read a (possibly nested) std::vector<float> from a document node: a tensor reference,
+    // a plain JSON array, or a JSON array mixing both at any level.
+    template <typename T>
+    T getTensor(const nlohmann::ordered_json& node) const;
+
+    // The document with every tensor reference expanded back into JSON arrays.
+    nlohmann::ordered_json toJson() const;
+
+    // Rewrite a model file as a binary model (parameters stored as elementType) or as pretty-printed JSON.
+    static void convert(const std::string& inputPath, const std::string& outputPath, bool binary,
+                        PackedElementType elementType = PackedElementType::FLOAT32);
+
+    // Write a document as pretty-printed JSON. The file is replaced atomically.
+    static void writeJson(const std::string& filePath, const nlohmann::ordered_json& document);
+
+    static bool isTensorReference(const nlohmann::ordered_json& node);
+
+  private:
+    std::string filePath;
+    std::unique_ptr<QFile> file;
+    bool binary = false;
+    const unsigned char* data = nullptr; // Mapping of a binary file; null when parameters are not loaded
+    bool parametersSkipped = false;      // JSON "parameters" value skipped while reading the header
+    ulong skippedParameters = 0;         // Numbers counted in the skipped value
+    ModelHeader header{};
+    nlohmann::ordered_json document;
+
+    // Values of a tensor reference as floats: a pointer into the mapping for float32 data,
+    // or into `scratch` after decoding fp16. Sets `shape`.
+    const float* tensorValues(const nlohmann::ordered_json& reference, std::vector<ulong>& shape,
+                              std::vector<float>& scratch) const;
+
+    nlohmann::ordered_json expand(const nlohmann::ordered_json& node) const;
+    ulong countParameters(const nlohmann::ordered_json& node) const;
+    void parseHeader(const char* text, const char* end);
+
+    template <typename T>
+    static T reshape(const float*& values, const std::vector<ulong>& shape, size_t dim);
+};
+
+/**
+ * ModelFileWriter: builds a binary or JSON model file.
+ *
+ * Tensors are appended with addTensor(), which returns the reference (or array of references, for
+ * jagged tensors) to store in the document in their place; write() then saves the document and the
+ * data block, each tensor starting on a 64-byte boundary, and writeJson() saves the same model as a
+ * JSON file without building the parameters as a JSON tree.
+ */
+class ModelFileWriter {
+  public:
+    explicit ModelFileWriter(PackedElementType elementType = PackedElementType::FLOAT32);
+
+    // Append a (possibly nested) std::vector<float>.
+    template <typename T>
+    nlohmann::ordered_json addTensor(const T& tensor);
+
+    // Append the numeric arrays of a JSON node, returning the node with each one replaced by a reference.
+    nlohmann::ordered_json addTensors(const nlohmann::ordered_json& node);
+
+    // Write header, document and data block. The file is replaced atomically.
+    void write(const std::string& filePath, const nlohmann::ordered_json& document) const;
+
+    // Write the document as JSON instead, laid out as dump(4) with every tensor reference expanded
+    // back into arrays. Tensors are formatted straight from the data block (large ones in parallel)
+    // and streamed to the file, each value printed as json.dump() prints it, so the bytes match dump(4).
+    // The file is replaced atomically.
+    void writeJson(const std::string& filePath, const nlohmann::ordered_json& document) const;
+
+  private:
+    PackedElementType elementType;
+    std::vector<float> values; // Data block contents before encoding, tensors padded to 64 bytes
+
+    nlohmann::ordered_json beginTensor(const std::vector<ulong>& shape);
+    const float* tensorValues(const nlohmann::ordered_json& reference) const;
+
+    template <typename T>
+    static bool tensorShape(const T& tensor, std::vector<ulong>& shape, size_t dim);
+    template <typename T>
+    void appendValues(const T& tensor);
+};
+
+// Write a float exactly as nlohmann::json::dump() does (shortest round-trip digits of the value as a double)
+// to out (at least 32 chars). Returns the end of the text. Non-finite values are written as null.
+char* formatFloat(float value, char* out);
+
+//===================================================================================================================//
+//-- Template implementations --//
+//===================================================================================================================//
+
+template <typename T>
+struct IsFloatVector : std::is_same<T, std::vector<float>> {};
+
+//===================================================================================================================//
+
+template <typename T>
+T ModelFile::getTensor(const nlohmann::ordered_json& node) const {
+  if (isTensorReference(node)) {
+    std::vector<ulong> shape;
+    std::vector<float> scratch;
+    const float* values = this->tensorValues(node, shape, scratch);
+    return reshape<T>(values, shape, 0);
+  }
+
+  if constexpr (IsFloatVector<T>::value) {
+    return node.get<T>();
+  } else {
+    T result;
+    result.reserve(node.size());
+    for (const auto& element : node) result.push_back(this->getTensor<typename T::value_type>(element));
+    return result;
+  }
+}
+
+//===================================================================================================================//
+
+template <typename T>
+T ModelFile::reshape(const float*& values, const std::vector<ulong>& shape, size_t dim) {
+  if (dim >= shape.size()) {
+    throw std::runtime_error("Tensor reference has too few dimensions");
+  }
+
+  T result(shape[dim]);
+  if constexpr (IsFloatVector<T>::value) {
+    if (dim + 1 != shape.size()) throw std::runtime_error("Tensor reference has too many dimensions");
+    std::copy(values, values + shape[dim], result.begin());
+    values += shape[dim];
+  } else {
+    for (auto& element : result) element = reshape<typename T::value_type>(values, shape, dim + 1);
+  }
+  return result;
+}
+
+//===================================================================================================================//
+
+template <typename T>
+bool ModelFileWriter::tensorShape(const T& tensor, std::vector<ulong>& shape, size_t dim) {
+  if (dim == shape.size()) shape.push_back(tensor.size());
+  else if (shape[dim] != tensor.size()) return false;
+
+  if constexpr (!IsFloatVector<T>::value) {
+    for (const auto& element : tensor) {
+      if (!tensorShape(element, shape, dim + 1)) return false;
+    }
+    // Inner dimensions of an empty tensor are unknown; record them as zero
+    if (tensor.empty()) tensorShape(typename T::value_type{}, shape, dim + 1);
+  }
+  return true;
+}
+
+//===================================================================================================================//
+
+template <typename T>
+void ModelFileWriter::appendValues(const T& tensor) {
+  if constexpr (IsFloatVector<T>::value) {
+    this->values.insert(this->values.end(), tensor.begin(), tensor.end());
+  } else {
+    for (const auto& element : tensor) this->appendValues(element);
+  }
+}
+
+//===================================================================================================================//
+
+template <typename T>
+nlohmann::ordered_json ModelFileWriter::addTensor(const T& tensor) {
+  std::vector<ulong> shape;
+  if (tensorShape(tensor, shape, 0)) {
+    nlohmann::ordered_json reference = this->beginTensor(shape);
+    this->appendValues(tensor);
+    return reference;
+  }
+
+  // Jagged (e.g. per-layer weight matrices of different sizes): one reference per element
+  nlohmann::ordered_json references = nlohmann::ordered_json::array();
+  if constexpr (!IsFloatVector<T>::value) {
+    for (const auto& element : tensor) references.push_back(this->addTensor(element));
+  }
+  return references;
+}
+
+} // namespace NN_CLI
+
+//===================================================================================================================//
+
+#endif // NN_CLI_MODELFILE_HPP
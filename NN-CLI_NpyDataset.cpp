@@ -0,0 +1,259 @@
+#include "NN-CLI_NpyDataset.hpp"
+#include "NN-CLI_PackedDataset.hpp"
+
+#include <QFile>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace NN_CLI {
+
+//===================================================================================================================//
+
+static const char npyMagic[6] = {'\x93', 'N', 'U', 'M', 'P', 'Y'};
+
+//===================================================================================================================//
+
+// Value of `key` in the header dict text, starting just after its ':' (e.g. " '<f4', 'fortran_order': ...").
+static std::string headerField(const std::string& header, const std::string& key, const std::string& path) {
+  size_t pos = header.find("'" + key + "'");
+  if (pos == std::string::npos) {
+    throw std::runtime_error("Missing '" + key + "' in .npy header: " + path);
+  }
+  pos = header.find(':', pos);
+  if (pos == std::string::npos) {
+    throw std::runtime_error("Malformed .npy header: " + path);
+  }
+  return header.substr(pos + 1);
+}
+
+//===================================================================================================================//
+
+// Parse the header dict of a mapped .npy file: {'descr': '<f4', 'fortran_order': False, 'shape': (N, D), }
+static void parseHeader(NpyDataset::Array& array, const std::string& header, const std::string& path) {
+  std::string descrField = headerField(header, "descr", path);
+  size_t open = descrField.find('\'');
+  size_t close = (open == std::string::npos) ? open : descrField.find('\'', open + 1);
+  if (close == std::string::npos || close - open < 4) {
+    throw std::runtime_error("Unsupported .npy dtype (structured arrays are not supported): " + path);
+  }
+  std::string descr = descrField.substr(open + 1, close - open - 1);
+
+  char byteOrder = descr[0];
+  array.kind = descr[1];
+  array.itemSize = static_cast<size_t>(std::atoi(descr.c_str() + 2));
+
+  bool supported = (array.kind == 'f' && (array.itemSize == 4 || array.itemSize == 8)) ||
+                   ((array.kind == 'i' || array.kind == 'u') &&
+                    (array.itemSize == 1 || array.itemSize == 2 || array.itemSize == 4 || array.itemSize == 8)) ||
+                   (array.kind == 'b' && array.itemSize == 1);
+  if (!supported) {
+    throw std::runtime_error("Unsupported .npy dtype '" + descr + "': " + path);
+  }
+  if (byteOrder == '>' && array.itemSize > 1) {
+    throw std::runtime_error("Big-endian .npy arrays are not supported: " + path);
+  }
+
+  std::string shapeField = headerField(header, "shape", path);
+  size_t shapeOpen = shapeField.find('(');
+  size_t shapeClose = shapeField.find(')');
+  if (shapeOpen == std::string::npos || shapeClose == std::string::npos || shapeClose < shapeOpen) {
+    throw std::runtime_error("Malformed .npy shape: " + path);
+  }
+
+  array.shape.clear();
+  const char* cursor = shapeField.c_str() + shapeOpen + 1;
+  const char* shapeEnd = shapeField.c_str() + shapeClose;
+  while (cursor < shapeEnd) {
+    char* next = nullptr;
+    unsigned long long dim = std::strtoull(cursor, &next, 10);
+    if (next == cursor) {
+      cursor++; // separator or whitespace
+      continue;
+    }
+    array.shape.push_back(static_cast<ulong>(dim));
+    cursor = next;
+  }
+
+  if (array.shape.empty()) {
+    throw std::runtime_error(".npy array must have at least one dimension: " + path);
+  }
+
+  std::string orderField = headerField(header, "fortran_order", path);
+  size_t orderStart = orderField.find_first_not_of(' ');
+  bool fortranOrder = orderStart != std::string::npos && orderField.compare(orderStart, 4, "True") == 0;
+  if (fortranOrder && array.shape.size() > 1) {
+    throw std::runtime_error("Fortran-ordered .npy arrays are not supported (save with C order): " + path);
+  }
+
+  array.rows = array.shape[0];
+  array.rowSize = 1;
+  for (size_t d = 1; d < array.shape.size(); d++) array.rowSize *= array.shape[d];
+}
+
+//===================================================================================================================//
+
+static void mapArray(NpyDataset::Array& array, const std::string& path, const std::string& description) {
+  array.file = std::make_unique<QFile>(QString::fromStdString(path));
+  if (!array.file->open(QIODevice::ReadOnly)) {
+    throw std::runtime_error("Failed to open .npy " + description + " file: " + path);
+  }
+
+  qint64 fileSize = array.file->size();
+  if (fileSize < 10) {
+    throw std::runtime_error("Not a .npy file (bad magic): " + path);
+  }
+
+  const unsigned char* mapped = array.file->map(0, fileSize);
+  if (!mapped) {
+    throw std::runtime_error("Failed to memory-map .npy " + description + " file: " + path);
+  }
+  if (std::memcmp(mapped, npyMagic, sizeof(npyMagic)) != 0) {
+    throw std::runtime_error("Not a .npy file (bad magic): " + path);
+  }
+
+  // Version 1.x has a 2-byte header length, 2.x/3.x a 4-byte one (both little-endian)
+  uint8_t major = mapped[6];
+  uint64_t headerStart = (major == 1) ? 10 : 12;
+  if (major < 1 || major > 3 || static_cast<uint64_t>(fileSize) < headerStart) {
+    throw std::runtime_error("Unsupported .npy version " + std::to_string(major) + ": " + path);
+  }
+  uint64_t headerLength = (major == 1)
+      ? (static_cast<uint64_t>(mapped[8]) | static_cast<uint64_t>(mapped[9]) << 8)
+      : (static_cast<uint64_t>(mapped[8]) | static_cast<uint64_t>(mapped[9]) << 8 |
+         static_cast<uint64_t>(mapped[10]) << 16 | static_cast<uint64_t>(mapped[11]) << 24);
+  if (headerStart + headerLength > static_cast<uint64_t>(fileSize)) {
+    throw std::runtime_error(".npy file is truncated: " + path);
+  }
+
+  parseHeader(array, std::string(reinterpret_cast<const char*>(mapped) + headerStart, headerLength), path);
+
+  array.data = mapped + headerStart + headerLength;
+  uint64_t dataBytes = static_cast<uint64_t>(array.rows) * array.rowSize * array.itemSize;
+  if (headerStart + headerLength + dataBytes > static_cast<uint64_t>(fileSize)) {
+    throw std::runtime_error(".npy file is truncated: " + path);
+  }
+}
+
+//===================================================================================================================//
+
+// Element `i` of a little-endian array of the given integer width, widened to int64.
+static int64_t integerAt(const unsigned char* src, char kind, size_t itemSize, size_t i) {
+  src += i * itemSize;
+  switch (itemSize) {
+    case 1: return (kind == 'i') ? static_cast<int64_t>(static_cast<int8_t>(*src)) : static_cast<int64_t>(*src);
+    case 2: {
+      uint16_t v; std::memcpy(&v, src, 2);
+      return (kind == 'i') ? static_cast<int64_t>(static_cast<int16_t>(v)) : static_cast<int64_t>(v);
+    }
+    case 4: {
+      uint32_t v; std::memcpy(&v, src, 4);
+      return (kind == 'i') ? static_cast<int64_t>(static_cast<int32_t>(v)) : static_cast<int64_t>(v);
+    }
+    default: {
+      int64_t v; std::memcpy(&v, src, 8);
+      return v;
+    }
+  }
+}
+
+//===================================================================================================================//
+
+// Convert one row to float. uint8 rows are normalised to [0, 1] when normaliseBytes is set.
+static void readRow(const NpyDataset::Array& array, ulong row, float* dst, bool normaliseBytes) {
+  const unsigned char* src = array.data + static_cast<size_t>(row) * array.rowSize * array.itemSize;
+
+  if (array.kind == 'f' && array.itemSize == 4) {
+    std::memcpy(dst, src, array.rowSize * sizeof(float));
+  } else if (array.kind == 'f') {
+    for (ulong i = 0; i < array.rowSize; i++) {
+      double v;
+      std::memcpy(&v, src + i * 8, 8);
+      dst[i] = static_cast<float>(v);
+    }
+  } else if (array.kind == 'u' && array.itemSize == 1 && normaliseBytes) {
+    PackedDataset::decode(src, PackedElementType::UINT8, array.rowSize, dst);
+  } else {
+    for (ulong i = 0; i < array.rowSize; i++) {
+      dst[i] = static_cast<float>(integerAt(src, array.kind, array.itemSize, i));
+    }
+  }
+}
+
+//===================================================================================================================//
+
+NpyDataset::NpyDataset() = default;
+
+NpyDataset::~NpyDataset() = default;
+
+//===================================================================================================================//
+
+bool NpyDataset::isNpyFile(const std::string& filePath) {
+  QFile file(QString::fromStdString(filePath));
+  if (!file.open(QIODevice::ReadOnly)) return false;
+
+  char magic[sizeof(npyMagic)];
+  if (file.read(magic, sizeof(magic)) != static_cast<qint64>(sizeof(magic))) return false;
+
+  return std::memcmp(magic, npyMagic, sizeof(npyMagic)) == 0;
+}
+
+//===================================================================================================================//
+
+void NpyDataset::open(const std::string& inputsPath, const std::string& outputsPath) {
+  mapArray(this->inputs, inputsPath, "inputs");
+
+  this->outputs = Array();
+  this->labels = false;
+  this->numClasses = 0;
+  if (outputsPath.empty()) return;
+
+  mapArray(this->outputs, outputsPath, "outputs");
+
+  if (this->outputs.rows != this->inputs.rows) {
+    throw std::runtime_error("NumPy inputs and outputs row count mismatch (" + std::to_string(this->inputs.rows) +
+                             " vs " + std::to_string(this->outputs.rows) + ")");
+  }
+
+  // A 1-D integer array holds class labels: determine the number of classes for one-hot encoding
+  this->labels = (this->outputs.shape.size() == 1 && this->outputs.kind != 'f');
+  if (this->labels) {
+    int64_t maxLabel = 0;
+    for (ulong i = 0; i < this->outputs.rows; i++) {
+      int64_t label = integerAt(this->outputs.data, this->outputs.kind, this->outputs.itemSize, i);
+      if (label < 0) {
+        throw std::runtime_error("Negative class label " + std::to_string(label) + " at row " + std::to_string(i) +
+                                 " in: " + outputsPath);
+      }
+      maxLabel = std::max(maxLabel, label);
+    }
+    this->numClasses = static_cast<ulong>(maxLabel) + 1;
+  }
+}
+
+//===================================================================================================================//
+
+void NpyDataset::readInput(ulong index, float* dst) const {
+  readRow(this->inputs, index, dst, true);
+}
+
+//===================================================================================================================//
+
+void NpyDataset::readOutput(ulong index, float* dst) const {
+  if (!this->outputs.data) return; // inputs only
+
+  if (!this->labels) {
+    readRow(this->outputs, index, dst, false);
+    return;
+  }
+
+  std::fill(dst, dst + this->numClasses, 0.0f);
+  dst[integerAt(this->outputs.data, this->outputs.kind, this->outputs.itemSize, index)] = 1.0f;
+}
+
+//===================================================================================================================//
+
+} // namespace NN_CLI
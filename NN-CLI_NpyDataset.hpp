@@ -0,0 +1,68 @@
+#ifndef NN_CLI_NPYDATASET_HPP
+#define NN_CLI_NPYDATASET_HPP
+
+#include "NN-CLI_MappedDataset.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class QFile;
+
+//===================================================================================================================//
+
+namespace NN_CLI {
+
+/**
+ * NpyDataset: memory-mapped NumPy .npy inputs and (optionally) outputs.
+ *
+ * The inputs file holds one sample per row: shape (N, ...) with every trailing dimension
+ * flattened into the record. Supported element types are little-endian float32/float64 and
+ * integers; uint8 inputs are normalised to [0, 1] like IDX images, other types are cast.
+ * float32 rows are copied straight out of the mapping — nothing is parsed per sample.
+ *
+ * The outputs file is either a 1-D integer array of class labels (expanded to one-hot
+ * vectors of numClasses() = max label + 1) or an (N, ...) numeric array used as-is.
+ * Without an outputs file, outputSize() is 0 (predict inputs).
+ */
+class NpyDataset : public MappedDataset {
+  public:
+    NpyDataset();
+    ~NpyDataset() override;
+
+    // Returns true if the file starts with the .npy magic.
+    static bool isNpyFile(const std::string& filePath);
+
+    // Map and validate the arrays. outputsPath may be empty. Throws on I/O errors or unsupported layouts.
+    void open(const std::string& inputsPath, const std::string& outputsPath = "");
+
+    ulong numSamples() const override { return this->inputs.rows; }
+    ulong inputSize() const override { return this->inputs.rowSize; }
+    ulong outputSize() const override { return this->labels ? this->numClasses : this->outputs.rowSize; }
+
+    void readInput(ulong index, float* dst) const override;
+    void readOutput(ulong index, float* dst) const override;
+
+    // One mapped .npy array, viewed as `rows` records of `rowSize` elements.
+    struct Array {
+      std::unique_ptr<QFile> file;
+      const unsigned char* data = nullptr;
+      char kind = 'f';        // NumPy type kind: 'f' float, 'i' signed, 'u' unsigned, 'b' bool
+      size_t itemSize = 4;    // Bytes per element
+      std::vector<ulong> shape;
+      ulong rows = 0;
+      ulong rowSize = 0;
+    };
+
+  private:
+    Array inputs;
+    Array outputs;
+    bool labels = false;      // outputs is a 1-D integer label array
+    ulong numClasses = 0;
+};
+
+} // namespace NN_CLI
+
+//===================================================================================================================//
+
+#endif // NN_CLI_NPYDATASET_HPP
@@ -0,0 +1,335 @@
+#include "NN-CLI_PackedDataset.hpp"
+
+#include <QFile>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+namespace NN_CLI {
+
+//===================================================================================================================//
+
+static const char packedMagic[8] = {'N', 'N', 'C', 'L', 'I', 'P', 'K', '\0'};
+static const uint32_t packedVersion = 1;
+
+static uint64_t alignTo64(uint64_t offset) {
+  return (offset + 63) & ~static_cast<uint64_t>(63);
+}
+
+// Size of a section of numSamples records of recordSize elements. False if it does not fit in 64 bits.
+static bool sectionBytes(uint64_t numSamples, uint64_t recordSize, size_t elementBytes, uint64_t& bytes) {
+  bytes = 0;
+  if (numSamples == 0 || recordSize == 0) return true;
+  if (recordSize > UINT64_MAX / elementBytes) return false;
+  uint64_t recordBytes = recordSize * elementBytes;
+  if (numSamples > UINT64_MAX / recordBytes) return false;
+  bytes = numSamples * recordBytes;
+  return true;
+}
+
+//===================================================================================================================//
+
+// IEEE 754 binary32 -> binary16, round to nearest even. Overflow becomes infinity; NaN stays NaN.
+static uint16_t floatToHalf(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+  uint32_t magnitude = bits & 0x7FFFFFFF;
+
+  if (magnitude >= 0x7F800000) {
+    return sign | 0x7C00 | (magnitude > 0x7F800000 ? 0x0200 : 0);
+  }
+  if (magnitude >= 0x477FF000) {
+    return sign | 0x7C00; // >= 65520 rounds past the largest half (65504)
+  }
+  if (magnitude < 0x38800000) {
+    // Half subnormal or zero: the value in units of 2^-24, rounded to nearest even
+    float scaled;
+    std::memcpy(&scaled, &magnitude, sizeof(scaled));
+    return sign | static_cast<uint16_t>(std::nearbyint(scaled * 16777216.0f));
+  }
+
+  uint32_t half = ((magnitude >> 23) - 127 + 15) << 10 | ((magnitude >> 13) & 0x3FF);
+  uint32_t rest = magnitude & 0x1FFF;
+  if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) half++;
+  return sign | static_cast<uint16_t>(half);
+}
+
+//===================================================================================================================//
+
+// IEEE 754 binary16 -> binary32 (exact).
+static float halfToFloat(uint16_t half) {
+  uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+  uint32_t exponent = (half >> 10) & 0x1F;
+  uint32_t mantissa = half & 0x3FF;
+
+  if (exponent == 0) {
+    float value = static_cast<float>(mantissa) / 16777216.0f;
+    return sign ? -value : value;
+  }
+
+  uint32_t bits = (exponent == 0x1F) ? (sign | 0x7F800000 | (mantissa << 13))
+                                     : (sign | ((exponent - 15 + 127) << 23) | (mantissa << 13));
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+//===================================================================================================================//
+//-- PackedDataset --//
+//===================================================================================================================//
+
+PackedDataset::PackedDataset() = default;
+
+PackedDataset::~PackedDataset() = default;
+
+//===================================================================================================================//
+
+bool PackedDataset::isPackedFile(const std::string& filePath) {
+  QFile file(QString::fromStdString(filePath));
+  if (!file.open(QIODevice::ReadOnly)) return false;
+
+  char magic[sizeof(packedMagic)];
+  if (file.read(magic, sizeof(magic)) != static_cast<qint64>(sizeof(magic))) return false;
+
+  return std::memcmp(magic, packedMagic, sizeof(packedMagic)) == 0;
+}
+
+//===================================================================================================================//
+
+void PackedDataset::open(const std::string& filePath) {
+  this->file = std::make_unique<QFile>(QString::fromStdString(filePath));
+
+  if (!this->file->open(QIODevice::ReadOnly)) {
+    throw std::runtime_error("Failed to open packed dataset: " + filePath);
+  }
+
+  qint64 fileSize = this->file->size();
+  if (fileSize < static_cast<qint64>(sizeof(PackedHeader))) {
+    throw std::runtime_error("Packed dataset is truncated: " + filePath);
+  }
+
+  this->data = this->file->map(0, fileSize);
+  if (!this->data) {
+    throw std::runtime_error("Failed to memory-map packed dataset: " + filePath);
+  }
+
+  std::memcpy(&this->header, this->data, sizeof(PackedHeader));
+
+  if (std::memcmp(this->header.magic, packedMagic, sizeof(packedMagic)) != 0) {
+    throw std::runtime_error("Not a packed dataset (bad magic): " + filePath);
+  }
+  if (this->header.version != packedVersion) {
+    throw std::runtime_error("Unsupported packed dataset version " + std::to_string(this->header.version) +
+                             ": " + filePath);
+  }
+  if (this->header.inputType > static_cast<uint32_t>(PackedElementType::FLOAT16) ||
+      this->header.outputType > static_cast<uint32_t>(PackedElementType::FLOAT16)) {
+    throw std::runtime_error("Unknown element type in packed dataset: " + filePath);
+  }
+
+  // Header fields come from the file: a corrupt sample count or record size must not wrap the size checks
+  uint64_t inputBytes = 0, outputBytes = 0;
+  if (!sectionBytes(this->header.numSamples, this->header.inputSize,
+                    elementSize(static_cast<PackedElementType>(this->header.inputType)), inputBytes) ||
+      !sectionBytes(this->header.numSamples, this->header.outputSize,
+                    elementSize(static_cast<PackedElementType>(this->header.outputType)), outputBytes)) {
+    throw std::runtime_error("Packed dataset header is corrupt (sizes overflow): " + filePath);
+  }
+
+  uint64_t size = static_cast<uint64_t>(fileSize);
+  if (this->header.inputOffset > size || inputBytes > size - this->header.inputOffset ||
+      this->header.outputOffset > size || outputBytes > size - this->header.outputOffset) {
+    throw std::runtime_error("Packed dataset is truncated: " + filePath);
+  }
+}
+
+//===================================================================================================================//
+
+void PackedDataset::readInput(ulong index, float* dst) const {
+  PackedElementType type = static_cast<PackedElementType>(this->header.inputType);
+  size_t recordBytes = this->header.inputSize * elementSize(type);
+  decode(this->data + this->header.inputOffset + index * recordBytes, type, this->header.inputSize, dst);
+}
+
+//===================================================================================================================//
+
+void PackedDataset::readOutput(ulong index, float* dst) const {
+  PackedElementType type = static_cast<PackedElementType>(this->header.outputType);
+  size_t recordBytes = this->header.outputSize * elementSize(type);
+  decode(this->data + this->header.outputOffset + index * recordBytes, type, this->header.outputSize, dst);
+}
+
+//===================================================================================================================//
+//-- Element conversion --//
+//===================================================================================================================//
+
+size_t PackedDataset::elementSize(PackedElementType type) {
+  switch (type) {
+    case PackedElementType::FLOAT32: return sizeof(float);
+    case PackedElementType::UINT8:   return sizeof(uint8_t);
+    case PackedElementType::FLOAT16: return sizeof(uint16_t);
+  }
+  return sizeof(float);
+}
+
+//===================================================================================================================//
+
+void PackedDataset::decode(const unsigned char* src, PackedElementType type, size_t count, float* dst) {
+  switch (type) {
+    case PackedElementType::FLOAT32:
+      // Records are not guaranteed to be float-aligned, so copy rather than cast.
+      std::memcpy(dst, src, count * sizeof(float));
+      break;
+    case PackedElementType::UINT8:
+      // Same arithmetic as ImageLoader::loadImage, so decoded values are bit-identical.
+      for (size_t i = 0; i < count; i++) dst[i] = static_cast<float>(src[i]) / 255.0f;
+      break;
+    case PackedElementType::FLOAT16:
+      for (size_t i = 0; i < count; i++) {
+        uint16_t half;
+        std::memcpy(&half, src + i * sizeof(uint16_t), sizeof(uint16_t));
+        dst[i] = halfToFloat(half);
+      }
+      break;
+  }
+}
+
+//===================================================================================================================//
+
+void PackedDataset::encode(const float* src, PackedElementType type, size_t count, unsigned char* dst) {
+  switch (type) {
+    case PackedElementType::FLOAT32:
+      std::memcpy(dst, src, count * sizeof(float));
+      break;
+    case PackedElementType::UINT8:
+      for (size_t i = 0; i < count; i++) {
+        float v = std::clamp(src[i], 0.0f, 1.0f);
+        dst[i] = static_cast<unsigned char>(std::lround(v * 255.0f));
+      }
+      break;
+    case PackedElementType::FLOAT16:
+      for (size_t i = 0; i < count; i++) {
+        uint16_t half = floatToHalf(src[i]);
+        std::memcpy(dst + i * sizeof(uint16_t), &half, sizeof(uint16_t));
+      }
+      break;
+  }
+}
+
+//===================================================================================================================//
+//-- PackedDatasetWriter --//
+//===================================================================================================================//
+
+PackedDatasetWriter::PackedDatasetWriter(const std::string& filePath, ulong numSamples,
+                                         ulong inputSize, PackedElementType inputType,
+                                         ulong outputSize, PackedElementType outputType,
+                                         int inputC, int inputH, int inputW,
+                                         int outputC, int outputH, int outputW)
+    : filePath(filePath) {
+  std::memcpy(this->header.magic, packedMagic, sizeof(packedMagic));
+  this->header.version = packedVersion;
+  this->header.inputType = static_cast<uint32_t>(inputType);
+  this->header.outputType = static_cast<uint32_t>(outputType);
+  this->header.numSamples = numSamples;
+  this->header.inputSize = inputSize;
+  this->header.outputSize = outputSize;
+  this->header.inputC = static_cast<uint32_t>(inputC);
+  this->header.inputH = static_cast<uint32_t>(inputH);
+  this->header.inputW = static_cast<uint32_t>(inputW);
+  this->header.outputC = static_cast<uint32_t>(outputC);
+  this->header.outputH = static_cast<uint32_t>(outputH);
+  this->header.outputW = static_cast<uint32_t>(outputW);
+
+  uint64_t inputBytes = 0, outputBytes = 0;
+  if (!sectionBytes(numSamples, inputSize, PackedDataset::elementSize(inputType), inputBytes) ||
+      !sectionBytes(numSamples, outputSize, PackedDataset::elementSize(outputType), outputBytes)) {
+    throw std::runtime_error("Packed dataset is too large: " + filePath);
+  }
+  this->header.inputOffset = alignTo64(sizeof(PackedHeader));
+  this->header.outputOffset = alignTo64(this->header.inputOffset + inputBytes);
+  uint64_t totalBytes = this->header.outputOffset + outputBytes;
+
+  // Records go to a temporary file whose header stays zeroed until finish(), so an aborted pack
+  // never leaves behind something that opens as a dataset
+  this->file = std::make_unique<QFile>(QString::fromStdString(this->temporaryPath()));
+  if (!this->file->open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+    throw std::runtime_error("Failed to open packed dataset for writing: " + this->temporaryPath());
+  }
+  if (!this->file->resize(static_cast<qint64>(totalBytes))) {
+    this->discard();
+    throw std::runtime_error("Failed to allocate packed dataset: " + filePath);
+  }
+
+  this->data = this->file->map(0, static_cast<qint64>(totalBytes));
+  if (!this->data) {
+    this->discard();
+    throw std::runtime_error("Failed to memory-map packed dataset for writing: " + filePath);
+  }
+}
+
+//===================================================================================================================//
+
+PackedDatasetWriter::~PackedDatasetWriter() {
+  this->discard();
+}
+
+//===================================================================================================================//
+
+void PackedDatasetWriter::writeSample(ulong index, const float* input, const float* output) {
+  if (index >= this->header.numSamples) {
+    throw std::runtime_error("Packed sample index out of range: " + std::to_string(index));
+  }
+
+  PackedElementType inputType = static_cast<PackedElementType>(this->header.inputType);
+  PackedElementType outputType = static_cast<PackedElementType>(this->header.outputType);
+  size_t inputRecord = this->header.inputSize * PackedDataset::elementSize(inputType);
+  size_t outputRecord = this->header.outputSize * PackedDataset::elementSize(outputType);
+
+  PackedDataset::encode(input, inputType, this->header.inputSize,
+                        this->data + this->header.inputOffset + index * inputRecord);
+  PackedDataset::encode(output, outputType, this->header.outputSize,
+                        this->data + this->header.outputOffset + index * outputRecord);
+}
+
+//===================================================================================================================//
+
+void PackedDatasetWriter::finish() {
+  if (!this->file) return;
+
+  // The header, magic included, is the last thing written
+  std::memcpy(this->data, &this->header, sizeof(PackedHeader));
+  this->file->unmap(this->data);
+  this->data = nullptr;
+  this->file->close();
+  this->file.reset();
+
+  // rename() replaces an existing dataset atomically: readers see the old file or the new one, never neither
+  if (std::rename(this->temporaryPath().c_str(), this->filePath.c_str()) != 0) {
+    QFile::remove(QString::fromStdString(this->temporaryPath()));
+    throw std::runtime_error("Failed to save packed dataset: " + this->filePath);
+  }
+}
+
+//===================================================================================================================//
+
+void PackedDatasetWriter::discard() {
+  if (!this->file) return;
+
+  if (this->data) {
+    this->file->unmap(this->data);
+    this->data = nullptr;
+  }
+
+  this->file->close();
+  this->file.reset();
+  QFile::remove(QString::fromStdString(this->temporaryPath()));
+}
+
+//===================================================================================================================//
+
+} // namespace NN_CLI
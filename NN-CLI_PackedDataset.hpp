@@ -0,0 +1,117 @@
+#ifndef NN_CLI_PACKEDDATASET_HPP
+#define NN_CLI_PACKEDDATASET_HPP
+
+#include "NN-CLI_MappedDataset.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+class QFile;
+
+//===================================================================================================================//
+
+namespace NN_CLI {
+
+// Element encoding of a tensor block inside a packed dataset.
+// UINT8 stores values quantised to [0, 255] and is decoded as value / 255 (lossless for 8-bit image data).
+// FLOAT16 stores IEEE half-precision values (round to nearest even), for non-image vectors.
+enum class PackedElementType : uint32_t { FLOAT32 = 0, UINT8 = 1, FLOAT16 = 2 };
+
+// On-disk header (little-endian). Followed by the inputs block and then the outputs block,
+// each one a contiguous array of fixed-size per-sample records starting at a 64-byte aligned offset.
+struct PackedHeader {
+  char     magic[8];       // "NNCLIPK\0"
+  uint32_t version;        // Format version (currently 1)
+  uint32_t inputType;      // PackedElementType of the inputs block
+  uint32_t outputType;     // PackedElementType of the outputs block
+  uint32_t reserved;
+  uint64_t numSamples;
+  uint64_t inputSize;      // Elements per input record
+  uint64_t outputSize;     // Elements per output record
+  uint32_t inputC, inputH, inputW;     // Input tensor shape (0 when not an image)
+  uint32_t outputC, outputH, outputW;  // Output tensor shape (0 when not an image)
+  uint64_t inputOffset;    // Byte offset of the inputs block
+  uint64_t outputOffset;   // Byte offset of the outputs block
+};
+
+/**
+ * PackedDataset: read-only view over a packed binary sample file.
+ *
+ * The file is memory-mapped on open(), so reading a sample is a pointer offset plus
+ * an element conversion to float — no parsing or image decoding happens per epoch.
+ * Safe to read concurrently from multiple threads.
+ */
+class PackedDataset : public MappedDataset {
+  public:
+    PackedDataset();
+    ~PackedDataset() override;
+
+    // Returns true if the file starts with the packed dataset magic.
+    static bool isPackedFile(const std::string& filePath);
+
+    // Map a packed dataset file. Throws on I/O errors or malformed headers.
+    void open(const std::string& filePath);
+
+    ulong numSamples() const override { return this->header.numSamples; }
+    ulong inputSize() const override { return this->header.inputSize; }
+    ulong outputSize() const override { return this->header.outputSize; }
+    const PackedHeader& getHeader() const { return this->header; }
+
+    void readInput(ulong index, float* dst) const override;
+    void readOutput(ulong index, float* dst) const override;
+
+    //-- Element conversion helpers (shared with the writer) --//
+    static size_t elementSize(PackedElementType type);
+    static void decode(const unsigned char* src, PackedElementType type, size_t count, float* dst);
+    static void encode(const float* src, PackedElementType type, size_t count, unsigned char* dst);
+
+  private:
+    std::unique_ptr<QFile> file;
+    const unsigned char* data = nullptr;
+    PackedHeader header{};
+};
+
+/**
+ * PackedDatasetWriter: creates a packed dataset file of a known sample count.
+ *
+ * The file is pre-sized and mapped read-write, so writeSample() may be called
+ * concurrently from several threads as long as each thread writes distinct indices.
+ * Samples are written to "<filePath>.tmp", which finish() completes and renames into place;
+ * a writer destroyed before finish() removes it, leaving no partial dataset behind.
+ */
+class PackedDatasetWriter {
+  public:
+    PackedDatasetWriter(const std::string& filePath, ulong numSamples,
+                        ulong inputSize, PackedElementType inputType,
+                        ulong outputSize, PackedElementType outputType,
+                        int inputC = 0, int inputH = 0, int inputW = 0,
+                        int outputC = 0, int outputH = 0, int outputW = 0);
+    ~PackedDatasetWriter();
+
+    void writeSample(ulong index, const float* input, const float* output);
+
+    // Write the header, unmap and rename the file to filePath, atomically replacing any file there.
+    // Throws if the rename fails.
+    void finish();
+
+  private:
+    std::string filePath;
+    std::unique_ptr<QFile> file;
+    unsigned char* data = nullptr;
+    PackedHeader header{};
+
+    std::string temporaryPath() const { return this->filePath + ".tmp"; }
+
+    // Unmap and delete the temporary file without publishing it.
+    void discard();
+};
+
+} // namespace NN_CLI
+
+//===================================================================================================================//
+
+#endif // NN_CLI_PACKEDDATASET_HPP
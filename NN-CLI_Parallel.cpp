@@ -0,0 +1,78 @@
+#include "NN-CLI_Parallel.hpp"
+#include "NN-CLI_ProgressBar.hpp"
+
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <mutex>
+
+namespace NN_CLI {
+
+//===================================================================================================================//
+
+void Parallel::forEach(ulong count, const std::function<void(ulong)>& body,
+                       const std::string& progressLabel, ulong progressReports, QThreadPool* pool) {
+  if (count == 0) return;
+  if (!pool) pool = QThreadPool::globalInstance();
+
+  // A few chunks per thread, so threads that draw cheap elements pick up more of the work
+  ulong numChunks = std::min(count, static_cast<ulong>(std::max(1, pool->maxThreadCount())) * 4);
+  ulong chunkSize = (count + numChunks - 1) / numChunks;
+
+  std::atomic<ulong> firstFailure{std::numeric_limits<ulong>::max()};
+  std::exception_ptr failure;
+  std::mutex failureMutex;
+
+  // Progress lines are only printed at the points printLoadingProgress() would show
+  ulong progressInterval = (progressReports > 0) ? std::max(static_cast<ulong>(1), count / progressReports) : 0;
+  std::atomic<ulong> done{0};
+  ulong lastPrinted = 0;
+  std::mutex progressMutex;
+
+  QVector<QFuture<void>> futures;
+  futures.reserve(static_cast<int>(numChunks));
+
+  for (ulong chunkStart = 0; chunkStart < count; chunkStart += chunkSize) {
+    ulong chunkEnd = std::min(chunkStart + chunkSize, count);
+
+    futures.append(QtConcurrent::run(pool, [&, chunkStart, chunkEnd]() {
+      for (ulong i = chunkStart; i < chunkEnd; i++) {
+        // Anything past an earlier failure would be discarded anyway
+        if (i > firstFailure.load(std::memory_order_relaxed)) return;
+
+        try {
+          body(i);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(failureMutex);
+          if (i < firstFailure.load()) {
+            firstFailure.store(i);
+            failure = std::current_exception();
+          }
+          return;
+        }
+
+        if (progressInterval == 0) continue;
+        ulong current = ++done;
+        if (current == 1 || current == count || current % progressInterval == 0) {
+          std::lock_guard<std::mutex> lock(progressMutex);
+          if (current > lastPrinted) {
+            ProgressBar::printLoadingProgress(progressLabel, current, count, progressReports);
+            lastPrinted = current;
+          }
+        }
+      }
+    }));
+  }
+
+  for (auto& f : futures) f.waitForFinished();
+
+  if (failure) std::rethrow_exception(failure);
+}
+
+//===================================================================================================================//
+
+} // namespace NN_CLI
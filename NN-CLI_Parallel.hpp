@@ -0,0 +1,36 @@
+#ifndef NN_CLI_PARALLEL_HPP
+#define NN_CLI_PARALLEL_HPP
+
+#include <functional>
+#include <string>
+
+#include <sys/types.h>
+
+class QThreadPool;
+
+//===================================================================================================================//
+
+namespace NN_CLI {
+
+/**
+ * Parallel: order-preserving parallel loops for the loaders.
+ *
+ * forEach() splits [0, count) into contiguous chunks and runs them on a thread pool
+ * (the global pool by default), so callers write each result into a preallocated slot
+ * and get the same layout a serial loop would produce.
+ */
+class Parallel {
+  public:
+    // Call body(i) for every i in [0, count) and block until all calls finish.
+    // If any call throws, the exception of the lowest failing index is rethrown — the one a
+    // serial loop would have hit first. Loading progress is printed when progressReports > 0.
+    static void forEach(ulong count, const std::function<void(ulong)>& body,
+                        const std::string& progressLabel = "", ulong progressReports = 0,
+                        QThreadPool* pool = nullptr);
+};
+
+} // namespace NN_CLI
+
+//===================================================================================================================//
+
+#endif // NN_CLI_PARALLEL_HPP
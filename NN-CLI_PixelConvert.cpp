@@ -0,0 +1,370 @@
+#include "NN-CLI_PixelConvert.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// The kernels must round exactly like the scalar path: keep value * 255 + 0.5 as two roundings, never one FMA
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define NN_CLI_PIXEL_SIMD 1
+#define NN_CLI_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#endif
+
+namespace NN_CLI {
+
+//===================================================================================================================//
+//-- Scalar path (reference, and the tail of every kernel) --//
+//===================================================================================================================//
+
+static void toPlanarScalar(const unsigned char* pixels, float* planes, int c, size_t begin, size_t numPixels) {
+  for (int ch = 0; ch < c; ++ch) {
+    float* plane = planes + ch * numPixels;
+    for (size_t i = begin; i < numPixels; ++i) plane[i] = static_cast<float>(pixels[i * c + ch]) / 255.0f;
+  }
+}
+
+//===================================================================================================================//
+
+static void toInterleavedScalar(const float* planes, unsigned char* pixels, int c, size_t begin, size_t numPixels) {
+  for (int ch = 0; ch < c; ++ch) {
+    const float* plane = planes + ch * numPixels;
+    for (size_t i = begin; i < numPixels; ++i) {
+      float val = std::max(0.0f, std::min(1.0f, plane[i]));
+      pixels[i * c + ch] = static_cast<unsigned char>(val * 255.0f + 0.5f);
+    }
+  }
+}
+
+#ifdef NN_CLI_PIXEL_SIMD
+
+//===================================================================================================================//
+//-- Channel shuffles, 16 pixels at a time (shared by every kernel) --//
+//===================================================================================================================//
+
+// Transpose a 4x4 matrix of 32-bit lanes: rows of [4 bytes of channel 0 .. channel 3] become one row per channel.
+NN_CLI_TARGET("sse4.1")
+static inline void transpose4x4(__m128i& r0, __m128i& r1, __m128i& r2, __m128i& r3) {
+  __m128i lo01 = _mm_unpacklo_epi32(r0, r1);
+  __m128i lo23 = _mm_unpacklo_epi32(r2, r3);
+  __m128i hi01 = _mm_unpackhi_epi32(r0, r1);
+  __m128i hi23 = _mm_unpackhi_epi32(r2, r3);
+  r0 = _mm_unpacklo_epi64(lo01, lo23);
+  r1 = _mm_unpackhi_epi64(lo01, lo23);
+  r2 = _mm_unpacklo_epi64(hi01, hi23);
+  r3 = _mm_unpackhi_epi64(hi01, hi23);
+}
+
+//===================================================================================================================//
+
+// Split 16 interleaved pixels into one vector of 16 bytes per channel.
+NN_CLI_TARGET("sse4.1")
+static inline void splitChannels(const unsigned char* src, int c, __m128i channels[4]) {
+  if (c == 1) {
+    channels[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    return;
+  }
+
+  __m128i r0, r1, r2, r3;
+  if (c == 4) {
+    const __m128i group = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+    r0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), group);
+    r1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16)), group);
+    r2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32)), group);
+    r3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48)), group);
+  } else {
+    // Four groups of 4 RGB pixels (12 bytes); the last is loaded 4 bytes early so nothing past src + 48 is read
+    const __m128i group = _mm_setr_epi8(0, 3, 6, 9, 1, 4, 7, 10, 2, 5, 8, 11, -1, -1, -1, -1);
+    const __m128i lastGroup = _mm_setr_epi8(4, 7, 10, 13, 5, 8, 11, 14, 6, 9, 12, 15, -1, -1, -1, -1);
+    r0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), group);
+    r1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 12)), group);
+    r2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 24)), group);
+    r3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32)), lastGroup);
+  }
+
+  transpose4x4(r0, r1, r2, r3);
+  channels[0] = r0;
+  channels[1] = r1;
+  channels[2] = r2;
+  channels[3] = r3;
+}
+
+//===================================================================================================================//
+
+// Interleave one vector of 16 bytes per channel into 16 pixels.
+NN_CLI_TARGET("sse4.1")
+static inline void mergeChannels(const __m128i channels[4], int c, unsigned char* dst) {
+  if (c == 1) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), channels[0]);
+    return;
+  }
+
+  __m128i r0 = channels[0], r1 = channels[1], r2 = channels[2];
+  __m128i r3 = (c == 4) ? channels[3] : _mm_setzero_si128();
+  transpose4x4(r0, r1, r2, r3);
+
+  if (c == 4) {
+    const __m128i group = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_shuffle_epi8(r0, group));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_shuffle_epi8(r1, group));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 32), _mm_shuffle_epi8(r2, group));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 48), _mm_shuffle_epi8(r3, group));
+    return;
+  }
+
+  // Each 16-byte store spills 4 bytes that the next group overwrites; the last group is stored as 8 + 4 bytes
+  const __m128i group = _mm_setr_epi8(0, 4, 8, 1, 5, 9, 2, 6, 10, 3, 7, 11, -1, -1, -1, -1);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_shuffle_epi8(r0, group));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 12), _mm_shuffle_epi8(r1, group));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 24), _mm_shuffle_epi8(r2, group));
+  __m128i last = _mm_shuffle_epi8(r3, group);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 36), last);
+  int tail = _mm_cvtsi128_si32(_mm_srli_si128(last, 8));
+  std::memcpy(dst + 44, &tail, 4);
+}
+
+//===================================================================================================================//
+//-- SSE4.1 --//
+//===================================================================================================================//
+
+NN_CLI_TARGET("sse4.1")
+static void toPlanarSse41(const unsigned char* pixels, float* planes, int c, size_t numPixels) {
+  const __m128 scale = _mm_set1_ps(255.0f);
+  size_t i = 0;
+  for (; i + 16 <= numPixels; i += 16) {
+    __m128i channels[4];
+    splitChannels(pixels + i * c, c, channels);
+    for (int ch = 0; ch < c; ++ch) {
+      float* dst = planes + ch * numPixels + i;
+      __m128i v = channels[ch];
+      _mm_storeu_ps(dst, _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(v)), scale));
+      _mm_storeu_ps(dst + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(v, 4))), scale));
+      _mm_storeu_ps(dst + 8, _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(v, 8))), scale));
+      _mm_storeu_ps(dst + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(v, 12))), scale));
+    }
+  }
+  toPlanarScalar(pixels, planes, c, i, numPixels);
+}
+
+//===================================================================================================================//
+
+// Clamp to [0, 1] as std::max(0, std::min(1, x)) does (NaN becomes 1), then x * 255 + 0.5 truncated.
+NN_CLI_TARGET("sse4.1")
+static inline __m128i quantiseSse41(const float* src) {
+  const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+  const __m128 scale = _mm_set1_ps(255.0f), half = _mm_set1_ps(0.5f);
+  __m128i q[4];
+  for (int k = 0; k < 4; ++k) {
+    __m128 x = _mm_max_ps(_mm_min_ps(_mm_loadu_ps(src + 4 * k), one), zero);
+    q[k] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(x, scale), half));
+  }
+  return _mm_packus_epi16(_mm_packus_epi32(q[0], q[1]), _mm_packus_epi32(q[2], q[3]));
+}
+
+//===================================================================================================================//
+
+NN_CLI_TARGET("sse4.1")
+static void toInterleavedSse41(const float* planes, unsigned char* pixels, int c, size_t numPixels) {
+  size_t i = 0;
+  for (; i + 16 <= numPixels; i += 16) {
+    __m128i channels[4] = {};
+    for (int ch = 0; ch < c; ++ch) channels[ch] = quantiseSse41(planes + ch * numPixels + i);
+    mergeChannels(channels, c, pixels + i * c);
+  }
+  toInterleavedScalar(planes, pixels, c, i, numPixels);
+}
+
+//===================================================================================================================//
+//-- AVX2 --//
+//===================================================================================================================//
+
+NN_CLI_TARGET("avx2")
+static void toPlanarAvx2(const unsigned char* pixels, float* planes, int c, size_t numPixels) {
+  const __m256 scale = _mm256_set1_ps(255.0f);
+  size_t i = 0;
+  for (; i + 16 <= numPixels; i += 16) {
+    __m128i channels[4];
+    splitChannels(pixels + i * c, c, channels);
+    for (int ch = 0; ch < c; ++ch) {
+      float* dst = planes + ch * numPixels + i;
+      __m128i v = channels[ch];
+      _mm256_storeu_ps(dst, _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(v)), scale));
+      _mm256_storeu_ps(dst + 8, _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(v, 8))), scale));
+    }
+  }
+  toPlanarScalar(pixels, planes, c, i, numPixels);
+}
+
+//===================================================================================================================//
+
+NN_CLI_TARGET("avx2")
+static inline __m128i quantiseAvx2(const float* src) {
+  const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.0f);
+  const __m256 scale = _mm256_set1_ps(255.0f), half = _mm256_set1_ps(0.5f);
+  __m256 x0 = _mm256_max_ps(_mm256_min_ps(_mm256_loadu_ps(src), one), zero);
+  __m256 x1 = _mm256_max_ps(_mm256_min_ps(_mm256_loadu_ps(src + 8), one), zero);
+  __m256i q0 = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(x0, scale), half));
+  __m256i q1 = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(x1, scale), half));
+
+  // Pack within 128-bit halves so the bytes stay in pixel order
+  __m128i p0 = _mm_packus_epi32(_mm256_castsi256_si128(q0), _mm256_extracti128_si256(q0, 1));
+  __m128i p1 = _mm_packus_epi32(_mm256_castsi256_si128(q1), _mm256_extracti128_si256(q1, 1));
+  return _mm_packus_epi16(p0, p1);
+}
+
+//===================================================================================================================//
+
+NN_CLI_TARGET("avx2")
+static void toInterleavedAvx2(const float* planes, unsigned char* pixels, int c, size_t numPixels) {
+  size_t i = 0;
+  for (; i + 16 <= numPixels; i += 16) {
+    __m128i channels[4] = {};
+    for (int ch = 0; ch < c; ++ch) channels[ch] = quantiseAvx2(planes + ch * numPixels + i);
+    mergeChannels(channels, c, pixels + i * c);
+  }
+  toInterleavedScalar(planes, pixels, c, i, numPixels);
+}
+
+//===================================================================================================================//
+//-- AVX-512 --//
+//===================================================================================================================//
+
+NN_CLI_TARGET("avx512f")
+static void toPlanarAvx512(const unsigned char* pixels, float* planes, int c, size_t numPixels) {
+  const __m512 scale = _mm512_set1_ps(255.0f);
+  size_t i = 0;
+  for (; i + 16 <= numPixels; i += 16) {
+    __m128i channels[4];
+    splitChannels(pixels + i * c, c, channels);
+    for (int ch = 0; ch < c; ++ch) {
+      _mm512_storeu_ps(planes + ch * numPixels + i,
+                       _mm512_div_ps(_mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(channels[ch])), scale));
+    }
+  }
+  toPlanarScalar(pixels, planes, c, i, numPixels);
+}
+
+//===================================================================================================================//
+
+NN_CLI_TARGET("avx512f")
+static void toInterleavedAvx512(const float* planes, unsigned char* pixels, int c, size_t numPixels) {
+  const __m512 zero = _mm512_setzero_ps(), one = _mm512_set1_ps(1.0f);
+  const __m512 scale = _mm512_set1_ps(255.0f), half = _mm512_set1_ps(0.5f);
+  size_t i = 0;
+  for (; i + 16 <= numPixels; i += 16) {
+    __m128i channels[4] = {};
+    for (int ch = 0; ch < c; ++ch) {
+      __m512 x = _mm512_max_ps(_mm512_min_ps(_mm512_loadu_ps(planes + ch * numPixels + i), one), zero);
+      channels[ch] = _mm512_cvtusepi32_epi8(_mm512_cvttps_epi32(_mm512_add_ps(_mm512_mul_ps(x, scale), half)));
+    }
+    mergeChannels(channels, c, pixels + i * c);
+  }
+  toInterleavedScalar(planes, pixels, c, i, numPixels);
+}
+
+#endif // NN_CLI_PIXEL_SIMD
+
+//===================================================================================================================//
+//-- Dispatch --//
+//===================================================================================================================//
+
+PixelConvert::Isa PixelConvert::bestIsa() {
+  static const Isa best = []() {
+#ifdef NN_CLI_PIXEL_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return Isa::AVX512;
+    if (__builtin_cpu_supports("avx2")) return Isa::AVX2;
+    if (__builtin_cpu_supports("sse4.1")) return Isa::SSE41;
+#endif
+    return Isa::SCALAR;
+  }();
+  return best;
+}
+
+//===================================================================================================================//
+
+bool PixelConvert::isSupported(Isa isa) {
+  return static_cast<int>(isa) <= static_cast<int>(bestIsa());
+}
+
+//===================================================================================================================//
+
+std::vector<PixelConvert::Isa> PixelConvert::supportedIsas() {
+  std::vector<Isa> isas;
+  for (Isa isa : {Isa::SCALAR, Isa::SSE41, Isa::AVX2, Isa::AVX512}) {
+    if (isSupported(isa)) isas.push_back(isa);
+  }
+  return isas;
+}
+
+//===================================================================================================================//
+
+std::string PixelConvert::isaName(Isa isa) {
+  switch (isa) {
+    case Isa::SCALAR: return "scalar";
+    case Isa::SSE41:  return "SSE4.1";
+    case Isa::AVX2:   return "AVX2";
+    case Isa::AVX512: return "AVX-512";
+  }
+  return "scalar";
+}
+
+//===================================================================================================================//
+
+void PixelConvert::toPlanar(const unsigned char* pixels, float* planes, int c, size_t numPixels) {
+  toPlanar(bestIsa(), pixels, planes, c, numPixels);
+}
+
+//===================================================================================================================//
+
+void PixelConvert::toInterleaved(const float* planes, unsigned char* pixels, int c, size_t numPixels) {
+  toInterleaved(bestIsa(), planes, pixels, c, numPixels);
+}
+
+//===================================================================================================================//
+
+void PixelConvert::toPlanar(Isa isa, const unsigned char* pixels, float* planes, int c, size_t numPixels) {
+  if (!isSupported(isa)) throw std::runtime_error(isaName(isa) + " is not supported on this CPU");
+
+#ifdef NN_CLI_PIXEL_SIMD
+  if (c == 1 || c == 3 || c == 4) {
+    switch (isa) {
+      case Isa::AVX512: toPlanarAvx512(pixels, planes, c, numPixels); return;
+      case Isa::AVX2:   toPlanarAvx2(pixels, planes, c, numPixels); return;
+      case Isa::SSE41:  toPlanarSse41(pixels, planes, c, numPixels); return;
+      case Isa::SCALAR: break;
+    }
+  }
+#endif
+
+  toPlanarScalar(pixels, planes, c, 0, numPixels);
+}
+
+//===================================================================================================================//
+
+void PixelConvert::toInterleaved(Isa isa, const float* planes, unsigned char* pixels, int c, size_t numPixels) {
+  if (!isSupported(isa)) throw std::runtime_error(isaName(isa) + " is not supported on this CPU");
+
+#ifdef NN_CLI_PIXEL_SIMD
+  if (c == 1 || c == 3 || c == 4) {
+    switch (isa) {
+      case Isa::AVX512: toInterleavedAvx512(planes, pixels, c, numPixels); return;
+      case Isa::AVX2:   toInterleavedAvx2(planes, pixels, c, numPixels); return;
+      case Isa::SSE41:  toInterleavedSse41(planes, pixels, c, numPixels); return;
+      case Isa::SCALAR: break;
+    }
+  }
+#endif
+
+  toInterleavedScalar(planes, pixels, c, 0, numPixels);
+}
+
+//===================================================================================================================//
+
+} // namespace NN_CLI
@@ -0,0 +1,45 @@
+#ifndef NN_CLI_PIXELCONVERT_HPP
+#define NN_CLI_PIXELCONVERT_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+//===================================================================================================================//
+
+namespace NN_CLI {
+
+/**
+ * PixelConvert: conversion between interleaved HWC uint8 pixels and planar CHW float tensors.
+ *
+ * toPlanar() splits the channels and normalises each value to p / 255; toInterleaved() clamps to
+ * [0, 1], scales by 255, rounds half up and interleaves. Both run once per image, so they have
+ * SSE4.1, AVX2 and AVX-512 kernels for 1, 3 and 4 channels (x86 with GCC or Clang), chosen at
+ * runtime from what the CPU supports. Every kernel is bit-identical to the scalar path.
+ */
+class PixelConvert {
+  public:
+    enum class Isa { SCALAR, SSE41, AVX2, AVX512 };
+
+    // Best instruction set supported by this CPU (and build); detected once.
+    static Isa bestIsa();
+    static bool isSupported(Isa isa);
+    static std::vector<Isa> supportedIsas();
+    static std::string isaName(Isa isa);
+
+    // Interleaved pixels (numPixels x c) to c planes of numPixels floats, using bestIsa().
+    static void toPlanar(const unsigned char* pixels, float* planes, int c, size_t numPixels);
+
+    // c planes of numPixels floats to interleaved pixels (numPixels x c), using bestIsa().
+    static void toInterleaved(const float* planes, unsigned char* pixels, int c, size_t numPixels);
+
+    // The same with an explicit instruction set, which must be supported (for tests and benchmarks).
+    static void toPlanar(Isa isa, const unsigned char* pixels, float* planes, int c, size_t numPixels);
+    static void toInterleaved(Isa isa, const float* planes, unsigned char* pixels, int c, size_t numPixels);
+};
+
+} // namespace NN_CLI
+
+//===================================================================================================================//
+
+#endif // NN_CLI_PIXELCONVERT_HPP
@@ -0,0 +1,226 @@
+#include "NN-CLI_PredictWriter.hpp"
+#include "NN-CLI_ModelFile.hpp"
+#include "NN-CLI_Parallel.hpp"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+
+namespace NN_CLI {
+
+//===================================================================================================================//
+
+// Header size reserved for .npy files (magic, version, length and padded dict), so the row count can be
+// rewritten in place once a streamed file is complete. A multiple of 64 keeps the data block aligned.
+static const ulong npyHeaderSize = 128;
+
+// Rows formatted per batch when writing JSON Lines (concurrently, each value as json.dump() prints it)
+static const ulong jsonLinesBatchSize = 4096;
+
+//===================================================================================================================//
+
+PredictWriter::PredictWriter(const std::string& filePath, PredictOutputFormat format, ulong expectedRows)
+    : filePath(filePath), format(format), file(std::make_unique<QFile>(QString::fromStdString(filePath))),
+      toStdout(filePath == "-"), expectedRows(expectedRows) {
+  if (format == PredictOutputFormat::JSON) {
+    throw std::runtime_error("PredictWriter does not write the JSON format");
+  }
+  if (format == PredictOutputFormat::NPY && this->toStdout && expectedRows == 0) {
+    throw std::runtime_error(".npy outputs can only be streamed to a file; use --output <file> or "
+                             "--output-format jsonl|f32");
+  }
+
+  QIODevice::OpenMode mode = QIODevice::WriteOnly;
+  if (format == PredictOutputFormat::JSONL) mode |= QIODevice::Text;
+
+  bool opened = this->toStdout ? this->file->open(stdout, mode) : this->file->open(mode);
+  if (!opened) {
+    throw std::runtime_error("Failed to open output file: " + filePath);
+  }
+}
+
+//===================================================================================================================//
+
+PredictWriter::~PredictWriter() = default;
+
+//===================================================================================================================//
+
+PredictOutputFormat PredictWriter::parseFormat(const std::string& name) {
+  if (name == "json") return PredictOutputFormat::JSON;
+  if (name == "jsonl") return PredictOutputFormat::JSONL;
+  if (name == "npy") return PredictOutputFormat::NPY;
+  if (name == "f32") return PredictOutputFormat::F32;
+  throw std::runtime_error("Unknown output format '" + name + "' (expected json, jsonl, npy or f32)");
+}
+
+//===================================================================================================================//
+
+std::optional<PredictOutputFormat> PredictWriter::formatFromPath(const std::string& filePath) {
+  QString suffix = QFileInfo(QString::fromStdString(filePath)).suffix().toLower();
+  if (suffix == "json") return PredictOutputFormat::JSON;
+  if (suffix == "jsonl" || suffix == "ndjson") return PredictOutputFormat::JSONL;
+  if (suffix == "npy") return PredictOutputFormat::NPY;
+  if (suffix == "f32") return PredictOutputFormat::F32;
+  return std::nullopt;
+}
+
+//===================================================================================================================//
+
+std::string PredictWriter::formatName(PredictOutputFormat format) {
+  switch (format) {
+    case PredictOutputFormat::JSON:  return "json";
+    case PredictOutputFormat::JSONL: return "jsonl";
+    case PredictOutputFormat::NPY:   return "npy";
+    case PredictOutputFormat::F32:   return "f32";
+  }
+  return "json";
+}
+
+//===================================================================================================================//
+
+std::string PredictWriter::extension(PredictOutputFormat format) {
+  return "." + formatName(format);
+}
+
+//===================================================================================================================//
+
+std::string PredictWriter::sidecarPath(const std::string& filePath) {
+  QFileInfo info(QString::fromStdString(filePath));
+  return info.dir().filePath(info.completeBaseName() + ".meta.json").toStdString();
+}
+
+//===================================================================================================================//
+
+void PredictWriter::write(const std::vector<std::vector<float>>& outputs) {
+  if (outputs.empty()) return;
+
+  if (this->format == PredictOutputFormat::JSONL) {
+    for (ulong start = 0; start < outputs.size(); start += jsonLinesBatchSize) {
+      ulong count = std::min<ulong>(jsonLinesBatchSize, outputs.size() - start);
+      std::vector<std::string> lines(count);
+      Parallel::forEach(count, [&](ulong i) {
+        const std::vector<float>& output = outputs[start + i];
+        std::string& line = lines[i];
+        char number[32];
+        line.reserve(output.size() * 12 + 3);
+        line += '[';
+        for (ulong j = 0; j < output.size(); j++) {
+          if (j > 0) line += ',';
+          line.append(number, formatFloat(output[j], number));
+        }
+        line += "]\n";
+      });
+      for (const std::string& line : lines) this->writeBytes(line.data(), line.size());
+    }
+    if (this->rowSize == 0) this->rowSize = outputs[0].size();
+    this->numRows += outputs.size();
+    this->file->flush();
+    return;
+  }
+
+  // Binary rows: every row must have the size of the first, so the file is a dense matrix
+  if (this->numRows == 0 && !this->headerWritten) this->rowSize = outputs[0].size();
+  for (const std::vector<float>& output : outputs) {
+    if (output.size() != this->rowSize) {
+      throw std::runtime_error("Output size (" + std::to_string(output.size()) + ") differs from the first output (" +
+                               std::to_string(this->rowSize) + "); " + formatName(this->format) +
+                               " outputs must all have the same size");
+    }
+  }
+
+  if (this->format == PredictOutputFormat::NPY && !this->headerWritten) this->writeNpyHeader(this->expectedRows);
+
+  // Little-endian hosts only, like packed datasets
+  for (const std::vector<float>& output : outputs) {
+    this->writeBytes(reinterpret_cast<const char*>(output.data()), output.size() * sizeof(float));
+  }
+  this->numRows += outputs.size();
+  this->file->flush();
+}
+
+//===================================================================================================================//
+
+void PredictWriter::close() {
+  if (!this->file->isOpen()) return;
+
+  if (this->format == PredictOutputFormat::NPY) {
+    if (!this->headerWritten) {
+      this->writeNpyHeader(this->numRows);
+    } else if (this->numRows != this->expectedRows) {
+      // Streamed to a file: rewrite the row count now that it is known
+      if (this->toStdout || !this->file->seek(0)) {
+        throw std::runtime_error("Cannot complete the .npy header of " + this->filePath);
+      }
+      this->writeNpyHeader(this->numRows);
+    }
+  }
+
+  this->file->flush();
+  this->file->close();
+}
+
+//===================================================================================================================//
+
+nlohmann::ordered_json PredictWriter::describe() const {
+  nlohmann::ordered_json json;
+  json["format"] = formatName(this->format);
+  json["dtype"] = "float32";
+  json["shape"] = {this->numRows, this->rowSize};
+  return json;
+}
+
+//===================================================================================================================//
+
+void PredictWriter::writeSidecar(const nlohmann::ordered_json& predictMetadata) const {
+  nlohmann::ordered_json json;
+  json["predictMetadata"] = predictMetadata;
+  json["outputs"] = this->describe();
+  std::string text = json.dump(2);
+
+  std::string path = sidecarPath(this->filePath);
+  QSaveFile sidecar(QString::fromStdString(path));
+  if (!sidecar.open(QIODevice::WriteOnly | QIODevice::Text) ||
+      sidecar.write(text.data(), static_cast<qint64>(text.size())) != static_cast<qint64>(text.size()) ||
+      !sidecar.commit()) {
+    throw std::runtime_error("Failed to write predict metadata: " + path);
+  }
+}
+
+//===================================================================================================================//
+
+// {'descr': '<f4', 'fortran_order': False, 'shape': (rows, rowSize), } padded with spaces to npyHeaderSize
+void PredictWriter::writeNpyHeader(ulong rows) {
+  std::string dict = "{'descr': '<f4', 'fortran_order': False, 'shape': (" + std::to_string(rows) + ", " +
+                     std::to_string(this->rowSize) + "), }";
+
+  ulong dictSize = npyHeaderSize - 10;
+  dict.resize(dictSize - 1, ' ');
+  dict += '\n';
+
+  std::string header = "\x93NUMPY";
+  header += '\x01';
+  header += '\x00';
+  header += static_cast<char>(dictSize & 0xFF);
+  header += static_cast<char>((dictSize >> 8) & 0xFF);
+  header += dict;
+
+  this->writeBytes(header.data(), header.size());
+  this->headerWritten = true;
+}
+
+//===================================================================================================================//
+
+void PredictWriter::writeBytes(const char* data, ulong size) {
+  if (this->file->write(data, static_cast<qint64>(size)) != static_cast<qint64>(size)) {
+    throw std::runtime_error("Failed to write predict outputs: " + this->filePath);
+  }
+}
+
+//===================================================================================================================//
+
+} // namespace NN_CLI
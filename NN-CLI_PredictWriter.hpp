@@ -0,0 +1,87 @@
+#ifndef NN_CLI_PREDICTWRITER_HPP
+#define NN_CLI_PREDICTWRITER_HPP
+
+#include <json.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+class QFile;
+
+//===================================================================================================================//
+
+namespace NN_CLI {
+
+// Layout of predict results for vector outputs (--output-format).
+enum class PredictOutputFormat {
+  JSON,   // One JSON document with "predictMetadata" and an "outputs" array
+  JSONL,  // One output array per line
+  NPY,    // NumPy .npy float32 array of shape (numOutputs, outputSize)
+  F32     // Raw little-endian float32 rows, no header
+};
+
+/**
+ * PredictWriter: writes predict outputs as JSON Lines, .npy or raw float32.
+ *
+ * Rows are appended as they are predicted, so the streaming path can write chunk by chunk.
+ * Binary rows are copied straight from the output buffers; JSON Lines rows are formatted
+ * concurrently. The timing and shape that the JSON format embeds go to a small sidecar
+ * (<output>.meta.json) instead, so the results file can be mapped as it is.
+ */
+class PredictWriter {
+  public:
+    // Opens filePath for writing ("-" writes standard output). expectedRows is the number of
+    // rows that will be written, or 0 if unknown; .npy output to standard output needs it.
+    PredictWriter(const std::string& filePath, PredictOutputFormat format, ulong expectedRows = 0);
+    ~PredictWriter();
+
+    // "json", "jsonl", "npy" or "f32". Throws on anything else.
+    static PredictOutputFormat parseFormat(const std::string& name);
+
+    // The format implied by a *.json, *.jsonl/*.ndjson, *.npy or *.f32 path, if any.
+    static std::optional<PredictOutputFormat> formatFromPath(const std::string& filePath);
+
+    static std::string formatName(PredictOutputFormat format);
+    static std::string extension(PredictOutputFormat format);
+
+    // <dir>/<base>.meta.json next to the results file.
+    static std::string sidecarPath(const std::string& filePath);
+
+    // Append rows. Every row of a binary format must have the same size. Throws on write errors.
+    void write(const std::vector<std::vector<float>>& outputs);
+
+    // Flush and close, completing the .npy header. Throws if the header cannot be completed.
+    void close();
+
+    ulong getNumRows() const { return this->numRows; }
+    ulong getRowSize() const { return this->rowSize; }
+
+    // format, dtype and shape of what was written, for the sidecar.
+    nlohmann::ordered_json describe() const;
+
+    // Write predictMetadata plus describe() to sidecarPath(filePath).
+    void writeSidecar(const nlohmann::ordered_json& predictMetadata) const;
+
+  private:
+    std::string filePath;
+    PredictOutputFormat format;
+    std::unique_ptr<QFile> file;
+    bool toStdout;
+    ulong expectedRows;
+    ulong numRows = 0;
+    ulong rowSize = 0;
+    bool headerWritten = false;
+
+    void writeNpyHeader(ulong rows);
+    void writeBytes(const char* data, ulong size);
+};
+
+} // namespace NN_CLI
+
+//===================================================================================================================//
+
+#endif // NN_CLI_PREDICTWRITER_HPP
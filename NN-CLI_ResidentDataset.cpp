@@ -0,0 +1,40 @@
+#include "NN-CLI_ResidentDataset.hpp"
+
+namespace NN_CLI {
+
+//===================================================================================================================//
+
+ResidentDataset::ResidentDataset(ulong numSamples, ulong inputSize, PackedElementType inputType,
+                                 ulong outputSize, PackedElementType outputType)
+    : count(numSamples), inputElements(inputSize), outputElements(outputSize),
+      inputType(inputType), outputType(outputType),
+      inputs(numSamples * inputSize * PackedDataset::elementSize(inputType)),
+      outputs(numSamples * outputSize * PackedDataset::elementSize(outputType)) {}
+
+//===================================================================================================================//
+
+void ResidentDataset::setSample(ulong index, const float* input, const float* output) {
+  size_t inputRecord = this->inputElements * PackedDataset::elementSize(this->inputType);
+  size_t outputRecord = this->outputElements * PackedDataset::elementSize(this->outputType);
+
+  PackedDataset::encode(input, this->inputType, this->inputElements, this->inputs.data() + index * inputRecord);
+  PackedDataset::encode(output, this->outputType, this->outputElements, this->outputs.data() + index * outputRecord);
+}
+
+//===================================================================================================================//
+
+void ResidentDataset::readInput(ulong index, float* dst) const {
+  size_t inputRecord = this->inputElements * PackedDataset::elementSize(this->inputType);
+  PackedDataset::decode(this->inputs.data() + index * inputRecord, this->inputType, this->inputElements, dst);
+}
+
+//===================================================================================================================//
+
+void ResidentDataset::readOutput(ulong index, float* dst) const {
+  size_t outputRecord = this->outputElements * PackedDataset::elementSize(this->outputType);
+  PackedDataset::decode(this->outputs.data() + index * outputRecord, this->outputType, this->outputElements, dst);
+}
+
+//===================================================================================================================//
+
+} // namespace NN_CLI
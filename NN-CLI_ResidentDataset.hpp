@@ -0,0 +1,53 @@
+#ifndef NN_CLI_RESIDENTDATASET_HPP
+#define NN_CLI_RESIDENTDATASET_HPP
+
+#include "NN-CLI_MappedDataset.hpp"
+#include "NN-CLI_PackedDataset.hpp"
+
+#include <vector>
+
+//===================================================================================================================//
+
+namespace NN_CLI {
+
+/**
+ * ResidentDataset: fixed-record samples held in RAM in a compact encoding.
+ *
+ * Same record layout as a packed dataset, but backed by heap blocks instead of a file:
+ * inputs as UINT8 (images) or FLOAT16 (vectors) take 1/4 or 1/2 of the float size,
+ * and are expanded to float only when a batch is assembled.
+ *
+ * setSample() may be called concurrently for distinct indices; reads are always thread-safe.
+ */
+class ResidentDataset : public MappedDataset {
+  public:
+    ResidentDataset(ulong numSamples, ulong inputSize, PackedElementType inputType,
+                    ulong outputSize, PackedElementType outputType);
+
+    ulong numSamples() const override { return this->count; }
+    ulong inputSize() const override { return this->inputElements; }
+    ulong outputSize() const override { return this->outputElements; }
+
+    // Bytes held by the encoded records.
+    size_t byteSize() const { return this->inputs.size() + this->outputs.size(); }
+
+    void setSample(ulong index, const float* input, const float* output);
+
+    void readInput(ulong index, float* dst) const override;
+    void readOutput(ulong index, float* dst) const override;
+
+  private:
+    ulong count;
+    ulong inputElements;
+    ulong outputElements;
+    PackedElementType inputType;
+    PackedElementType outputType;
+    std::vector<unsigned char> inputs;
+    std::vector<unsigned char> outputs;
+};
+
+} // namespace NN_CLI
+
+//===================================================================================================================//
+
+#endif // NN_CLI_RESIDENTDATASET_HPP
@@ -2,26 +2,37 @@
 
 #include "NN-CLI_DataLoader.hpp"
 #include "NN-CLI_ImageLoader.hpp"
+#include "NN-CLI_JsonLinesReader.hpp"
 #include "NN-CLI_Loader.hpp"
+#include "NN-CLI_ModelFile.hpp"
+#include "NN-CLI_PackedDataset.hpp"
+#include "NN-CLI_Parallel.hpp"
 #include "NN-CLI_ProgressBar.hpp"
+#include "NN-CLI_Server.hpp"
+#include "NN-CLI_ShardedDataset.hpp"
 #include "NN-CLI_Utils.hpp"
 
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QThreadPool>
 
 #include <ANN_Utils.hpp>
 
 #include <json.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <csignal>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <numeric>
 #include <random>
 #include <sstream>
+#include <type_traits>
 
 using namespace NN_CLI;
 
@@ -31,15 +42,47 @@ Runner::Runner(const QCommandLineParser& parser, LogLevel logLevel)
     : parser(parser), logLevel(logLevel) {
   QString configPath = this->parser.value("config");
 
-  // Detect network type from config file
-  this->networkType = Loader::detectNetworkType(configPath.toStdString());
-
   // Build optional mode/device overrides as strings
   std::optional<std::string> modeOverride;
   if (this->parser.isSet("mode")) {
     modeOverride = this->parser.value("mode").toLower().toStdString();
   }
 
+  // Pack mode is NN-CLI only: the network config is read for its shapes, but no core is built
+  bool isPackMode = modeOverride.has_value() && modeOverride.value() == "pack";
+
+  // Serve mode is NN-CLI only too: the model is loaded as for predict, then served until stopped
+  bool isServeMode = modeOverride.has_value() && modeOverride.value() == "serve";
+  if (isServeMode) modeOverride = "predict";
+
+  // Saved model format: --model-format, else the --output extension (*.nnmodel = binary)
+  if (this->parser.isSet("model-format")) {
+    this->binaryModels = (this->parser.value("model-format").toLower() == "binary");
+  } else if (this->parser.isSet("output")) {
+    this->binaryModels = ModelFile::isBinaryModelPath(this->parser.value("output").toStdString());
+  }
+  if (this->parser.isSet("model-precision") && this->parser.value("model-precision").toLower() == "fp16") {
+    this->modelParameterType = PackedElementType::FLOAT16;
+  }
+
+  // Convert mode rewrites the model file as it is: nothing else is loaded
+  if (modeOverride.has_value() && modeOverride.value() == "convert") {
+    this->mode = "convert";
+    return;
+  }
+
+  // Info mode reads only the model's header (everything but its parameters)
+  if (modeOverride.has_value() && modeOverride.value() == "info") {
+    this->mode = "info";
+    return;
+  }
+
+  // Parse the config/model file once; every setting below is read from this document
+  ModelFile config(configPath.toStdString());
+
+  // Detect network type from config file
+  this->networkType = Loader::detectNetworkType(config);
+
   std::optional<std::string> deviceOverride;
   if (this->parser.isSet("device")) {
     deviceOverride = this->parser.value("device").toLower().toStdString();
@@ -62,7 +105,23 @@ Runner::Runner(const QCommandLineParser& parser, LogLevel logLevel)
     outputTypeOverride = this->parser.value("output-type").toLower().toStdString();
   }
 
-  this->ioConfig = Loader::loadIOConfig(configPath.toStdString(), inputTypeOverride, outputTypeOverride);
+  this->ioConfig = Loader::loadIOConfig(config, inputTypeOverride, outputTypeOverride);
+
+  // Persistent decoded-image cache (opt-in)
+  if (this->parser.isSet("image-cache")) {
+    ImageLoader::setCacheDirectory(this->parser.value("image-cache").toStdString());
+  }
+
+  // Image decoder backend (libjpeg decodes large JPEGs at reduced scale)
+  if (this->parser.isSet("image-decoder")) {
+    std::string decoderName = this->parser.value("image-decoder").toLower().toStdString();
+    ImageLoader::setDecoderBackend(ImageLoader::parseDecoderBackend(decoderName));
+  }
+
+  // PNG compression of predicted images (0 = uncompressed, fastest)
+  if (this->parser.isSet("png-compression")) {
+    ImageLoader::setPngCompressionLevel(this->parser.value("png-compression").toInt());
+  }
 
   // Display info (verbose level >= 1)
   std::string networkTypeStr = (this->networkType == NetworkType::CNN) ? "CNN" : "ANN";
@@ -75,14 +134,20 @@ Runner::Runner(const QCommandLineParser& parser, LogLevel logLevel)
     std::cout << "Mode: " << modeDisplay << ", Device: " << deviceDisplay << "\n";
     std::cout << "Input type: " << dataTypeToString(this->ioConfig.inputType)
               << ", Output type: " << dataTypeToString(this->ioConfig.outputType) << "\n";
+    if (!ImageLoader::getCacheDirectory().empty()) {
+      std::cout << "Image cache: " << ImageLoader::getCacheDirectory() << "\n";
+    }
+    if (ImageLoader::getDecoderBackend() != ImageLoader::DecoderBackend::STB) {
+      std::cout << "Image decoder: " << ImageLoader::decoderBackendName(ImageLoader::getDecoderBackend()) << "\n";
+    }
   }
 
   // Load NN-CLI-level settings from config root
-  this->progressReports = Loader::loadProgressReports(configPath.toStdString());
-  this->saveModelInterval = Loader::loadSaveModelInterval(configPath.toStdString());
+  this->progressReports = Loader::loadProgressReports(config);
+  this->saveModelInterval = Loader::loadSaveModelInterval(config);
 
   // Load data augmentation config
-  auto augConfig = Loader::loadAugmentationConfig(configPath.toStdString());
+  auto augConfig = Loader::loadAugmentationConfig(config);
   this->augmentationFactor = augConfig.augmentationFactor;
   this->balanceAugmentation = augConfig.balanceAugmentation;
   this->autoClassWeights = augConfig.autoClassWeights;
@@ -93,6 +158,9 @@ Runner::Runner(const QCommandLineParser& parser, LogLevel logLevel)
     std::cout << "Save model interval: every " << this->saveModelInterval << " epoch(s)\n";
   }
 
+  // Load the config as a training config in pack mode (no trained parameters are required)
+  if (isPackMode) modeOverride = "train";
+
   if (this->networkType == NetworkType::ANN) {
     // Convert string overrides to ANN enum overrides
     std::optional<ANN::ModeType> annModeOverride;
@@ -101,23 +169,38 @@ Runner::Runner(const QCommandLineParser& parser, LogLevel logLevel)
     std::optional<ANN::DeviceType> annDeviceOverride;
     if (deviceOverride.has_value()) annDeviceOverride = ANN::Device::nameToType(deviceOverride.value());
 
-    this->annCoreConfig = Loader::loadANNConfig(configPath.toStdString(), annModeOverride, annDeviceOverride);
+    this->annCoreConfig = Loader::loadANNConfig(config, annModeOverride, annDeviceOverride);
     this->annCoreConfig.logLevel = static_cast<ANN::LogLevel>(this->logLevel);
     if (shuffleSamplesOverride.has_value()) this->annCoreConfig.trainingConfig.shuffleSamples = shuffleSamplesOverride.value();
     this->mode = ANN::Mode::typeToName(this->annCoreConfig.modeType);
-    this->annCore = ANN::Core<float>::makeCore(this->annCoreConfig);
+    if (isPackMode) {
+      this->mode = "pack";
+    } else {
+      if (isServeMode) this->mode = "serve";
+      this->annCore = ANN::Core<float>::makeCore(this->annCoreConfig);
+    }
   } else {
-    this->cnnCoreConfig = Loader::loadCNNConfig(configPath.toStdString(), modeOverride, deviceOverride);
+    this->cnnCoreConfig = Loader::loadCNNConfig(config, modeOverride, deviceOverride);
     this->cnnCoreConfig.logLevel = static_cast<CNN::LogLevel>(this->logLevel);
     if (shuffleSamplesOverride.has_value()) this->cnnCoreConfig.trainingConfig.shuffleSamples = shuffleSamplesOverride.value();
     this->mode = CNN::Mode::typeToName(this->cnnCoreConfig.modeType);
-    this->cnnCore = CNN::Core<float>::makeCore(this->cnnCoreConfig);
+    if (isPackMode) {
+      this->mode = "pack";
+    } else {
+      if (isServeMode) this->mode = "serve";
+      this->cnnCore = CNN::Core<float>::makeCore(this->cnnCoreConfig);
+    }
   }
 }
 
 //===================================================================================================================//
 
 int Runner::run() {
+  if (this->mode == "pack") return this->runPack();
+  if (this->mode == "serve") return this->runServe();
+  if (this->mode == "convert") return this->runConvert();
+  if (this->mode == "info") return this->runInfo();
+
   if (this->networkType == NetworkType::ANN) {
     if (this->mode == "train")   return this->runANNTrain();
     if (this->mode == "test")    return this->runANNTest();
@@ -133,10 +216,7 @@ int Runner::run() {
 
 int Runner::runANNTrain() {
   // Reject conflicting input formats
-  if (this->parser.isSet("samples") && this->parser.isSet("idx-data")) {
-    std::cerr << "Error: Cannot use both --samples and --idx-data. Choose one format.\n";
-    return 1;
-  }
+  if (!this->checkSampleSources()) return 1;
 
   QString inputFilePath;
   DataLoader<ANN::Sample<float>> dataLoader;
@@ -145,7 +225,16 @@ int Runner::runANNTrain() {
   int inputH = this->ioConfig.hasInputShape() ? static_cast<int>(this->ioConfig.inputH) : 0;
   int inputW = this->ioConfig.hasInputShape() ? static_cast<int>(this->ioConfig.inputW) : 0;
 
-  if (this->parser.isSet("samples")) {
+  if (this->parser.isSet("samples") && QFileInfo(this->parser.value("samples")).isDir()) {
+    // Shard directory — packed shards streamed sequentially through a shuffle buffer
+    inputFilePath = this->parser.value("samples");
+    ulong shuffleBufferSize = this->parser.isSet("shuffle-buffer") ? this->parser.value("shuffle-buffer").toULong() : 10000;
+    this->loadShardsIntoDataLoader(dataLoader, "training", inputC, inputH, inputW, shuffleBufferSize);
+  } else if (this->parser.isSet("samples") && PackedDataset::isPackedFile(this->parser.value("samples").toStdString())) {
+    // Packed dataset — memory-mapped, samples served as pointer offsets (no decoding per epoch)
+    inputFilePath = this->parser.value("samples");
+    dataLoader.loadPacked(inputFilePath.toStdString(), inputC, inputH, inputW);
+  } else if (this->parser.isSet("samples")) {
     // JSON samples — store lightweight manifest (images loaded on-demand per batch)
     inputFilePath = this->parser.value("samples");
     int outputC = this->ioConfig.hasOutputShape() ? static_cast<int>(this->ioConfig.outputC) : 0;
@@ -153,8 +242,18 @@ int Runner::runANNTrain() {
     int outputW = this->ioConfig.hasOutputShape() ? static_cast<int>(this->ioConfig.outputW) : 0;
     dataLoader.loadManifest(inputFilePath.toStdString(), this->ioConfig,
         inputC, inputH, inputW, outputC, outputH, outputW);
+    if (this->parser.isSet("resident")) this->makeSamplesResident(dataLoader);
+    else if (this->parser.isSet("sample-cache")) this->enableSampleCache(dataLoader);
+  } else if (this->parser.isSet("idx-data") && this->parser.isSet("idx-labels")) {
+    // IDX — memory-mapped uint8 block, normalised to float only as batches are assembled
+    inputFilePath = this->parser.value("idx-data");
+    this->loadIDXIntoDataLoader(dataLoader, "training", inputC, inputH, inputW);
+  } else if (this->parser.isSet("npy-inputs") && this->parser.isSet("npy-outputs")) {
+    // NumPy — memory-mapped arrays, rows converted only as batches are assembled
+    inputFilePath = this->parser.value("npy-inputs");
+    this->loadNpyIntoDataLoader(dataLoader, "training", inputC, inputH, inputW);
   } else {
-    // IDX or other format — load all samples into memory, then hand off to DataLoader
+    // Other formats — load all samples into memory, then hand off to DataLoader
     auto [samples, success] = this->loadANNSamplesFromOptions("training", inputFilePath);
     if (!success) return 1;
     dataLoader.loadFromMemory(std::move(samples), inputC, inputH, inputW);
@@ -185,6 +284,7 @@ int Runner::runANNTrain() {
 
   auto sampleProvider = dataLoader.makeSampleProvider(this->augTransforms, this->augmentationProbability);
   this->annCore->train(dataLoader.numSamples(), sampleProvider);
+  this->printSampleCacheStats(dataLoader);
 
   return this->finishANNTraining(inputFilePath);
 }
@@ -192,13 +292,17 @@ int Runner::runANNTrain() {
 //===================================================================================================================//
 
 int Runner::runANNTest() {
-  QString inputFilePath;
-  auto [samples, success] = this->loadANNSamplesFromOptions("test", inputFilePath);
-  if (!success) return 1;
+  int inputC = this->ioConfig.hasInputShape() ? static_cast<int>(this->ioConfig.inputC) : 0;
+  int inputH = this->ioConfig.hasInputShape() ? static_cast<int>(this->ioConfig.inputH) : 0;
+  int inputW = this->ioConfig.hasInputShape() ? static_cast<int>(this->ioConfig.inputW) : 0;
+
+  // Batches are decoded on demand, so memory does not grow with the test set
+  DataLoader<ANN::Sample<float>> dataLoader;
+  if (!this->loadTestSamplesIntoDataLoader(dataLoader, inputC, inputH, inputW)) return 1;
 
   if (this->logLevel >= LogLevel::INFO) std::cout << "Running ANN evaluation...\n";
 
-  ANN::TestResult<float> result = this->annCore->test(samples);
+  auto result = this->testInBatches<ANN::TestResult<float>>(*this->annCore, dataLoader);
 
   if (this->logLevel > LogLevel::QUIET) {
     std::cout << "\nTest Results:\n";
@@ -224,6 +328,15 @@ int Runner::runANNPredict() {
   QString inputPath = this->parser.value("input");
   QString outputPath;
 
+  // JSON Lines / stdin — inputs are read, predicted and written a chunk at a time
+  if (JsonLinesReader::isJsonLinesPath(inputPath.toStdString())) {
+    return this->runStreamingPredict<ANN::Input<float>>(this->annCore, this->annCoreConfig,
+        static_cast<int>(this->ioConfig.inputC), static_cast<int>(this->ioConfig.inputH),
+        static_cast<int>(this->ioConfig.inputW));
+  }
+
+  PredictOutputFormat outputFormat = this->predictOutputFormat(PredictOutputFormat::JSON);
+
   if (this->parser.isSet("output")) {
     outputPath = this->parser.value("output");
   } else {
@@ -235,7 +348,8 @@ int Runner::runANNPredict() {
     if (this->ioConfig.outputType == DataType::IMAGE) {
       outputPath = outputDir.filePath("predict_" + inputInfo.completeBaseName());
     } else {
-      outputPath = outputDir.filePath("predict_" + inputInfo.completeBaseName() + ".json");
+      outputPath = outputDir.filePath("predict_" + inputInfo.completeBaseName() +
+                                      QString::fromStdString(PredictWriter::extension(outputFormat)));
     }
   }
 
@@ -252,43 +366,31 @@ int Runner::runANNPredict() {
   auto batchStart = std::chrono::system_clock::now();
   std::string startTimeStr = ANN::Utils<float>::formatISO8601();
 
-  std::vector<ANN::Output<float>> outputs;
-  outputs.reserve(inputs.size());
-
-  for (size_t i = 0; i < inputs.size(); ++i) {
-    ANN::Output<float> output = this->annCore->predict(inputs[i]);
-    outputs.push_back(std::move(output));
-    if (this->logLevel >= LogLevel::INFO && inputs.size() > 1) {
-      std::cout << "  Predicted input " << (i + 1) << "/" << inputs.size() << "\n";
-    }
+  // When outputType is IMAGE, outputPath is a folder; each output is handed to the image writer as soon as it is
+  // predicted, so PNG encoding overlaps with the remaining inference
+  std::unique_ptr<ImageWriter> imageWriter;
+  std::function<void(ulong, ANN::Output<float>&)> onOutput;
+  if (this->ioConfig.outputType == DataType::IMAGE) {
+    imageWriter = this->makeImageWriter(outputPath);
+    if (!imageWriter) return 1;
+    std::string outDirPath = QDir(outputPath).absolutePath().toStdString();
+    onOutput = [&imageWriter, outDirPath](ulong i, ANN::Output<float>& output) {
+      imageWriter->submit(outDirPath + "/" + std::to_string(i) + ".png", std::move(output));
+    };
   }
 
+  auto replicas = this->makePredictReplicas(this->annCore, this->annCoreConfig);
+  std::vector<ANN::Output<float>> outputs =
+      this->predictInOrder<ANN::Output<float>>(*this->annCore, replicas, inputs, true, onOutput);
+  if (imageWriter) imageWriter->wait();
+
   auto batchEnd = std::chrono::system_clock::now();
   std::string endTimeStr = ANN::Utils<float>::formatISO8601();
   std::chrono::duration<double> batchElapsed = batchEnd - batchStart;
   double batchDurationSeconds = batchElapsed.count();
   std::string batchDurationFormatted = ANN::Utils<float>::formatDuration(batchDurationSeconds);
 
-  // When outputType is IMAGE, save images to a folder
-  if (this->ioConfig.outputType == DataType::IMAGE) {
-    if (!this->ioConfig.hasOutputShape()) {
-      std::cerr << "Error: outputType is 'image' but no outputShape provided in config.\n";
-      return 1;
-    }
-
-    // outputPath is a directory for batch image output
-    QDir outDir(outputPath);
-    if (!outDir.exists()) QDir().mkpath(outputPath);
-
-    for (size_t i = 0; i < outputs.size(); ++i) {
-      QString imgName = QString::number(i) + ".png";
-      std::string imgPath = outDir.filePath(imgName).toStdString();
-      ImageLoader::saveImage(imgPath, outputs[i],
-          static_cast<int>(this->ioConfig.outputC),
-          static_cast<int>(this->ioConfig.outputH),
-          static_cast<int>(this->ioConfig.outputW));
-    }
-
+  if (imageWriter) {
     if (this->logLevel > LogLevel::QUIET) {
       std::cout << "Predict images saved to: " << outputPath.toStdString() << "\n";
       std::cout << "  Images: " << outputs.size() << "\n";
@@ -298,29 +400,15 @@ int Runner::runANNPredict() {
     return 0;
   }
 
-  // Standard vector output: save as JSON with "outputs" array
-  nlohmann::ordered_json resultJson;
+  // Standard vector output: JSON with "outputs" array, or --output-format jsonl/npy/f32
   nlohmann::ordered_json predictMetadataJson;
   predictMetadataJson["startTime"] = startTimeStr;
   predictMetadataJson["endTime"] = endTimeStr;
   predictMetadataJson["durationSeconds"] = batchDurationSeconds;
   predictMetadataJson["durationFormatted"] = batchDurationFormatted;
   predictMetadataJson["numInputs"] = inputs.size();
-  resultJson["predictMetadata"] = predictMetadataJson;
-  resultJson["outputs"] = outputs;
-
-  QFile outputFile(outputPath);
-  if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-    std::cerr << "Error: Failed to open output file: " << outputPath.toStdString() << "\n";
-    return 1;
-  }
 
-  std::string jsonStr = resultJson.dump(2);
-  outputFile.write(jsonStr.c_str(), jsonStr.size());
-  outputFile.close();
-
-  if (this->logLevel > LogLevel::QUIET) std::cout << "Predict result saved to: " << outputPath.toStdString() << "\n";
-  return 0;
+  return this->writePredictOutputs(outputPath, outputFormat, outputs, predictMetadataJson);
 }
 
 //===================================================================================================================//
@@ -329,10 +417,7 @@ int Runner::runANNPredict() {
 
 int Runner::runCNNTrain() {
   // Reject conflicting input formats
-  if (this->parser.isSet("samples") && this->parser.isSet("idx-data")) {
-    std::cerr << "Error: Cannot use both --samples and --idx-data. Choose one format.\n";
-    return 1;
-  }
+  if (!this->checkSampleSources()) return 1;
 
   QString inputFilePath;
   DataLoader<CNN::Sample<float>> dataLoader;
@@ -341,15 +426,34 @@ int Runner::runCNNTrain() {
   int inputH = static_cast<int>(inputShape.h);
   int inputW = static_cast<int>(inputShape.w);
 
-  if (this->parser.isSet("samples")) {
+  if (this->parser.isSet("samples") && QFileInfo(this->parser.value("samples")).isDir()) {
+    // Shard directory — packed shards streamed sequentially through a shuffle buffer
+    inputFilePath = this->parser.value("samples");
+    ulong shuffleBufferSize = this->parser.isSet("shuffle-buffer") ? this->parser.value("shuffle-buffer").toULong() : 10000;
+    this->loadShardsIntoDataLoader(dataLoader, "training", inputC, inputH, inputW, shuffleBufferSize);
+  } else if (this->parser.isSet("samples") && PackedDataset::isPackedFile(this->parser.value("samples").toStdString())) {
+    // Packed dataset — memory-mapped, samples served as pointer offsets (no decoding per epoch)
+    inputFilePath = this->parser.value("samples");
+    dataLoader.loadPacked(inputFilePath.toStdString(), inputC, inputH, inputW);
+  } else if (this->parser.isSet("samples")) {
     // JSON samples — store lightweight manifest (images loaded on-demand per batch)
     inputFilePath = this->parser.value("samples");
     dataLoader.loadManifest(inputFilePath.toStdString(), this->ioConfig,
         inputC, inputH, inputW,
         static_cast<int>(this->ioConfig.outputC), static_cast<int>(this->ioConfig.outputH),
         static_cast<int>(this->ioConfig.outputW));
+    if (this->parser.isSet("resident")) this->makeSamplesResident(dataLoader);
+    else if (this->parser.isSet("sample-cache")) this->enableSampleCache(dataLoader);
+  } else if (this->parser.isSet("idx-data") && this->parser.isSet("idx-labels")) {
+    // IDX — memory-mapped uint8 block, normalised to float only as batches are assembled
+    inputFilePath = this->parser.value("idx-data");
+    this->loadIDXIntoDataLoader(dataLoader, "training", inputC, inputH, inputW);
+  } else if (this->parser.isSet("npy-inputs") && this->parser.isSet("npy-outputs")) {
+    // NumPy — memory-mapped arrays, rows converted only as batches are assembled
+    inputFilePath = this->parser.value("npy-inputs");
+    this->loadNpyIntoDataLoader(dataLoader, "training", inputC, inputH, inputW);
   } else {
-    // IDX or other format — load all samples into memory, then hand off to DataLoader
+    // Other formats — load all samples into memory, then hand off to DataLoader
     auto [samples, success] = this->loadCNNSamplesFromOptions("training", inputFilePath);
     if (!success) return 1;
     dataLoader.loadFromMemory(std::move(samples), inputC, inputH, inputW);
@@ -380,6 +484,7 @@ int Runner::runCNNTrain() {
 
   auto sampleProvider = dataLoader.makeSampleProvider(this->augTransforms, this->augmentationProbability);
   this->cnnCore->train(dataLoader.numSamples(), sampleProvider);
+  this->printSampleCacheStats(dataLoader);
 
   return this->finishCNNTraining(inputFilePath);
 }
@@ -387,13 +492,18 @@ int Runner::runCNNTrain() {
 //===================================================================================================================//
 
 int Runner::runCNNTest() {
-  QString inputFilePath;
-  auto [samples, success] = this->loadCNNSamplesFromOptions("test", inputFilePath);
-  if (!success) return 1;
+  const CNN::Shape3D& inputShape = this->cnnCoreConfig.inputShape;
+
+  // Batches are decoded on demand, so memory does not grow with the test set
+  DataLoader<CNN::Sample<float>> dataLoader;
+  if (!this->loadTestSamplesIntoDataLoader(dataLoader, static_cast<int>(inputShape.c),
+                                           static_cast<int>(inputShape.h), static_cast<int>(inputShape.w))) {
+    return 1;
+  }
 
   if (this->logLevel >= LogLevel::INFO) std::cout << "Running CNN evaluation...\n";
 
-  CNN::TestResult<float> result = this->cnnCore->test(samples);
+  auto result = this->testInBatches<CNN::TestResult<float>>(*this->cnnCore, dataLoader);
 
   if (this->logLevel > LogLevel::QUIET) {
     std::cout << "\nTest Results:\n";
@@ -419,6 +529,15 @@ int Runner::runCNNPredict() {
   QString inputPath = this->parser.value("input");
   QString outputPath;
 
+  // JSON Lines / stdin — inputs are read, predicted and written a chunk at a time
+  if (JsonLinesReader::isJsonLinesPath(inputPath.toStdString())) {
+    const CNN::Shape3D& inputShape = this->cnnCoreConfig.inputShape;
+    return this->runStreamingPredict<CNN::Input<float>>(this->cnnCore, this->cnnCoreConfig,
+        static_cast<int>(inputShape.c), static_cast<int>(inputShape.h), static_cast<int>(inputShape.w));
+  }
+
+  PredictOutputFormat outputFormat = this->predictOutputFormat(PredictOutputFormat::JSON);
+
   if (this->parser.isSet("output")) {
     outputPath = this->parser.value("output");
   } else {
@@ -430,7 +549,8 @@ int Runner::runCNNPredict() {
     if (this->ioConfig.outputType == DataType::IMAGE) {
       outputPath = outputDir.filePath("predict_" + inputInfo.completeBaseName());
     } else {
-      outputPath = outputDir.filePath("predict_" + inputInfo.completeBaseName() + ".json");
+      outputPath = outputDir.filePath("predict_" + inputInfo.completeBaseName() +
+                                      QString::fromStdString(PredictWriter::extension(outputFormat)));
     }
   }
 
@@ -448,43 +568,31 @@ int Runner::runCNNPredict() {
   auto batchStart = std::chrono::system_clock::now();
   std::string startTimeStr = ANN::Utils<float>::formatISO8601();
 
-  std::vector<CNN::Output<float>> outputs;
-  outputs.reserve(inputs.size());
-
-  for (size_t i = 0; i < inputs.size(); ++i) {
-    CNN::Output<float> output = this->cnnCore->predict(inputs[i]);
-    outputs.push_back(std::move(output));
-    if (this->logLevel >= LogLevel::INFO && inputs.size() > 1) {
-      std::cout << "  Predicted input " << (i + 1) << "/" << inputs.size() << "\n";
-    }
+  // When outputType is IMAGE, outputPath is a folder; each output is handed to the image writer as soon as it is
+  // predicted, so PNG encoding overlaps with the remaining inference
+  std::unique_ptr<ImageWriter> imageWriter;
+  std::function<void(ulong, CNN::Output<float>&)> onOutput;
+  if (this->ioConfig.outputType == DataType::IMAGE) {
+    imageWriter = this->makeImageWriter(outputPath);
+    if (!imageWriter) return 1;
+    std::string outDirPath = QDir(outputPath).absolutePath().toStdString();
+    onOutput = [&imageWriter, outDirPath](ulong i, CNN::Output<float>& output) {
+      imageWriter->submit(outDirPath + "/" + std::to_string(i) + ".png", std::move(output));
+    };
   }
 
+  auto replicas = this->makePredictReplicas(this->cnnCore, this->cnnCoreConfig);
+  std::vector<CNN::Output<float>> outputs =
+      this->predictInOrder<CNN::Output<float>>(*this->cnnCore, replicas, inputs, true, onOutput);
+  if (imageWriter) imageWriter->wait();
+
   auto batchEnd = std::chrono::system_clock::now();
   std::string endTimeStr = ANN::Utils<float>::formatISO8601();
   std::chrono::duration<double> batchElapsed = batchEnd - batchStart;
   double batchDurationSeconds = batchElapsed.count();
   std::string batchDurationFormatted = ANN::Utils<float>::formatDuration(batchDurationSeconds);
 
-  // When outputType is IMAGE, save images to a folder
-  if (this->ioConfig.outputType == DataType::IMAGE) {
-    if (!this->ioConfig.hasOutputShape()) {
-      std::cerr << "Error: outputType is 'image' but no outputShape provided in config.\n";
-      return 1;
-    }
-
-    // outputPath is a directory for batch image output
-    QDir outDir(outputPath);
-    if (!outDir.exists()) QDir().mkpath(outputPath);
-
-    for (size_t i = 0; i < outputs.size(); ++i) {
-      QString imgName = QString::number(i) + ".png";
-      std::string imgPath = outDir.filePath(imgName).toStdString();
-      ImageLoader::saveImage(imgPath, outputs[i],
-          static_cast<int>(this->ioConfig.outputC),
-          static_cast<int>(this->ioConfig.outputH),
-          static_cast<int>(this->ioConfig.outputW));
-    }
-
+  if (imageWriter) {
     if (this->logLevel > LogLevel::QUIET) {
       std::cout << "Predict images saved to: " << outputPath.toStdString() << "\n";
       std::cout << "  Images: " << outputs.size() << "\n";
@@ -494,28 +602,674 @@ int Runner::runCNNPredict() {
     return 0;
   }
 
-  // Standard vector output: save as JSON with "outputs" array
-  nlohmann::ordered_json resultJson;
+  // Standard vector output: JSON with "outputs" array, or --output-format jsonl/npy/f32
   nlohmann::ordered_json predictMetadataJson;
   predictMetadataJson["startTime"] = startTimeStr;
   predictMetadataJson["endTime"] = endTimeStr;
   predictMetadataJson["durationSeconds"] = batchDurationSeconds;
   predictMetadataJson["durationFormatted"] = batchDurationFormatted;
   predictMetadataJson["numInputs"] = inputs.size();
-  resultJson["predictMetadata"] = predictMetadataJson;
-  resultJson["outputs"] = outputs;
 
-  QFile outputFile(outputPath);
-  if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-    std::cerr << "Error: Failed to open output file: " << outputPath.toStdString() << "\n";
+  return this->writePredictOutputs(outputPath, outputFormat, outputs, predictMetadataJson);
+}
+
+//===================================================================================================================//
+//  Predict results
+//===================================================================================================================//
+
+PredictOutputFormat Runner::predictOutputFormat(PredictOutputFormat defaultFormat) const {
+  if (this->parser.isSet("output-format")) {
+    return PredictWriter::parseFormat(this->parser.value("output-format").toLower().toStdString());
+  }
+
+  // A *.json, *.jsonl, *.npy or *.f32 --output selects its format
+  if (this->parser.isSet("output")) {
+    auto fromPath = PredictWriter::formatFromPath(this->parser.value("output").toStdString());
+    if (fromPath.has_value()) return fromPath.value();
+  }
+
+  return defaultFormat;
+}
+
+//===================================================================================================================//
+
+int Runner::writePredictOutputs(const QString& outputPath, PredictOutputFormat format,
+                                const std::vector<std::vector<float>>& outputs,
+                                const nlohmann::ordered_json& predictMetadata) {
+  bool toStdout = (outputPath == "-");
+
+  if (format == PredictOutputFormat::JSON) {
+    nlohmann::ordered_json resultJson;
+    resultJson["predictMetadata"] = predictMetadata;
+    resultJson["outputs"] = outputs;
+
+    QFile outputFile(outputPath);
+    bool opened = toStdout ? outputFile.open(stdout, QIODevice::WriteOnly)
+                           : outputFile.open(QIODevice::WriteOnly | QIODevice::Text);
+    if (!opened) {
+      std::cerr << "Error: Failed to open output file: " << outputPath.toStdString() << "\n";
+      return 1;
+    }
+
+    std::string jsonStr = resultJson.dump(2);
+    outputFile.write(jsonStr.c_str(), jsonStr.size());
+    outputFile.close();
+
+    if (this->logLevel > LogLevel::QUIET) std::cout << "Predict result saved to: " << outputPath.toStdString() << "\n";
+    return 0;
+  }
+
+  // Rows go straight from the output buffers to the file; the metadata goes to a sidecar
+  PredictWriter writer(outputPath.toStdString(), format, outputs.size());
+  writer.write(outputs);
+  writer.close();
+  if (!toStdout) writer.writeSidecar(predictMetadata);
+
+  if (this->logLevel > LogLevel::QUIET) {
+    std::cout << "Predict result saved to: " << (toStdout ? "standard output" : outputPath.toStdString()) << "\n";
+    std::cout << "  Format: " << PredictWriter::formatName(format) << " (" << writer.getNumRows() << " x "
+              << writer.getRowSize() << ")\n";
+    if (!toStdout) std::cout << "  Metadata: " << PredictWriter::sidecarPath(outputPath.toStdString()) << "\n";
+  }
+  return 0;
+}
+
+//===================================================================================================================//
+
+std::unique_ptr<ImageWriter> Runner::makeImageWriter(const QString& outputDir) const {
+  if (!this->ioConfig.hasOutputShape()) {
+    std::cerr << "Error: outputType is 'image' but no outputShape provided in config.\n";
+    return nullptr;
+  }
+
+  QDir outDir(outputDir);
+  if (!outDir.exists()) QDir().mkpath(outputDir);
+
+  return std::make_unique<ImageWriter>(static_cast<int>(this->ioConfig.outputC),
+                                       static_cast<int>(this->ioConfig.outputH),
+                                       static_cast<int>(this->ioConfig.outputW));
+}
+
+//===================================================================================================================//
+//  Parallel predict
+//===================================================================================================================//
+
+template <typename InputT>
+InputT Runner::toModelInput(std::vector<float>&& flatInput) const {
+  if constexpr (std::is_same_v<InputT, CNN::Input<float>>) {
+    const CNN::Shape3D& inputShape = this->cnnCoreConfig.inputShape;
+    if (flatInput.size() != inputShape.size()) {
+      throw std::runtime_error("Input size (" + std::to_string(flatInput.size()) +
+        ") does not match expected input shape size (" + std::to_string(inputShape.size()) + ")");
+    }
+    InputT input(inputShape);
+    input.data = std::move(flatInput);
+    return input;
+  } else {
+    return std::move(flatInput);
+  }
+}
+
+//===================================================================================================================//
+
+template <typename CoreT, typename ConfigT>
+std::vector<std::unique_ptr<CoreT>> Runner::makePredictReplicas(std::unique_ptr<CoreT>& core,
+                                                                const ConfigT& coreConfig) {
+  std::vector<std::unique_ptr<CoreT>> replicas;
+
+  ulong numThreads = this->parser.isSet("predict-threads") ? this->parser.value("predict-threads").toULong() : 1;
+  if (numThreads == 0) numThreads = static_cast<ulong>(QThreadPool::globalInstance()->maxThreadCount());
+  if (numThreads <= 1) return replicas;
+
+  if (coreConfig.deviceType != decltype(coreConfig.deviceType)::CPU) {
+    if (this->logLevel >= LogLevel::WARNING) {
+      std::cerr << "Warning: --predict-threads only applies to the CPU device; predicting serially.\n";
+    }
+    return replicas;
+  }
+
+  // The loaded core is the first replica. The others are built from the same config (and therefore the same
+  // parameters); each predicts single-threaded, since the parallelism now comes from running them side by side.
+  // The loaded core is rebuilt single-threaded too, so it does not oversubscribe the cores next to the replicas.
+  ConfigT replicaConfig = coreConfig;
+  replicaConfig.numThreads = 1;
+  if (core->getNumThreads() != 1) core = CoreT::makeCore(replicaConfig);
+  for (ulong r = 1; r < numThreads; r++) replicas.push_back(CoreT::makeCore(replicaConfig));
+
+  if (this->logLevel >= LogLevel::INFO) std::cout << "Predict threads: " << numThreads << "\n";
+
+  return replicas;
+}
+
+//===================================================================================================================//
+
+template <typename OutputT, typename CoreT, typename InputT>
+std::vector<OutputT> Runner::predictInOrder(CoreT& core, const std::vector<std::unique_ptr<CoreT>>& replicas,
+                                            const std::vector<InputT>& inputs, bool reportEach,
+                                            const std::function<void(ulong, OutputT&)>& onOutput) {
+  std::vector<OutputT> outputs(inputs.size());
+  bool report = reportEach && this->logLevel >= LogLevel::INFO && inputs.size() > 1;
+
+  std::atomic<ulong> done{0};
+  std::mutex reportMutex;
+
+  auto predictRange = [&](CoreT& replica, ulong begin, ulong end) {
+    for (ulong i = begin; i < end; i++) {
+      outputs[i] = replica.predict(inputs[i]);
+      if (onOutput) onOutput(i, outputs[i]);
+      if (report) {
+        std::lock_guard<std::mutex> lock(reportMutex);
+        std::cout << "  Predicted input " << ++done << "/" << inputs.size() << "\n";
+      }
+    }
+  };
+
+  // Without replicas the loaded core predicts everything on the calling thread
+  ulong numShards = std::min(static_cast<ulong>(replicas.size() + 1), static_cast<ulong>(inputs.size()));
+  if (numShards <= 1) {
+    predictRange(core, 0, inputs.size());
+    return outputs;
+  }
+
+  // Each replica takes one contiguous shard of the inputs; results land in their input's slot
+  QThreadPool pool;
+  pool.setMaxThreadCount(static_cast<int>(numShards));
+
+  Parallel::forEach(numShards, [&](ulong shard) {
+    CoreT& replica = (shard == 0) ? core : *replicas[shard - 1];
+    predictRange(replica, shard * inputs.size() / numShards, (shard + 1) * inputs.size() / numShards);
+  }, "", 0, &pool);
+
+  return outputs;
+}
+
+//===================================================================================================================//
+//  Streaming predict
+//===================================================================================================================//
+
+template <typename InputT, typename CoreT, typename ConfigT>
+int Runner::runStreamingPredict(std::unique_ptr<CoreT>& core, const ConfigT& coreConfig,
+                                int inputC, int inputH, int inputW) {
+  QString inputPath = this->parser.value("input");
+  bool fromStdin = (inputPath == "-");
+  bool imageInput = (this->ioConfig.inputType == DataType::IMAGE);
+  bool imageOutput = (this->ioConfig.outputType == DataType::IMAGE);
+
+  if (imageInput && inputC * inputH * inputW == 0) {
+    std::cerr << "Error: inputType is 'image' but no inputShape provided in config.\n";
+    return 1;
+  }
+  if (imageOutput && !this->ioConfig.hasOutputShape()) {
+    std::cerr << "Error: outputType is 'image' but no outputShape provided in config.\n";
     return 1;
   }
 
-  std::string jsonStr = resultJson.dump(2);
-  outputFile.write(jsonStr.c_str(), jsonStr.size());
-  outputFile.close();
+  // Vector outputs: JSON Lines unless --output-format (or the --output extension) selects npy/f32
+  PredictOutputFormat outputFormat = this->predictOutputFormat(PredictOutputFormat::JSONL);
+  if (!imageOutput && outputFormat == PredictOutputFormat::JSON) {
+    std::cerr << "Error: Streaming predict writes jsonl, npy or f32 outputs, not json. "
+                 "Name the --output file *.jsonl for JSON Lines.\n";
+    return 1;
+  }
+
+  // Default output: standard output for standard input, otherwise next to the input file
+  QString outputPath;
+  if (this->parser.isSet("output")) {
+    outputPath = this->parser.value("output");
+  } else if (fromStdin && !imageOutput) {
+    outputPath = "-";
+  } else {
+    QFileInfo inputInfo(fromStdin ? QString("stdin") : inputPath);
+    QDir inputDir = inputInfo.absoluteDir();
+    QDir outputDir(inputDir.filePath("output"));
+    if (!outputDir.exists()) inputDir.mkdir("output");
+    outputPath = outputDir.filePath("predict_" + inputInfo.completeBaseName() +
+        (imageOutput ? QString() : QString::fromStdString(PredictWriter::extension(outputFormat))));
+  }
+  bool toStdout = (outputPath == "-");
+
+  if (imageOutput && toStdout) {
+    std::cerr << "Error: Image outputs cannot be written to standard output; use --output <dir>.\n";
+    return 1;
+  }
+
+  // Vector outputs are appended a chunk at a time (one row per input line); images go to a folder
+  std::unique_ptr<PredictWriter> writer;
+  std::unique_ptr<ImageWriter> imageWriter;
+  if (imageOutput) {
+    imageWriter = this->makeImageWriter(outputPath);
+    if (!imageWriter) return 1;
+  } else {
+    writer = std::make_unique<PredictWriter>(outputPath.toStdString(), outputFormat);
+  }
+  std::string outDirPath = QDir(outputPath).absolutePath().toStdString();
+
+  if (this->logLevel >= LogLevel::INFO) {
+    std::cout << "Streaming inputs from: " << (fromStdin ? "standard input" : inputPath.toStdString()) << "\n";
+  }
+
+  // Relative image paths resolve against the input file's folder (the working directory for stdin)
+  std::string baseDir = fromStdin ? QDir::currentPath().toStdString()
+                                  : QFileInfo(inputPath).absolutePath().toStdString();
+
+  auto toInput = [&](StreamedValue& value) {
+    return this->toModelInput<InputT>(imageInput
+        ? ImageLoader::loadImage(ImageLoader::resolvePath(SamplesReader::takePath(value, "input"), baseDir),
+                                 inputC, inputH, inputW)
+        : SamplesReader::takeData(value, "input"));
+  };
+
+  auto batchStart = std::chrono::system_clock::now();
+  std::string startTimeStr = ANN::Utils<float>::formatISO8601();
+
+  // Only one chunk of inputs and outputs is held at a time; each chunk is flushed before the next is read
+  const ulong chunkSize = 256;
+  JsonLinesReader reader(inputPath.toStdString());
+  ulong numInputs = 0;
+
+  auto replicas = this->makePredictReplicas(core, coreConfig);
+
+  // Images are encoded on the writer's threads while later inputs (and chunks) are predicted
+  std::function<void(ulong, std::vector<float>&)> onOutput;
+  if (imageOutput) {
+    onOutput = [&](ulong i, std::vector<float>& output) {
+      imageWriter->submit(outDirPath + "/" + std::to_string(numInputs + i) + ".png", std::move(output));
+    };
+  }
+
+  for (;;) {
+    std::vector<StreamedValue> values = reader.readChunk(chunkSize);
+    if (values.empty()) break;
+
+    std::vector<InputT> inputs(values.size());
+    Parallel::forEach(values.size(), [&](ulong i) { inputs[i] = toInput(values[i]); });
+
+    auto outputs = this->predictInOrder<std::vector<float>>(*core, replicas, inputs, false, onOutput);
+    if (!imageOutput) writer->write(outputs);
+
+    numInputs += inputs.size();
+    if (this->logLevel >= LogLevel::INFO) std::cout << "  Predicted " << numInputs << " input(s)\n";
+  }
+
+  if (imageOutput) imageWriter->wait();
+
+  std::chrono::duration<double> batchElapsed = std::chrono::system_clock::now() - batchStart;
+  std::string batchDurationFormatted = ANN::Utils<float>::formatDuration(batchElapsed.count());
+
+  if (!imageOutput) {
+    writer->close();
+    if (!toStdout) {
+      nlohmann::ordered_json predictMetadataJson;
+      predictMetadataJson["startTime"] = startTimeStr;
+      predictMetadataJson["endTime"] = ANN::Utils<float>::formatISO8601();
+      predictMetadataJson["durationSeconds"] = batchElapsed.count();
+      predictMetadataJson["durationFormatted"] = batchDurationFormatted;
+      predictMetadataJson["numInputs"] = numInputs;
+      writer->writeSidecar(predictMetadataJson);
+    }
+  }
+
+  if (this->logLevel > LogLevel::QUIET) {
+    std::cout << (imageOutput ? "Predict images saved to: " : "Predict results streamed to: ")
+              << (toStdout ? "standard output" : outputPath.toStdString()) << "\n";
+    std::cout << "  Inputs: " << numInputs << "\n";
+    std::cout << "  Duration: " << batchDurationFormatted << "\n";
+  }
 
-  if (this->logLevel > LogLevel::QUIET) std::cout << "Predict result saved to: " << outputPath.toStdString() << "\n";
+  return 0;
+}
+
+//===================================================================================================================//
+//  Inference server
+//===================================================================================================================//
+
+// The running server, so SIGINT/SIGTERM can shut it down cleanly (removing its socket file)
+static Server* activeServer = nullptr;
+
+static void interruptServer(int) {
+  if (activeServer) activeServer->interrupt();
+}
+
+//===================================================================================================================//
+
+int Runner::runServe() {
+  bool hasSocket = this->parser.isSet("socket");
+  bool hasPort = this->parser.isSet("port");
+  if (hasSocket == hasPort) {
+    std::cerr << "Error: serve mode requires either --socket <path> or --port <n>.\n";
+    return 1;
+  }
+
+  if (this->networkType == NetworkType::ANN) return this->serveModel<ANN::Input<float>>(this->annCore, this->annCoreConfig);
+  return this->serveModel<CNN::Input<float>>(this->cnnCore, this->cnnCoreConfig);
+}
+
+//===================================================================================================================//
+
+template <typename InputT, typename CoreT, typename ConfigT>
+int Runner::serveModel(std::unique_ptr<CoreT>& core, const ConfigT& coreConfig) {
+  // The loaded core is worker 0; --predict-threads adds replicas so requests are answered side by side
+  auto replicas = this->makePredictReplicas(core, coreConfig);
+
+  Server server(replicas.size() + 1, [&](ulong worker, std::vector<float>&& input) {
+    CoreT& replica = (worker == 0) ? *core : *replicas[worker - 1];
+    return std::vector<float>(replica.predict(this->toModelInput<InputT>(std::move(input))));
+  }, this->logLevel);
+
+  std::string address;
+  if (this->parser.isSet("socket")) {
+    address = this->parser.value("socket").toStdString();
+    server.listenUnix(address);
+  } else {
+    ulong port = this->parser.value("port").toULong();
+    server.listenTcp(static_cast<uint16_t>(port));
+    address = "127.0.0.1:" + std::to_string(port);
+  }
+
+  if (this->logLevel > LogLevel::QUIET) {
+    std::cout << "Serving on " << address << " with " << (replicas.size() + 1) << " worker(s)\n";
+    std::cout.flush();
+  }
+
+  activeServer = &server;
+  std::signal(SIGINT, interruptServer);
+  std::signal(SIGTERM, interruptServer);
+
+  bool stopped = server.run();
+
+  std::signal(SIGINT, SIG_DFL);
+  std::signal(SIGTERM, SIG_DFL);
+  activeServer = nullptr;
+
+  if (!stopped) {
+    std::cerr << "Error: " << server.getError() << "\n";
+    return 1;
+  }
+
+  if (this->logLevel > LogLevel::QUIET) std::cout << "Server stopped\n";
+  return 0;
+}
+
+//===================================================================================================================//
+//  Model conversion
+//===================================================================================================================//
+
+int Runner::runConvert() {
+  std::string inputPath = this->parser.value("config").toStdString();
+
+  // Without --model-format or a *.nnmodel --output, convert to the other format
+  bool binary = this->binaryModels;
+  if (!this->parser.isSet("model-format") && !this->parser.isSet("output")) binary = !ModelFile::isModelFile(inputPath);
+
+  std::string outputPath;
+  if (this->parser.isSet("output")) {
+    outputPath = this->parser.value("output").toStdString();
+  } else {
+    QFileInfo inputInfo(QString::fromStdString(inputPath));
+    QString fileName = inputInfo.completeBaseName() + (binary ? ".nnmodel" : ".json");
+    outputPath = inputInfo.absoluteDir().filePath(fileName).toStdString();
+  }
+
+  if (QFileInfo(QString::fromStdString(outputPath)).absoluteFilePath() ==
+      QFileInfo(QString::fromStdString(inputPath)).absoluteFilePath()) {
+    std::cerr << "Error: convert mode would overwrite its input; use --output to choose another file.\n";
+    return 1;
+  }
+
+  ModelFile::convert(inputPath, outputPath, binary, this->modelParameterType);
+  if (this->logLevel > LogLevel::QUIET) std::cout << "Model converted to: " << outputPath << "\n";
+  return 0;
+}
+
+//===================================================================================================================//
+//  Model info
+//===================================================================================================================//
+
+// "2 -> 8 (relu) -> 2 (sigmoid)" for dense layers; "conv 8@3x3 -> relu -> pool max 2x2 -> flatten" for CNN layers
+static std::string describeLayers(const nlohmann::ordered_json& layers) {
+  std::ostringstream oss;
+  for (size_t i = 0; i < layers.size(); i++) {
+    const auto& layer = layers[i];
+    if (i > 0) oss << " -> ";
+
+    if (layer.contains("numNeurons")) {
+      oss << layer.at("numNeurons").get<ulong>();
+      if (i > 0 && layer.contains("actvFunc")) oss << " (" << layer.at("actvFunc").get<std::string>() << ")";
+      continue;
+    }
+
+    std::string type = layer.value("type", std::string("?"));
+    oss << type;
+    if (type == "conv") {
+      oss << " " << layer.value("numFilters", 0UL) << "@" << layer.value("filterH", 0UL) << "x" << layer.value("filterW", 0UL);
+    } else if (type == "pool") {
+      oss << " " << layer.value("poolType", std::string("max")) << " " << layer.value("poolH", 0UL) << "x"
+          << layer.value("poolW", 0UL);
+    }
+  }
+  return oss.str();
+}
+
+//===================================================================================================================//
+
+int Runner::runInfo() {
+  std::string modelPath = this->parser.value("config").toStdString();
+  ModelFile model(modelPath, false);
+  const auto& json = model.getDocument();
+
+  NetworkType networkType = Loader::detectNetworkType(model);
+  IOConfig modelIOConfig = Loader::loadIOConfig(model);
+
+  std::cout << "Model: " << modelPath << "\n";
+  if (model.isBinary()) {
+    bool fp16 = model.getElementType() == PackedElementType::FLOAT16;
+    std::cout << "Format: binary (" << (fp16 ? "fp16" : "float32") << " parameters)\n";
+  } else {
+    std::cout << "Format: JSON\n";
+  }
+  std::cout << "Network type: " << (networkType == NetworkType::CNN ? "CNN" : "ANN") << "\n";
+  std::cout << "Mode: " << json.value("mode", std::string("train"))
+            << ", Device: " << json.value("device", std::string("cpu")) << "\n";
+  std::cout << "Input type: " << dataTypeToString(modelIOConfig.inputType)
+            << ", Output type: " << dataTypeToString(modelIOConfig.outputType) << "\n";
+  if (modelIOConfig.hasInputShape()) {
+    std::cout << "Input shape: " << modelIOConfig.inputC << "x" << modelIOConfig.inputH << "x" << modelIOConfig.inputW << "\n";
+  }
+  if (modelIOConfig.hasOutputShape()) {
+    std::cout << "Output shape: " << modelIOConfig.outputC << "x" << modelIOConfig.outputH << "x" << modelIOConfig.outputW << "\n";
+  }
+
+  if (json.contains("layersConfig")) std::cout << "Layers: " << describeLayers(json.at("layersConfig")) << "\n";
+  if (json.contains("convolutionalLayersConfig")) {
+    std::cout << "Convolutional layers: " << describeLayers(json.at("convolutionalLayersConfig")) << "\n";
+  }
+  if (json.contains("denseLayersConfig")) std::cout << "Dense layers: " << describeLayers(json.at("denseLayersConfig")) << "\n";
+  if (json.contains("costFunctionConfig")) {
+    std::cout << "Cost function: " << json.at("costFunctionConfig").value("type", std::string("?")) << "\n";
+  }
+
+  if (json.contains("trainingConfig")) {
+    const auto& tc = json.at("trainingConfig");
+    std::cout << "Training config: " << tc.value("numEpochs", 0UL) << " epoch(s), learning rate "
+              << tc.value("learningRate", 0.0f) << ", batch size " << tc.value("batchSize", 1UL) << "\n";
+  }
+  if (json.contains("trainingMetadata")) {
+    const auto& md = json.at("trainingMetadata");
+    std::cout << "Trained: " << md.value("numSamples", 0UL) << " sample(s), final loss " << md.value("finalLoss", 0.0f);
+    if (md.contains("durationFormatted")) std::cout << ", duration " << md.at("durationFormatted").get<std::string>();
+    if (md.contains("endTime")) std::cout << ", finished " << md.at("endTime").get<std::string>();
+    std::cout << "\n";
+  }
+
+  if (model.hasParameters()) {
+    std::cout << "Parameters: " << model.getNumParameters() << "\n";
+  } else {
+    std::cout << "Parameters: none (untrained config)\n";
+  }
+  return 0;
+}
+
+//===================================================================================================================//
+//  Dataset packing
+//===================================================================================================================//
+
+int Runner::runPack() {
+  // Reject conflicting input formats
+  if (!this->checkSampleSources()) return 1;
+
+  // Shapes the records are preprocessed to: CNN uses its network inputShape, ANN the optional I/O inputShape
+  int inputC = 0, inputH = 0, inputW = 0;
+  if (this->networkType == NetworkType::CNN) {
+    inputC = static_cast<int>(this->cnnCoreConfig.inputShape.c);
+    inputH = static_cast<int>(this->cnnCoreConfig.inputShape.h);
+    inputW = static_cast<int>(this->cnnCoreConfig.inputShape.w);
+  } else if (this->ioConfig.hasInputShape()) {
+    inputC = static_cast<int>(this->ioConfig.inputC);
+    inputH = static_cast<int>(this->ioConfig.inputH);
+    inputW = static_cast<int>(this->ioConfig.inputW);
+  }
+  int outputC = static_cast<int>(this->ioConfig.outputC);
+  int outputH = static_cast<int>(this->ioConfig.outputH);
+  int outputW = static_cast<int>(this->ioConfig.outputW);
+
+  // Flat samples regardless of network type — packed records are plain tensors
+  QString inputFilePath;
+  DataLoader<ANN::Sample<float>> dataLoader;
+  bool imageInput = (this->ioConfig.inputType == DataType::IMAGE);
+
+  if (this->parser.isSet("samples") && QFileInfo(this->parser.value("samples")).isDir()) {
+    // Re-pack an existing shard directory (e.g. with a different shard size), reading records in index order
+    inputFilePath = this->parser.value("samples");
+    this->loadShardsIntoDataLoader(dataLoader, "pack", inputC, inputH, inputW, 0, false);
+  } else if (this->parser.isSet("samples")) {
+    inputFilePath = this->parser.value("samples");
+    if (imageInput && inputC * inputH * inputW == 0) {
+      std::cerr << "Error: inputType is 'image' but no inputShape provided in config.\n";
+      return 1;
+    }
+    if (this->ioConfig.outputType == DataType::IMAGE && !this->ioConfig.hasOutputShape()) {
+      std::cerr << "Error: outputType is 'image' but no outputShape provided in config.\n";
+      return 1;
+    }
+    if (this->logLevel >= LogLevel::INFO) std::cout << "Packing samples from JSON: " << inputFilePath.toStdString() << "\n";
+    dataLoader.loadManifest(inputFilePath.toStdString(), this->ioConfig,
+        inputC, inputH, inputW, outputC, outputH, outputW);
+  } else if (this->parser.isSet("idx-data") && this->parser.isSet("idx-labels")) {
+    inputFilePath = this->parser.value("idx-data");
+    this->loadIDXIntoDataLoader(dataLoader, "pack", inputC, inputH, inputW);
+    imageInput = true; // IDX data is 8-bit, so uint8 records are lossless
+  } else if (this->parser.isSet("npy-inputs") && this->parser.isSet("npy-outputs")) {
+    inputFilePath = this->parser.value("npy-inputs");
+    this->loadNpyIntoDataLoader(dataLoader, "pack", inputC, inputH, inputW);
+  } else {
+    auto [samples, success] = this->loadANNSamplesFromOptions("pack", inputFilePath);
+    if (!success) return 1;
+    dataLoader.loadFromMemory(std::move(samples), inputC, inputH, inputW);
+  }
+
+  ulong numSamples = dataLoader.numSamples();
+  if (numSamples == 0) {
+    std::cerr << "Error: No samples to pack.\n";
+    return 1;
+  }
+
+  // With --shard-size the output is a directory of shards of that many samples
+  bool sharded = this->parser.isSet("shard-size");
+  ulong shardSize = sharded ? this->parser.value("shard-size").toULong() : numSamples;
+
+  std::string outputPathStr;
+  if (this->parser.isSet("output")) {
+    outputPathStr = this->parser.value("output").toStdString();
+  } else {
+    QFileInfo inputInfo(inputFilePath);
+    QDir inputDir = inputInfo.absoluteDir();
+    QDir outputDir(inputDir.filePath("output"));
+    if (!outputDir.exists()) inputDir.mkdir("output");
+    outputPathStr = outputDir.filePath(inputInfo.completeBaseName() + (sharded ? "" : ".nnpack")).toStdString();
+  }
+
+  if (sharded && !QDir().mkpath(QString::fromStdString(outputPathStr))) {
+    throw std::runtime_error("Failed to create shard directory: " + outputPathStr);
+  }
+
+  auto shardPath = [&outputPathStr](ulong shard) {
+    std::ostringstream name;
+    name << "shard-" << std::setw(5) << std::setfill('0') << shard << ".nnpack";
+    return QDir(QString::fromStdString(outputPathStr)).filePath(QString::fromStdString(name.str())).toStdString();
+  };
+
+  auto packStart = std::chrono::system_clock::now();
+
+  // The sample provider decodes each batch across all ioPool threads and prefetches the next one,
+  // so decoding overlaps with the sequential writes below.
+  // Shards are streamed one after another in training, so their records are written in a random
+  // order: each shard is then a class-mixed slice of the dataset rather than a run of similar samples.
+  std::vector<ulong> indices(numSamples);
+  std::iota(indices.begin(), indices.end(), 0);
+  if (sharded) {
+    std::mt19937 rng(42);
+    std::shuffle(indices.begin(), indices.end(), rng);
+  }
+  ulong batchSize = 256;
+  auto sampleProvider = dataLoader.makeSampleProvider();
+
+  std::unique_ptr<PackedDatasetWriter> writer;
+  ulong shardIndex = 0, shardStart = 0;
+  ulong inputSize = 0, outputSize = 0;
+  ulong displayProgressReports = (this->logLevel > LogLevel::QUIET) ? this->progressReports : 0;
+  ulong numBatches = (numSamples + batchSize - 1) / batchSize;
+
+  for (ulong b = 0; b < numBatches; b++) {
+    std::vector<ANN::Sample<float>> batch = sampleProvider(indices, batchSize, b);
+
+    // Record sizes are fixed by the first sample
+    if (b == 0) {
+      inputSize = batch[0].input.size();
+      outputSize = batch[0].output.size();
+      ulong expectedSize = static_cast<ulong>(inputC) * inputH * inputW;
+      if (this->networkType == NetworkType::CNN && inputSize != expectedSize) {
+        throw std::runtime_error("Sample input size (" + std::to_string(inputSize) +
+          ") does not match expected input shape size (" + std::to_string(expectedSize) + ")");
+      }
+    }
+
+    for (ulong i = 0; i < batch.size(); i++) {
+      ulong index = b * batchSize + i;
+      if (batch[i].input.size() != inputSize || batch[i].output.size() != outputSize) {
+        throw std::runtime_error("Sample " + std::to_string(index) + " size differs from the first sample; "
+                                 "packed records must have a fixed size");
+      }
+
+      // Start the next file (the only one, unless sharding) when the current one is full
+      if (!writer || index - shardStart == shardSize) {
+        if (writer) writer->finish();
+        shardStart = index;
+        PackedElementType outputType = (this->ioConfig.outputType == DataType::IMAGE)
+            ? PackedElementType::UINT8 : PackedElementType::FLOAT32;
+        writer = std::make_unique<PackedDatasetWriter>(sharded ? shardPath(shardIndex++) : outputPathStr,
+            std::min(shardSize, numSamples - shardStart),
+            inputSize, imageInput ? PackedElementType::UINT8 : PackedElementType::FLOAT32,
+            outputSize, outputType,
+            inputC, inputH, inputW, outputC, outputH, outputW);
+      }
+
+      writer->writeSample(index - shardStart, batch[i].input.data(), batch[i].output.data());
+      ProgressBar::printLoadingProgress("Packing samples:", index + 1, numSamples, displayProgressReports);
+    }
+  }
+
+  writer->finish();
+
+  std::chrono::duration<double> packElapsed = std::chrono::system_clock::now() - packStart;
+
+  if (this->logLevel > LogLevel::QUIET) {
+    std::cout << "Packed dataset saved to: " << outputPathStr;
+    if (sharded) std::cout << " (" << shardIndex << " shards)";
+    std::cout << "\n";
+    std::cout << "  Samples: " << numSamples << ", input size: " << inputSize
+              << ", output size: " << outputSize << "\n";
+    std::cout << "  Duration: " << ANN::Utils<float>::formatDuration(packElapsed.count()) << "\n";
+  }
   return 0;
 }
 
@@ -523,6 +1277,190 @@ int Runner::runCNNPredict() {
 //  Sample loading helpers
 //===================================================================================================================//
 
+template <typename SampleT>
+bool Runner::loadTestSamplesIntoDataLoader(DataLoader<SampleT>& dataLoader, int inputC, int inputH, int inputW) {
+  if (!this->checkSampleSources()) return false;
+
+  if (this->parser.isSet("samples") && QFileInfo(this->parser.value("samples")).isDir()) {
+    // Shard directory — read front to back, no shuffling needed for evaluation
+    this->loadShardsIntoDataLoader(dataLoader, "test", inputC, inputH, inputW, 0);
+  } else if (this->parser.isSet("samples") && PackedDataset::isPackedFile(this->parser.value("samples").toStdString())) {
+    QString packedPath = this->parser.value("samples");
+    if (this->logLevel >= LogLevel::INFO) std::cout << "Loading test samples from packed dataset: " << packedPath.toStdString() << "\n";
+    dataLoader.loadPacked(packedPath.toStdString(), inputC, inputH, inputW);
+    if (this->logLevel >= LogLevel::INFO) std::cout << "Loaded " << dataLoader.numSamples() << " test samples.\n";
+  } else if (this->parser.isSet("samples")) {
+    // JSON samples — lightweight manifest, images are only decoded as their batch is evaluated
+    if (this->ioConfig.inputType == DataType::IMAGE && inputC * inputH * inputW == 0) {
+      std::cerr << "Error: inputType is 'image' but no inputShape provided in config.\n";
+      return false;
+    }
+    if (this->ioConfig.outputType == DataType::IMAGE && !this->ioConfig.hasOutputShape()) {
+      std::cerr << "Error: outputType is 'image' but no outputShape provided in config.\n";
+      return false;
+    }
+
+    QString samplesPath = this->parser.value("samples");
+    if (this->logLevel >= LogLevel::INFO) std::cout << "Loading test samples from JSON: " << samplesPath.toStdString() << "\n";
+    dataLoader.loadManifest(samplesPath.toStdString(), this->ioConfig, inputC, inputH, inputW,
+        static_cast<int>(this->ioConfig.outputC), static_cast<int>(this->ioConfig.outputH),
+        static_cast<int>(this->ioConfig.outputW));
+    if (this->logLevel >= LogLevel::INFO) std::cout << "Loaded " << dataLoader.numSamples() << " test samples.\n";
+  } else if (this->parser.isSet("idx-data")) {
+    if (!this->parser.isSet("idx-labels")) {
+      std::cerr << "Error: --idx-labels is required when using --idx-data.\n";
+      return false;
+    }
+    this->loadIDXIntoDataLoader(dataLoader, "test", inputC, inputH, inputW);
+  } else if (this->parser.isSet("npy-inputs")) {
+    if (!this->parser.isSet("npy-outputs")) {
+      std::cerr << "Error: --npy-outputs is required when using --npy-inputs.\n";
+      return false;
+    }
+    this->loadNpyIntoDataLoader(dataLoader, "test", inputC, inputH, inputW);
+  } else {
+    std::cerr << "Error: test requires either --samples (JSON) or --idx-data and --idx-labels (IDX), "
+              << "or --npy-inputs and --npy-outputs (NumPy).\n";
+    return false;
+  }
+
+  return true;
+}
+
+//===================================================================================================================//
+
+template <typename SampleT>
+void Runner::makeSamplesResident(DataLoader<SampleT>& dataLoader) {
+  std::string encoding = this->parser.value("resident").toLower().toStdString();
+
+  // 8-bit storage is lossless only for image pixels; it would clamp and quantise arbitrary vector features
+  if (encoding == "uint8" && this->ioConfig.inputType != DataType::IMAGE) {
+    std::cerr << "Warning: --resident uint8 only applies to image inputs; keeping vector inputs as fp16.\n";
+    encoding = "fp16";
+  }
+
+  PackedElementType inputType = PackedElementType::FLOAT32;
+  if (encoding == "uint8") inputType = PackedElementType::UINT8;
+  else if (encoding == "fp16") inputType = PackedElementType::FLOAT16;
+
+  // Image outputs are 8-bit too; vector outputs (labels, regression targets) stay exact
+  PackedElementType outputType = (this->ioConfig.outputType == DataType::IMAGE && inputType == PackedElementType::UINT8)
+      ? PackedElementType::UINT8 : PackedElementType::FLOAT32;
+
+  if (this->logLevel >= LogLevel::INFO) std::cout << "Preloading resident samples (" << encoding << ")...\n";
+
+  size_t bytes = dataLoader.makeResident(inputType, outputType);
+
+  if (this->logLevel >= LogLevel::INFO) {
+    std::cout << "Resident samples: " << dataLoader.numSamples() << " ("
+              << std::fixed << std::setprecision(1) << static_cast<double>(bytes) / (1024.0 * 1024.0) << " MiB)\n";
+    std::cout.unsetf(std::ios_base::floatfield);
+  }
+}
+
+//===================================================================================================================//
+
+template <typename SampleT>
+void Runner::enableSampleCache(DataLoader<SampleT>& dataLoader) {
+  ulong budgetMiB = this->parser.value("sample-cache").toULong();
+  dataLoader.setCacheBudget(static_cast<size_t>(budgetMiB) * 1024 * 1024);
+
+  if (this->logLevel >= LogLevel::INFO) std::cout << "Sample cache: " << budgetMiB << " MiB\n";
+}
+
+//===================================================================================================================//
+
+template <typename SampleT>
+void Runner::printSampleCacheStats(const DataLoader<SampleT>& dataLoader) {
+  auto cache = dataLoader.getCache();
+  if (!cache || this->logLevel < LogLevel::INFO) return;
+
+  std::cout << "Sample cache: " << cache->getHits() << " hits, " << cache->getMisses() << " misses, "
+            << std::fixed << std::setprecision(1)
+            << static_cast<double>(cache->getBytesUsed()) / (1024.0 * 1024.0) << " MiB used\n";
+  std::cout.unsetf(std::ios_base::floatfield);
+}
+
+//===================================================================================================================//
+
+template <typename SampleT>
+void Runner::loadIDXIntoDataLoader(DataLoader<SampleT>& dataLoader, const std::string& modeName,
+                                   int inputC, int inputH, int inputW) {
+  QString idxDataPath = this->parser.value("idx-data");
+  QString idxLabelsPath = this->parser.value("idx-labels");
+
+  if (this->logLevel >= LogLevel::INFO) {
+    std::cout << "Loading " << modeName << " samples from IDX:\n";
+    std::cout << "  Data:   " << idxDataPath.toStdString() << "\n";
+    std::cout << "  Labels: " << idxLabelsPath.toStdString() << "\n";
+  }
+
+  dataLoader.loadIDX(idxDataPath.toStdString(), idxLabelsPath.toStdString(), inputC, inputH, inputW);
+
+  if (this->logLevel >= LogLevel::INFO) std::cout << "Loaded " << dataLoader.numSamples() << " " << modeName << " samples.\n";
+}
+
+//===================================================================================================================//
+
+template <typename SampleT>
+void Runner::loadNpyIntoDataLoader(DataLoader<SampleT>& dataLoader, const std::string& modeName,
+                                   int inputC, int inputH, int inputW) {
+  QString npyInputsPath = this->parser.value("npy-inputs");
+  QString npyOutputsPath = this->parser.value("npy-outputs");
+
+  if (this->logLevel >= LogLevel::INFO) {
+    std::cout << "Loading " << modeName << " samples from NumPy:\n";
+    std::cout << "  Inputs:  " << npyInputsPath.toStdString() << "\n";
+    std::cout << "  Outputs: " << npyOutputsPath.toStdString() << "\n";
+  }
+
+  dataLoader.loadNpy(npyInputsPath.toStdString(), npyOutputsPath.toStdString(), inputC, inputH, inputW);
+
+  if (this->logLevel >= LogLevel::INFO) std::cout << "Loaded " << dataLoader.numSamples() << " " << modeName << " samples.\n";
+}
+
+//===================================================================================================================//
+
+template <typename SampleT>
+void Runner::loadShardsIntoDataLoader(DataLoader<SampleT>& dataLoader, const std::string& modeName,
+                                      int inputC, int inputH, int inputW, ulong shuffleBufferSize,
+                                      bool streamed) {
+  std::string shardDir = this->parser.value("samples").toStdString();
+  std::vector<std::string> shardPaths = ShardedDataset::listShards(shardDir);
+
+  if (this->logLevel >= LogLevel::INFO) {
+    std::cout << "Loading " << modeName << " samples from " << shardPaths.size() << " shards in: " << shardDir << "\n";
+  }
+
+  dataLoader.loadShards(shardPaths, inputC, inputH, inputW, shuffleBufferSize, streamed);
+
+  if (this->logLevel >= LogLevel::INFO) {
+    std::cout << "Loaded " << dataLoader.numSamples() << " " << modeName << " samples";
+    if (streamed) std::cout << " (shuffle buffer: " << shuffleBufferSize << ")";
+    std::cout << ".\n";
+  }
+}
+
+//===================================================================================================================//
+
+bool Runner::checkSampleSources() const {
+  bool hasJsonSamples = this->parser.isSet("samples");
+  bool hasIdxData = this->parser.isSet("idx-data");
+  bool hasNpyInputs = this->parser.isSet("npy-inputs");
+
+  if (hasJsonSamples && hasIdxData) {
+    std::cerr << "Error: Cannot use both --samples and --idx-data. Choose one format.\n";
+    return false;
+  }
+  if (hasNpyInputs && (hasJsonSamples || hasIdxData)) {
+    std::cerr << "Error: Cannot use --npy-inputs with --samples or --idx-data. Choose one format.\n";
+    return false;
+  }
+  return true;
+}
+
+//===================================================================================================================//
+
 std::pair<ANN::Samples<float>, bool> Runner::loadANNSamplesFromOptions(
     const std::string& modeName,
     QString& inputFilePath) {
@@ -531,11 +1469,9 @@ std::pair<ANN::Samples<float>, bool> Runner::loadANNSamplesFromOptions(
   bool hasJsonSamples = this->parser.isSet("samples");
   bool hasIdxData = this->parser.isSet("idx-data");
   bool hasIdxLabels = this->parser.isSet("idx-labels");
+  bool hasNpyInputs = this->parser.isSet("npy-inputs");
 
-  if (hasJsonSamples && hasIdxData) {
-    std::cerr << "Error: Cannot use both --samples and --idx-data. Choose one format.\n";
-    return {samples, false};
-  }
+  if (!this->checkSampleSources()) return {samples, false};
 
   ulong displayProgressReports = (this->logLevel > LogLevel::QUIET) ? this->progressReports : 0;
 
@@ -561,8 +1497,19 @@ std::pair<ANN::Samples<float>, bool> Runner::loadANNSamplesFromOptions(
     }
 
     samples = Utils<float>::loadANNIDX(idxDataPath.toStdString(), idxLabelsPath.toStdString(), displayProgressReports);
+  } else if (hasNpyInputs) {
+    if (!this->parser.isSet("npy-outputs")) {
+      std::cerr << "Error: --npy-outputs is required when using --npy-inputs.\n";
+      return {samples, false};
+    }
+
+    inputFilePath = this->parser.value("npy-inputs");
+    if (this->logLevel >= LogLevel::INFO) std::cout << "Loading " << modeName << " samples from NumPy: " << inputFilePath.toStdString() << "\n";
+    samples = Utils<float>::loadANNNpy(inputFilePath.toStdString(), this->parser.value("npy-outputs").toStdString(),
+                                       displayProgressReports);
   } else {
-    std::cerr << "Error: " << modeName << " requires either --samples (JSON) or --idx-data and --idx-labels (IDX).\n";
+    std::cerr << "Error: " << modeName << " requires either --samples (JSON) or --idx-data and --idx-labels (IDX), "
+              << "or --npy-inputs and --npy-outputs (NumPy).\n";
     return {samples, false};
   }
 
@@ -581,11 +1528,9 @@ std::pair<CNN::Samples<float>, bool> Runner::loadCNNSamplesFromOptions(
   bool hasJsonSamples = this->parser.isSet("samples");
   bool hasIdxData = this->parser.isSet("idx-data");
   bool hasIdxLabels = this->parser.isSet("idx-labels");
+  bool hasNpyInputs = this->parser.isSet("npy-inputs");
 
-  if (hasJsonSamples && hasIdxData) {
-    std::cerr << "Error: Cannot use both --samples and --idx-data. Choose one format.\n";
-    return {samples, false};
-  }
+  if (!this->checkSampleSources()) return {samples, false};
 
   const CNN::Shape3D& inputShape = this->cnnCoreConfig.inputShape;
 
@@ -613,8 +1558,19 @@ std::pair<CNN::Samples<float>, bool> Runner::loadCNNSamplesFromOptions(
     }
 
     samples = Utils<float>::loadCNNIDX(idxDataPath.toStdString(), idxLabelsPath.toStdString(), inputShape, displayProgressReports);
+  } else if (hasNpyInputs) {
+    if (!this->parser.isSet("npy-outputs")) {
+      std::cerr << "Error: --npy-outputs is required when using --npy-inputs.\n";
+      return {samples, false};
+    }
+
+    inputFilePath = this->parser.value("npy-inputs");
+    if (this->logLevel >= LogLevel::INFO) std::cout << "Loading " << modeName << " samples from NumPy: " << inputFilePath.toStdString() << "\n";
+    samples = Utils<float>::loadCNNNpy(inputFilePath.toStdString(), this->parser.value("npy-outputs").toStdString(),
+                                       inputShape, displayProgressReports);
   } else {
-    std::cerr << "Error: " << modeName << " requires either --samples (JSON) or --idx-data and --idx-labels (IDX).\n";
+    std::cerr << "Error: " << modeName << " requires either --samples (JSON) or --idx-data and --idx-labels (IDX), "
+              << "or --npy-inputs and --npy-outputs (NumPy).\n";
     return {samples, false};
   }
 
@@ -623,12 +1579,55 @@ std::pair<CNN::Samples<float>, bool> Runner::loadCNNSamplesFromOptions(
   return {samples, true};
 }
 
+//===================================================================================================================//
+//  Evaluation
+//===================================================================================================================//
+
+template <typename ResultT, typename CoreT, typename SampleT>
+ResultT Runner::testInBatches(CoreT& core, const DataLoader<SampleT>& dataLoader) {
+  ulong numSamples = dataLoader.numSamples();
+  std::vector<ulong> indices(numSamples);
+  std::iota(indices.begin(), indices.end(), 0);
+
+  // Only the current batch (and the one being prefetched) is ever decoded
+  ulong batchSize = 256;
+  ulong numBatches = (numSamples + batchSize - 1) / batchSize;
+  auto sampleProvider = dataLoader.makeSampleProvider();
+  ulong displayProgressReports = (this->logLevel > LogLevel::QUIET) ? this->progressReports : 0;
+
+  // Loss and correct count are sums over samples, so per-batch results add up to the whole-set result
+  ResultT result{};
+  for (ulong b = 0; b < numBatches; b++) {
+    ResultT batchResult = core.test(sampleProvider(indices, batchSize, b));
+    result.numSamples += batchResult.numSamples;
+    result.totalLoss += batchResult.totalLoss;
+    result.numCorrect += batchResult.numCorrect;
+    ProgressBar::printLoadingProgress("Evaluating batches:", b + 1, numBatches, displayProgressReports);
+  }
+
+  if (result.numSamples > 0) {
+    result.averageLoss = result.totalLoss / static_cast<float>(result.numSamples);
+    result.accuracy = static_cast<float>(result.numCorrect) / static_cast<float>(result.numSamples) * 100.0f;
+  }
+
+  return result;
+}
+
 //===================================================================================================================//
 //  Model saving
 //===================================================================================================================//
 
 void Runner::saveANNModel(const ANN::Core<float>& core, const std::string& filePath,
-                           const IOConfig& ioConfig, ulong progressReports, ulong saveModelInterval) {
+                           const IOConfig& ioConfig, ulong progressReports, ulong saveModelInterval,
+                           bool binary, PackedElementType parameterType) {
+  writeANNModel(annModelDocument(core, ioConfig, progressReports, saveModelInterval), core.getParameters(),
+                filePath, binary, parameterType);
+}
+
+//===================================================================================================================//
+
+nlohmann::ordered_json Runner::annModelDocument(const ANN::Core<float>& core, const IOConfig& ioConfig,
+                                                ulong progressReports, ulong saveModelInterval) {
   nlohmann::ordered_json json;
 
   json["mode"] = ANN::Mode::typeToName(core.getModeType());
@@ -699,26 +1698,42 @@ void Runner::saveANNModel(const ANN::Core<float>& core, const std::string& fileP
   mdJson["finalLoss"] = md.finalLoss;
   json["trainingMetadata"] = mdJson;
 
-  // Parameters
+  return json;
+}
+
+//===================================================================================================================//
+
+void Runner::writeANNModel(nlohmann::ordered_json json, const ANN::Parameters<float>& parameters,
+                            const std::string& filePath, bool binary, PackedElementType parameterType) {
+  // Parameters are referenced from the document as tensors: binary models store them raw,
+  // JSON models have them streamed in place of the references
+  ModelFileWriter writer(parameterType);
   nlohmann::ordered_json paramsJson;
-  paramsJson["weights"] = core.getParameters().weights;
-  paramsJson["biases"] = core.getParameters().biases;
+  paramsJson["weights"] = writer.addTensor(parameters.weights);
+  paramsJson["biases"] = writer.addTensor(parameters.biases);
   json["parameters"] = paramsJson;
 
-  // Write to file
-  QFile file(QString::fromStdString(filePath));
-  if (!file.open(QIODevice::WriteOnly)) {
-    throw std::runtime_error("Failed to open file for writing: " + filePath);
+  // Both formats go through a temporary file renamed into place, so a crash never leaves a partial model
+  if (binary) {
+    writer.write(filePath, json);
+  } else {
+    writer.writeJson(filePath, json);
   }
-  std::string jsonStr = json.dump(4);
-  file.write(jsonStr.c_str());
-  file.close();
 }
 
 //===================================================================================================================//
 
 void Runner::saveCNNModel(const CNN::Core<float>& core, const std::string& filePath,
-                           const IOConfig& ioConfig, ulong progressReports, ulong saveModelInterval) {
+                           const IOConfig& ioConfig, ulong progressReports, ulong saveModelInterval,
+                           bool binary, PackedElementType parameterType) {
+  writeCNNModel(cnnModelDocument(core, ioConfig, progressReports, saveModelInterval), core.getParameters(),
+                filePath, binary, parameterType);
+}
+
+//===================================================================================================================//
+
+nlohmann::ordered_json Runner::cnnModelDocument(const CNN::Core<float>& core, const IOConfig& ioConfig,
+                                                ulong progressReports, ulong saveModelInterval) {
   nlohmann::ordered_json json;
 
   json["mode"] = CNN::Mode::typeToName(core.getModeType());
@@ -827,51 +1842,58 @@ void Runner::saveCNNModel(const CNN::Core<float>& core, const std::string& fileP
   mdJson["finalLoss"] = md.finalLoss;
   json["trainingMetadata"] = mdJson;
 
-  // Parameters
+  return json;
+}
+
+//===================================================================================================================//
+
+void Runner::writeCNNModel(nlohmann::ordered_json json, const CNN::Parameters<float>& parameters,
+                            const std::string& filePath, bool binary, PackedElementType parameterType) {
+  // Parameters are referenced from the document as tensors: binary models store them raw,
+  // JSON models have them streamed in place of the references
+  ModelFileWriter writer(parameterType);
   nlohmann::ordered_json paramsJson;
 
   // Conv parameters
   nlohmann::ordered_json convArr = nlohmann::ordered_json::array();
-  for (const auto& cp : core.getParameters().convParams) {
+  for (const auto& cp : parameters.convParams) {
     nlohmann::ordered_json cpJson;
     cpJson["numFilters"] = cp.numFilters;
     cpJson["inputC"] = cp.inputC;
     cpJson["filterH"] = cp.filterH;
     cpJson["filterW"] = cp.filterW;
-    cpJson["filters"] = cp.filters;
-    cpJson["biases"] = cp.biases;
+    cpJson["filters"] = writer.addTensor(cp.filters);
+    cpJson["biases"] = writer.addTensor(cp.biases);
     convArr.push_back(cpJson);
   }
   paramsJson["convolutional"] = convArr;
 
   // Dense parameters
   nlohmann::ordered_json denseParamsJson;
-  denseParamsJson["weights"] = core.getParameters().denseParams.weights;
-  denseParamsJson["biases"] = core.getParameters().denseParams.biases;
+  denseParamsJson["weights"] = writer.addTensor(parameters.denseParams.weights);
+  denseParamsJson["biases"] = writer.addTensor(parameters.denseParams.biases);
   paramsJson["dense"] = denseParamsJson;
 
   json["parameters"] = paramsJson;
 
-  // Write to file
-  QFile file(QString::fromStdString(filePath));
-  if (!file.open(QIODevice::WriteOnly)) {
-    throw std::runtime_error("Failed to open file for writing: " + filePath);
+  // Both formats go through a temporary file renamed into place, so a crash never leaves a partial model
+  if (binary) {
+    writer.write(filePath, json);
+  } else {
+    writer.writeJson(filePath, json);
   }
-  std::string jsonStr = json.dump(4);
-  file.write(jsonStr.c_str());
-  file.close();
 }
 
 //===================================================================================================================//
 //  Output path helpers
 //===================================================================================================================//
 
-std::string Runner::generateTrainingFilename(ulong epochs, ulong samples, float loss) {
+std::string Runner::generateTrainingFilename(ulong epochs, ulong samples, float loss, const std::string& extension) {
   std::ostringstream oss;
   oss << "trained_E-" << epochs
       << "_S-" << samples
       << "_L-" << std::fixed << std::setprecision(6) << loss
-      << ".json";
+      << extension;
   return oss.str();
 }
 
@@ -881,7 +1903,8 @@ std::string Runner::generateDefaultOutputPath(
     const QString& inputFilePath,
     ulong epochs,
     ulong samples,
-    float loss) {
+    float loss,
+    const std::string& extension) {
   QFileInfo inputInfo(inputFilePath);
   QDir inputDir = inputInfo.absoluteDir();
   QDir outputDir(inputDir.filePath("output"));
@@ -890,7 +1913,7 @@ std::string Runner::generateDefaultOutputPath(
     inputDir.mkdir("output");
   }
 
-  QString outputPath = outputDir.filePath(QString::fromStdString(generateTrainingFilename(epochs, samples, loss)));
+  QString outputPath = outputDir.filePath(QString::fromStdString(generateTrainingFilename(epochs, samples, loss, extension)));
   return outputPath.toStdString();
 }
 
@@ -899,7 +1922,8 @@ std::string Runner::generateDefaultOutputPath(
 std::string Runner::generateCheckpointPath(
     const QString& inputFilePath,
     ulong epoch,
-    float loss) {
+    float loss,
+    const std::string& extension) {
   QFileInfo inputInfo(inputFilePath);
   QDir inputDir = inputInfo.absoluteDir();
   QDir outputDir(inputDir.filePath("output"));
@@ -911,7 +1935,7 @@ std::string Runner::generateCheckpointPath(
   std::ostringstream oss;
   oss << "checkpoint_E-" << epoch
       << "_L-" << std::fixed << std::setprecision(6) << loss
-      << ".json";
+      << extension;
 
   QString outputPath = outputDir.filePath(QString::fromStdString(oss.str()));
   return outputPath.toStdString();
@@ -929,6 +1953,8 @@ void Runner::setupANNTrainingCallback(const QString& inputFilePath) {
 
   static ProgressBar progressBar(this->progressReports);
 
+  this->checkpointWriter = std::make_unique<CheckpointWriter>(this->logLevel);
+
   this->annCore->setTrainingCallback([this, inputFilePath](const ANN::TrainingProgress<float>& progress) {
     if (this->logLevel > LogLevel::QUIET) {
       ProgressInfo info{progress.currentEpoch, progress.totalEpochs,
@@ -940,9 +1966,15 @@ void Runner::setupANNTrainingCallback(const QString& inputFilePath) {
 
     if (this->saveModelInterval > 0 && progress.currentEpoch > lastCallbackEpoch) {
       if (lastCallbackEpoch > 0 && lastCallbackEpoch % this->saveModelInterval == 0) {
-        std::string checkpointPath = generateCheckpointPath(inputFilePath, lastCallbackEpoch, lastEpochLoss);
-        saveANNModel(*this->annCore, checkpointPath, this->ioConfig, this->progressReports, this->saveModelInterval);
-        if (this->logLevel > LogLevel::QUIET) std::cout << "\nCheckpoint saved to: " << checkpointPath << "\n";
+        // Snapshot the model here; serialising and writing happen on the checkpoint writer's thread
+        std::string checkpointPath = generateCheckpointPath(inputFilePath, lastCallbackEpoch, lastEpochLoss, this->modelExtension());
+        nlohmann::ordered_json document = annModelDocument(*this->annCore, this->ioConfig, this->progressReports,
+                                                           this->saveModelInterval);
+        this->checkpointWriter->submit(checkpointPath,
+          [document = std::move(document), parameters = this->annCore->getParameters(), checkpointPath,
+           binary = this->binaryModels, parameterType = this->modelParameterType]() {
+            writeANNModel(document, parameters, checkpointPath, binary, parameterType);
+          });
       }
       lastCallbackEpoch = progress.currentEpoch;
     }
@@ -961,6 +1993,8 @@ void Runner::setupCNNTrainingCallback(const QString& inputFilePath) {
 
   static ProgressBar progressBar(this->progressReports);
 
+  this->checkpointWriter = std::make_unique<CheckpointWriter>(this->logLevel);
+
   this->cnnCore->setTrainingCallback([this, inputFilePath](const CNN::TrainingProgress<float>& progress) {
     if (this->logLevel > LogLevel::QUIET) {
       ProgressInfo info{progress.currentEpoch, progress.totalEpochs,
@@ -972,9 +2006,15 @@ void Runner::setupCNNTrainingCallback(const QString& inputFilePath) {
 
     if (this->saveModelInterval > 0 && progress.currentEpoch > lastCallbackEpoch) {
       if (lastCallbackEpoch > 0 && lastCallbackEpoch % this->saveModelInterval == 0) {
-        std::string checkpointPath = generateCheckpointPath(inputFilePath, lastCallbackEpoch, lastEpochLoss);
-        saveCNNModel(*this->cnnCore, checkpointPath, this->ioConfig, this->progressReports, this->saveModelInterval);
-        if (this->logLevel > LogLevel::QUIET) std::cout << "\nCheckpoint saved to: " << checkpointPath << "\n";
+        // Snapshot the model here; serialising and writing happen on the checkpoint writer's thread
+        std::string checkpointPath = generateCheckpointPath(inputFilePath, lastCallbackEpoch, lastEpochLoss, this->modelExtension());
+        nlohmann::ordered_json document = cnnModelDocument(*this->cnnCore, this->ioConfig, this->progressReports,
+                                                           this->saveModelInterval);
+        this->checkpointWriter->submit(checkpointPath,
+          [document = std::move(document), parameters = this->cnnCore->getParameters(), checkpointPath,
+           binary = this->binaryModels, parameterType = this->modelParameterType]() {
+            writeCNNModel(document, parameters, checkpointPath, binary, parameterType);
+          });
       }
       lastCallbackEpoch = progress.currentEpoch;
     }
@@ -988,6 +2028,9 @@ void Runner::setupCNNTrainingCallback(const QString& inputFilePath) {
 int Runner::finishANNTraining(const QString& inputFilePath) {
   if (this->logLevel > LogLevel::QUIET) std::cout << "\nTraining completed.\n";
 
+  // Let the last checkpoint finish before the final model is written
+  if (this->checkpointWriter) this->checkpointWriter->wait();
+
   const auto& trainingConfig = this->annCore->getTrainingConfig();
   const auto& trainingMetadata = this->annCore->getTrainingMetadata();
 
@@ -997,10 +2040,11 @@ int Runner::finishANNTraining(const QString& inputFilePath) {
   } else {
     outputPathStr = generateDefaultOutputPath(
       inputFilePath, trainingConfig.numEpochs,
-      trainingMetadata.numSamples, trainingMetadata.finalLoss);
+      trainingMetadata.numSamples, trainingMetadata.finalLoss, this->modelExtension());
   }
 
-  saveANNModel(*this->annCore, outputPathStr, this->ioConfig, this->progressReports, this->saveModelInterval);
+  saveANNModel(*this->annCore, outputPathStr, this->ioConfig, this->progressReports, this->saveModelInterval,
+               this->binaryModels, this->modelParameterType);
   if (this->logLevel > LogLevel::QUIET) std::cout << "Model saved to: " << outputPathStr << "\n";
   return 0;
 }
@@ -1010,6 +2054,9 @@ int Runner::finishANNTraining(const QString& inputFilePath) {
 int Runner::finishCNNTraining(const QString& inputFilePath) {
   if (this->logLevel > LogLevel::QUIET) std::cout << "\nTraining completed.\n";
 
+  // Let the last checkpoint finish before the final model is written
+  if (this->checkpointWriter) this->checkpointWriter->wait();
+
   const auto& trainingConfig = this->cnnCore->getTrainingConfig();
   const auto& trainingMetadata = this->cnnCore->getTrainingMetadata();
 
@@ -1019,10 +2066,11 @@ int Runner::finishCNNTraining(const QString& inputFilePath) {
   } else {
     outputPathStr = generateDefaultOutputPath(
       inputFilePath, trainingConfig.numEpochs,
-      trainingMetadata.numSamples, trainingMetadata.finalLoss);
+      trainingMetadata.numSamples, trainingMetadata.finalLoss, this->modelExtension());
   }
 
-  saveCNNModel(*this->cnnCore, outputPathStr, this->ioConfig, this->progressReports, this->saveModelInterval);
+  saveCNNModel(*this->cnnCore, outputPathStr, this->ioConfig, this->progressReports, this->saveModelInterval,
+               this->binaryModels, this->modelParameterType);
   if (this->logLevel > LogLevel::QUIET) std::cout << "Model saved to: " << outputPathStr << "\n";
   return 0;
 }
@@ -1,25 +1,37 @@
 #ifndef NN_CLI_RUNNER_HPP
 #define NN_CLI_RUNNER_HPP
 
+#include "NN-CLI_CheckpointWriter.hpp"
+#include "NN-CLI_ImageWriter.hpp"
 #include "NN-CLI_Loader.hpp"
 #include "NN-CLI_NetworkType.hpp"
 #include "NN-CLI_IOConfig.hpp"
 #include "NN-CLI_LogLevel.hpp"
+#include "NN-CLI_PackedDataset.hpp"
+#include "NN-CLI_PredictWriter.hpp"
 
 #include <ANN_Core.hpp>
 #include <CNN_Core.hpp>
 
 #include <QCommandLineParser>
 
+#include <json.hpp>
+
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 //===================================================================================================================//
 
 namespace NN_CLI {
 
+template <typename SampleT> class DataLoader;
+
 /**
- * Runner class handles the execution of ANN and CNN modes (train, test, predict).
+ * Runner class handles the execution of ANN and CNN modes (train, test, predict),
+ * dataset packing (pack), the inference server (serve), model conversion (convert) and model
+ * metadata (info).
  * Automatically detects network type from the config file and delegates to the
  * appropriate library.
  */
@@ -42,24 +54,100 @@ class Runner {
     int runCNNTest();
     int runCNNPredict();
 
+    //-- Parallel predict (--predict-threads) --//
+    template <typename InputT>
+    InputT toModelInput(std::vector<float>&& flatInput) const;
+    template <typename CoreT, typename ConfigT>
+    std::vector<std::unique_ptr<CoreT>> makePredictReplicas(std::unique_ptr<CoreT>& core, const ConfigT& coreConfig);
+    template <typename OutputT, typename CoreT, typename InputT>
+    std::vector<OutputT> predictInOrder(CoreT& core, const std::vector<std::unique_ptr<CoreT>>& replicas,
+                                        const std::vector<InputT>& inputs, bool reportEach,
+                                        const std::function<void(ulong, OutputT&)>& onOutput = nullptr);
+
+    //-- Image outputs (encoded on worker threads while predict runs) --//
+    std::unique_ptr<ImageWriter> makeImageWriter(const QString& outputDir) const;
+
+    //-- Predict results (--output-format) --//
+    PredictOutputFormat predictOutputFormat(PredictOutputFormat defaultFormat) const;
+    int writePredictOutputs(const QString& outputPath, PredictOutputFormat format,
+                            const std::vector<std::vector<float>>& outputs,
+                            const nlohmann::ordered_json& predictMetadata);
+
+    //-- Streaming predict (JSON Lines input) --//
+    template <typename InputT, typename CoreT, typename ConfigT>
+    int runStreamingPredict(std::unique_ptr<CoreT>& core, const ConfigT& coreConfig,
+                            int inputC, int inputH, int inputW);
+
+    //-- Dataset packing (--mode pack) --//
+    int runPack();
+
+    //-- Inference server (--mode serve) --//
+    int runServe();
+    template <typename InputT, typename CoreT, typename ConfigT>
+    int serveModel(std::unique_ptr<CoreT>& core, const ConfigT& coreConfig);
+
+    //-- Model conversion (--mode convert) --//
+    int runConvert();
+
+    //-- Model metadata (--mode info) --//
+    int runInfo();
+
     //-- Sample loading --//
+    bool checkSampleSources() const;
     std::pair<ANN::Samples<float>, bool> loadANNSamplesFromOptions(
       const std::string& modeName, QString& inputFilePath);
     std::pair<CNN::Samples<float>, bool> loadCNNSamplesFromOptions(
       const std::string& modeName, QString& inputFilePath);
+    template <typename SampleT>
+    void loadIDXIntoDataLoader(DataLoader<SampleT>& dataLoader, const std::string& modeName,
+                               int inputC, int inputH, int inputW);
+    template <typename SampleT>
+    void loadNpyIntoDataLoader(DataLoader<SampleT>& dataLoader, const std::string& modeName,
+                               int inputC, int inputH, int inputW);
+    template <typename SampleT>
+    void loadShardsIntoDataLoader(DataLoader<SampleT>& dataLoader, const std::string& modeName,
+                                  int inputC, int inputH, int inputW, ulong shuffleBufferSize,
+                                  bool streamed = true);
+    template <typename SampleT>
+    bool loadTestSamplesIntoDataLoader(DataLoader<SampleT>& dataLoader, int inputC, int inputH, int inputW);
+    template <typename SampleT>
+    void makeSamplesResident(DataLoader<SampleT>& dataLoader);
+    template <typename SampleT>
+    void enableSampleCache(DataLoader<SampleT>& dataLoader);
+    template <typename SampleT>
+    void printSampleCacheStats(const DataLoader<SampleT>& dataLoader);
+
+    //-- Evaluation --//
+    template <typename ResultT, typename CoreT, typename SampleT>
+    ResultT testInBatches(CoreT& core, const DataLoader<SampleT>& dataLoader);
 
     //-- Model saving --//
     static void saveANNModel(const ANN::Core<float>& core, const std::string& filePath,
-                              const IOConfig& ioConfig, ulong progressReports, ulong saveModelInterval);
+                              const IOConfig& ioConfig, ulong progressReports, ulong saveModelInterval,
+                              bool binary, PackedElementType parameterType);
     static void saveCNNModel(const CNN::Core<float>& core, const std::string& filePath,
-                              const IOConfig& ioConfig, ulong progressReports, ulong saveModelInterval);
+                              const IOConfig& ioConfig, ulong progressReports, ulong saveModelInterval,
+                              bool binary, PackedElementType parameterType);
+
+    // Everything but the parameters; cheap enough to build inside the training callback
+    static nlohmann::ordered_json annModelDocument(const ANN::Core<float>& core, const IOConfig& ioConfig,
+                                                   ulong progressReports, ulong saveModelInterval);
+    static nlohmann::ordered_json cnnModelDocument(const CNN::Core<float>& core, const IOConfig& ioConfig,
+                                                   ulong progressReports, ulong saveModelInterval);
+
+    // Add the parameters to a model document and write it (safe to call from any thread)
+    static void writeANNModel(nlohmann::ordered_json json, const ANN::Parameters<float>& parameters,
+                               const std::string& filePath, bool binary, PackedElementType parameterType);
+    static void writeCNNModel(nlohmann::ordered_json json, const CNN::Parameters<float>& parameters,
+                               const std::string& filePath, bool binary, PackedElementType parameterType);
 
     //-- Output path helpers --//
-    static std::string generateTrainingFilename(ulong epochs, ulong samples, float loss);
+    static std::string generateTrainingFilename(ulong epochs, ulong samples, float loss, const std::string& extension);
     static std::string generateDefaultOutputPath(
-      const QString& inputFilePath, ulong epochs, ulong samples, float loss);
+      const QString& inputFilePath, ulong epochs, ulong samples, float loss, const std::string& extension);
     static std::string generateCheckpointPath(
-      const QString& inputFilePath, ulong epoch, float loss);
+      const QString& inputFilePath, ulong epoch, float loss, const std::string& extension);
+    std::string modelExtension() const { return this->binaryModels ? ".nnmodel" : ".json"; }
 
     //-- Training helpers --//
     void setupANNTrainingCallback(const QString& inputFilePath);
@@ -74,10 +162,12 @@ class Runner {
     const QCommandLineParser& parser;
     LogLevel logLevel;
     NetworkType networkType;
-    std::string mode;  // "train", "test", "predict"
+    std::string mode;  // "train", "test", "predict", "pack", "serve", "convert", "info"
     IOConfig ioConfig;  // inputType / outputType / shapes (NN-CLI concept only)
     ulong progressReports = 1000;  // NN-CLI display frequency (not used by ANN/CNN libs)
     ulong saveModelInterval = 10;  // 0 = disabled
+    bool binaryModels = false;  // Save trained models and checkpoints as .nnmodel files
+    PackedElementType modelParameterType = PackedElementType::FLOAT32;  // Parameter encoding in .nnmodel files
 
     //-- Data augmentation config (parsed from trainingConfig, handled by NN-CLI only) --//
     ulong augmentationFactor = 0;       // 0 = disabled; N = N× total samples per class
@@ -93,6 +183,9 @@ class Runner {
     //-- CNN members --//
     std::unique_ptr<CNN::Core<float>> cnnCore;
     CNN::CoreConfig<float> cnnCoreConfig;
+
+    //-- Training checkpoints (written in the background) --//
+    std::unique_ptr<CheckpointWriter> checkpointWriter;
 };
 
 } // namespace NN_CLI
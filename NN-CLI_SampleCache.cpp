@@ -0,0 +1,102 @@
+#include "NN-CLI_SampleCache.hpp"
+
+namespace NN_CLI {
+
+//===================================================================================================================//
+
+template <typename SampleT>
+SampleCache<SampleT>::SampleCache(size_t byteBudget) : byteBudget(byteBudget) {}
+
+//===================================================================================================================//
+
+// Payload plus the sample struct itself (list/map node overhead is ignored)
+template <>
+size_t SampleCache<ANN::Sample<float>>::sampleBytes(const ANN::Sample<float>& sample) {
+  return (sample.input.size() + sample.output.size()) * sizeof(float) + sizeof(ANN::Sample<float>);
+}
+
+template <>
+size_t SampleCache<CNN::Sample<float>>::sampleBytes(const CNN::Sample<float>& sample) {
+  return (sample.input.data.size() + sample.output.size()) * sizeof(float) + sizeof(CNN::Sample<float>);
+}
+
+//===================================================================================================================//
+
+template <typename SampleT>
+bool SampleCache<SampleT>::get(ulong key, SampleT& sample) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  auto it = this->index.find(key);
+  if (it == this->index.end()) {
+    this->misses++;
+    return false;
+  }
+
+  // Move to the front (most recently used)
+  this->entries.splice(this->entries.begin(), this->entries, it->second);
+  sample = it->second->second; // copy
+  this->hits++;
+  return true;
+}
+
+//===================================================================================================================//
+
+template <typename SampleT>
+void SampleCache<SampleT>::put(ulong key, const SampleT& sample) {
+  size_t bytes = sampleBytes(sample);
+  if (bytes > this->byteBudget) return;
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  // Another thread may have decoded the same sample concurrently
+  auto it = this->index.find(key);
+  if (it != this->index.end()) {
+    this->bytesUsed -= sampleBytes(it->second->second);
+    this->entries.erase(it->second);
+    this->index.erase(it);
+  }
+
+  while (this->bytesUsed + bytes > this->byteBudget && !this->entries.empty()) {
+    const Entry& last = this->entries.back();
+    this->bytesUsed -= sampleBytes(last.second);
+    this->index.erase(last.first);
+    this->entries.pop_back();
+  }
+
+  this->entries.emplace_front(key, sample);
+  this->index[key] = this->entries.begin();
+  this->bytesUsed += bytes;
+}
+
+//===================================================================================================================//
+
+template <typename SampleT>
+size_t SampleCache<SampleT>::getBytesUsed() const {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->bytesUsed;
+}
+
+//===================================================================================================================//
+
+template <typename SampleT>
+ulong SampleCache<SampleT>::getHits() const {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->hits;
+}
+
+//===================================================================================================================//
+
+template <typename SampleT>
+ulong SampleCache<SampleT>::getMisses() const {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->misses;
+}
+
+//===================================================================================================================//
+//-- Explicit template instantiations --//
+//===================================================================================================================//
+
+template class SampleCache<ANN::Sample<float>>;
+template class SampleCache<CNN::Sample<float>>;
+
+} // namespace NN_CLI
@@ -0,0 +1,59 @@
+#ifndef NN_CLI_SAMPLECACHE_HPP
+#define NN_CLI_SAMPLECACHE_HPP
+
+#include <ANN_Sample.hpp>
+#include <CNN_Sample.hpp>
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include <sys/types.h>
+
+//===================================================================================================================//
+
+namespace NN_CLI {
+
+/**
+ * SampleCache: byte-budgeted LRU cache of decoded (non-augmented) samples.
+ *
+ * Keys are original sample indices. get() hands out a copy, so callers may augment
+ * the result in place without touching the cached base tensor. Samples larger than
+ * the whole budget are never cached. All methods are thread-safe.
+ */
+template <typename SampleT>
+class SampleCache {
+  public:
+    explicit SampleCache(size_t byteBudget);
+
+    // Copy the cached sample for `key` into `sample`. Returns false on a miss.
+    bool get(ulong key, SampleT& sample);
+
+    // Insert (or refresh) a sample, evicting least recently used entries to stay within budget.
+    void put(ulong key, const SampleT& sample);
+
+    size_t getByteBudget() const { return this->byteBudget; }
+    size_t getBytesUsed() const;
+    ulong getHits() const;
+    ulong getMisses() const;
+
+  private:
+    using Entry = std::pair<ulong, SampleT>;
+
+    size_t byteBudget;
+    size_t bytesUsed = 0;
+    ulong hits = 0;
+    ulong misses = 0;
+    std::list<Entry> entries;  // Most recently used first
+    std::unordered_map<ulong, typename std::list<Entry>::iterator> index;
+    mutable std::mutex mutex;
+
+    static size_t sampleBytes(const SampleT& sample);
+};
+
+} // namespace NN_CLI
+
+//===================================================================================================================//
+
+#endif // NN_CLI_SAMPLECACHE_HPP
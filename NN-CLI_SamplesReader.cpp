@@ -0,0 +1,448 @@
+#include "NN-CLI_SamplesReader.hpp"
+
+#include <QFile>
+
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace NN_CLI {
+
+//===================================================================================================================//
+//-- Scanning helpers --//
+//===================================================================================================================//
+
+static bool isWhitespace(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+//===================================================================================================================//
+
+static void skipWhitespace(const char*& p, const char* end) {
+  while (p < end && isWhitespace(*p)) p++;
+}
+
+//===================================================================================================================//
+
+// Advance past a string starting at the opening quote. Returns false if it is unterminated.
+static bool skipString(const char*& p, const char* end) {
+  for (p++; p < end; p++) {
+    if (*p == '\\') {
+      p++;
+    } else if (*p == '"') {
+      p++;
+      return true;
+    }
+  }
+  return false;
+}
+
+//===================================================================================================================//
+
+// Advance past any JSON value without decoding it. Returns false on unbalanced or truncated input.
+static bool skipValue(const char*& p, const char* end) {
+  if (p >= end) return false;
+
+  if (*p == '"') return skipString(p, end);
+
+  if (*p == '{' || *p == '[') {
+    ulong depth = 0;
+    while (p < end) {
+      char c = *p;
+      if (c == '"') {
+        if (!skipString(p, end)) return false;
+        continue;
+      }
+      if (c == '{' || c == '[') {
+        depth++;
+      } else if (c == '}' || c == ']') {
+        if (--depth == 0) {
+          p++;
+          return true;
+        }
+      }
+      p++;
+    }
+    return false;
+  }
+
+  // Scalar: number, true, false or null
+  const char* start = p;
+  while (p < end && *p != ',' && *p != ']' && *p != '}' && !isWhitespace(*p)) p++;
+  return p > start;
+}
+
+//===================================================================================================================//
+
+static void appendUtf8(std::string& out, uint32_t codePoint) {
+  if (codePoint < 0x80) {
+    out.push_back(static_cast<char>(codePoint));
+  } else if (codePoint < 0x800) {
+    out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+    out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  } else if (codePoint < 0x10000) {
+    out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+    out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  } else {
+    out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+    out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  }
+}
+
+//===================================================================================================================//
+
+static bool parseHex4(const char*& p, const char* end, uint32_t& value) {
+  if (end - p < 4) return false;
+  value = 0;
+  for (int i = 0; i < 4; i++, p++) {
+    char c = *p;
+    value <<= 4;
+    if (c >= '0' && c <= '9') value |= static_cast<uint32_t>(c - '0');
+    else if (c >= 'a' && c <= 'f') value |= static_cast<uint32_t>(c - 'a' + 10);
+    else if (c >= 'A' && c <= 'F') value |= static_cast<uint32_t>(c - 'A' + 10);
+    else return false;
+  }
+  return true;
+}
+
+//===================================================================================================================//
+
+[[noreturn]] static void throwParseError(const std::string& message, const char* at,
+                                         const char* base, const std::string& sourceName) {
+  throw std::runtime_error(message + " at byte " + std::to_string(at - base) + " in: " + sourceName);
+}
+
+//===================================================================================================================//
+//-- SamplesReader --//
+//===================================================================================================================//
+
+SamplesReader::SamplesReader(const std::string& filePath, const std::string& description)
+    : sourceName(filePath) {
+  this->file = std::make_unique<QFile>(QString::fromStdString(filePath));
+
+  if (!this->file->open(QIODevice::ReadOnly)) {
+    throw std::runtime_error("Failed to open " + description + " file: " + filePath);
+  }
+
+  qint64 fileSize = this->file->size();
+  if (fileSize == 0) {
+    throw std::runtime_error("Empty " + description + " file: " + filePath);
+  }
+
+  const unsigned char* mapped = this->file->map(0, fileSize);
+  if (!mapped) {
+    throw std::runtime_error("Failed to memory-map " + description + " file: " + filePath);
+  }
+
+  this->begin = reinterpret_cast<const char*>(mapped);
+  this->end = this->begin + fileSize;
+}
+
+//===================================================================================================================//
+
+SamplesReader::SamplesReader(const char* begin, const char* end, const std::string& sourceName)
+    : sourceName(sourceName), begin(begin), end(end) {}
+
+//===================================================================================================================//
+
+SamplesReader::~SamplesReader() = default;
+
+//===================================================================================================================//
+
+void SamplesReader::fail(const std::string& message, const char* at) const {
+  throwParseError(message, at, this->begin, this->sourceName);
+}
+
+//===================================================================================================================//
+
+ulong SamplesReader::openArray(const std::string& key) {
+  const char* p = this->begin;
+  const char* end = this->end;
+
+  // Tolerate a UTF-8 byte order mark
+  if (end - p >= 3 && std::memcmp(p, "\xEF\xBB\xBF", 3) == 0) p += 3;
+
+  skipWhitespace(p, end);
+  if (p >= end || *p != '{') this->fail("Expected a JSON object", p);
+  p++;
+
+  this->elements.clear();
+
+  for (;;) {
+    skipWhitespace(p, end);
+    if (p < end && *p == '}') break;
+    if (p >= end || *p != '"') this->fail("Expected an object key", p);
+
+    const char* keyStart = p + 1;
+    if (!skipString(p, end)) this->fail("Unterminated string", keyStart - 1);
+    bool matches = static_cast<size_t>(p - 1 - keyStart) == key.size() &&
+                   std::memcmp(keyStart, key.data(), key.size()) == 0;
+
+    skipWhitespace(p, end);
+    if (p >= end || *p != ':') this->fail("Expected ':'", p);
+    p++;
+    skipWhitespace(p, end);
+
+    if (matches) {
+      if (p >= end || *p != '[') this->fail("'" + key + "' must be an array", p);
+      p++;
+
+      skipWhitespace(p, end);
+      if (p < end && *p == ']') return 0;
+
+      for (;;) {
+        skipWhitespace(p, end);
+        const char* elementStart = p;
+        if (!skipValue(p, end)) this->fail("Malformed array element", elementStart);
+        this->elements.emplace_back(elementStart, p);
+
+        skipWhitespace(p, end);
+        if (p < end && *p == ',') {
+          p++;
+          continue;
+        }
+        if (p < end && *p == ']') break;
+        this->fail("Expected ',' or ']'", p);
+      }
+
+      return this->elements.size();
+    }
+
+    const char* valueStart = p;
+    if (!skipValue(p, end)) this->fail("Malformed value", valueStart);
+
+    skipWhitespace(p, end);
+    if (p < end && *p == ',') {
+      p++;
+      continue;
+    }
+    if (p < end && *p == '}') break;
+    this->fail("Expected ',' or '}'", p);
+  }
+
+  throw std::runtime_error("Missing '" + key + "' in: " + this->sourceName);
+}
+
+//===================================================================================================================//
+//-- Element parsing --//
+//===================================================================================================================//
+
+namespace {
+
+// Recursive-descent parser over one element's byte range. Only the shapes samples files use are accepted:
+// strings (image paths) and flat numeric arrays, wrapped in an object for samples.
+struct ElementParser {
+  const char* p;
+  const char* end;
+  const char* base;
+  const std::string& sourceName;
+
+  [[noreturn]] void fail(const std::string& message, const char* at) const {
+    throwParseError(message, at, this->base, this->sourceName);
+  }
+
+  void parseString(std::string& out) {
+    // Caller guarantees *p == '"'
+    const char* start = ++this->p;
+    out.clear();
+
+    // Fast path: no escapes
+    while (this->p < this->end && *this->p != '"' && *this->p != '\\') this->p++;
+    out.append(start, this->p);
+
+    while (this->p < this->end && *this->p != '"') {
+      if (*this->p != '\\') {
+        out.push_back(*this->p++);
+        continue;
+      }
+
+      if (++this->p >= this->end) break;
+      char c = *this->p++;
+      switch (c) {
+        case '"':  out.push_back('"'); break;
+        case '\\': out.push_back('\\'); break;
+        case '/':  out.push_back('/'); break;
+        case 'b':  out.push_back('\b'); break;
+        case 'f':  out.push_back('\f'); break;
+        case 'n':  out.push_back('\n'); break;
+        case 'r':  out.push_back('\r'); break;
+        case 't':  out.push_back('\t'); break;
+        case 'u': {
+          uint32_t codePoint;
+          if (!parseHex4(this->p, this->end, codePoint)) this->fail("Invalid \\u escape", this->p);
+
+          if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+            uint32_t low;
+            if (this->end - this->p < 2 || this->p[0] != '\\' || this->p[1] != 'u') {
+              this->fail("Unpaired surrogate in \\u escape", this->p);
+            }
+            this->p += 2;
+            if (!parseHex4(this->p, this->end, low) || low < 0xDC00 || low > 0xDFFF) {
+              this->fail("Invalid surrogate pair in \\u escape", this->p);
+            }
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+          }
+
+          appendUtf8(out, codePoint);
+          break;
+        }
+        default:
+          this->fail("Invalid escape sequence", this->p - 1);
+      }
+    }
+
+    if (this->p >= this->end) this->fail("Unterminated string", start - 1);
+    this->p++;
+  }
+
+  void parseNumberArray(std::vector<float>& out) {
+    // Caller guarantees *p == '['
+    this->p++;
+    out.clear();
+
+    skipWhitespace(this->p, this->end);
+    if (this->p < this->end && *this->p == ']') {
+      this->p++;
+      return;
+    }
+
+    for (;;) {
+      skipWhitespace(this->p, this->end);
+
+      // Parse as double and narrow, matching nlohmann's get<std::vector<float>>() bit for bit
+      double value;
+      auto [next, ec] = std::from_chars(this->p, this->end, value);
+      if (ec != std::errc() || next == this->p) {
+        this->fail("Expected a number (arrays must be flat and numeric)", this->p);
+      }
+      this->p = next;
+      out.push_back(static_cast<float>(value));
+
+      skipWhitespace(this->p, this->end);
+      if (this->p < this->end && *this->p == ',') {
+        this->p++;
+        continue;
+      }
+      if (this->p < this->end && *this->p == ']') {
+        this->p++;
+        return;
+      }
+      this->fail("Expected ',' or ']'", this->p);
+    }
+  }
+
+  void parseValue(StreamedValue& value) {
+    skipWhitespace(this->p, this->end);
+    if (this->p < this->end && *this->p == '"') {
+      value.isPath = true;
+      this->parseString(value.path);
+    } else if (this->p < this->end && *this->p == '[') {
+      value.isPath = false;
+      this->parseNumberArray(value.data);
+    } else {
+      this->fail("Expected an image path string or a numeric array", this->p);
+    }
+  }
+};
+
+} // namespace
+
+//===================================================================================================================//
+
+StreamedSample SamplesReader::readSample(ulong index) const {
+  const auto& [first, last] = this->elements.at(index);
+  ElementParser parser{first, last, this->begin, this->sourceName};
+
+  if (*parser.p != '{') this->fail("Sample " + std::to_string(index) + " must be an object", parser.p);
+  parser.p++;
+
+  StreamedSample sample;
+  bool hasInput = false, hasOutput = false;
+  std::string key;
+
+  skipWhitespace(parser.p, last);
+  if (parser.p < last && *parser.p == '}') parser.p++;
+  else {
+    for (;;) {
+      skipWhitespace(parser.p, last);
+      if (parser.p >= last || *parser.p != '"') this->fail("Expected an object key", parser.p);
+      parser.parseString(key);
+
+      skipWhitespace(parser.p, last);
+      if (parser.p >= last || *parser.p != ':') this->fail("Expected ':'", parser.p);
+      parser.p++;
+
+      if (key == "input") {
+        parser.parseValue(sample.input);
+        hasInput = true;
+      } else if (key == "output") {
+        parser.parseValue(sample.output);
+        hasOutput = true;
+      } else {
+        skipWhitespace(parser.p, last);
+        skipValue(parser.p, last);
+      }
+
+      skipWhitespace(parser.p, last);
+      if (parser.p < last && *parser.p == ',') {
+        parser.p++;
+        continue;
+      }
+      if (parser.p < last && *parser.p == '}') break;
+      this->fail("Expected ',' or '}'", parser.p);
+    }
+  }
+
+  if (!hasInput || !hasOutput) {
+    throw std::runtime_error("Sample " + std::to_string(index) + " is missing '" + (hasInput ? "output" : "input") +
+                             "' in: " + this->sourceName);
+  }
+
+  return sample;
+}
+
+//===================================================================================================================//
+
+StreamedValue SamplesReader::readValue(ulong index) const {
+  const auto& [first, last] = this->elements.at(index);
+  ElementParser parser{first, last, this->begin, this->sourceName};
+
+  StreamedValue value;
+  parser.parseValue(value);
+  return value;
+}
+
+//===================================================================================================================//
+
+StreamedValue SamplesReader::parseValue(const char* first, const char* last, const std::string& sourceName) {
+  ElementParser parser{first, last, first, sourceName};
+
+  StreamedValue value;
+  parser.parseValue(value);
+
+  skipWhitespace(parser.p, last);
+  if (parser.p < last) parser.fail("Unexpected characters after value", parser.p);
+
+  return value;
+}
+
+//===================================================================================================================//
+
+std::string SamplesReader::takePath(StreamedValue& value, const std::string& field) {
+  if (!value.isPath) throw std::runtime_error("Expected an image path string for '" + field + "'");
+  return std::move(value.path);
+}
+
+//===================================================================================================================//
+
+std::vector<float> SamplesReader::takeData(StreamedValue& value, const std::string& field) {
+  if (value.isPath) throw std::runtime_error("Expected a numeric array for '" + field + "'");
+  return std::move(value.data);
+}
+
+//===================================================================================================================//
+
+} // namespace NN_CLI
@@ -0,0 +1,80 @@
+#ifndef NN_CLI_SAMPLESREADER_HPP
+#define NN_CLI_SAMPLESREADER_HPP
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/types.h>
+
+class QFile;
+
+//===================================================================================================================//
+
+namespace NN_CLI {
+
+// A sample input/output as written in JSON: either an image path string or a flat numeric array.
+struct StreamedValue {
+  bool isPath = false;
+  std::string path;
+  std::vector<float> data;
+};
+
+// One element of a "samples" array.
+struct StreamedSample {
+  StreamedValue input;
+  StreamedValue output;
+};
+
+/**
+ * SamplesReader: DOM-free reader for samples/inputs JSON files.
+ *
+ * The file is memory-mapped and a structural scan indexes the byte range of every element
+ * of one top-level array ("samples" or "inputs"). Elements are then parsed on demand,
+ * straight into StreamedSample/StreamedValue, with numbers converted by std::from_chars.
+ * Peak memory is the mapping (file-backed, reclaimable) plus whatever the caller keeps.
+ *
+ * readSample()/readValue() are const and may be called concurrently for different indices.
+ */
+class SamplesReader {
+  public:
+    // `description` names the file kind in error messages ("samples", "input").
+    explicit SamplesReader(const std::string& filePath, const std::string& description = "samples");
+    SamplesReader(const char* begin, const char* end, const std::string& sourceName);
+    ~SamplesReader();
+
+    // Index the elements of the top-level array under `key`. Returns the element count.
+    // Throws if the key is missing or its value is not an array.
+    ulong openArray(const std::string& key);
+
+    ulong size() const { return this->elements.size(); }
+
+    // Parse element `index` as {"input": ..., "output": ...}.
+    StreamedSample readSample(ulong index) const;
+
+    // Parse element `index` as a path string or a flat numeric array.
+    StreamedValue readValue(ulong index) const;
+
+    // Parse one standalone value (e.g. a JSON Lines record) spanning [first, last), surrounding whitespace allowed.
+    static StreamedValue parseValue(const char* first, const char* last, const std::string& sourceName);
+
+    // Move the path/array out of a value, throwing if it holds the other kind. `field` names it in the error.
+    static std::string takePath(StreamedValue& value, const std::string& field);
+    static std::vector<float> takeData(StreamedValue& value, const std::string& field);
+
+  private:
+    std::string sourceName;
+    std::unique_ptr<QFile> file;
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    std::vector<std::pair<const char*, const char*>> elements;
+
+    [[noreturn]] void fail(const std::string& message, const char* at) const;
+};
+
+} // namespace NN_CLI
+
+//===================================================================================================================//
+
+#endif // NN_CLI_SAMPLESREADER_HPP
@@ -0,0 +1,349 @@
+#include "NN-CLI_Server.hpp"
+#include "NN-CLI_SamplesReader.hpp"
+
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <json.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+namespace NN_CLI {
+
+//===================================================================================================================//
+
+// Threads in the connection handler pool, i.e. the most connections served at once. Further accepted
+// connections wait for a free handler.
+static const int maxConnections = 256;
+
+//===================================================================================================================//
+
+// accept() errors that concern one pending connection or a passing shortage, not the listening socket. Linux also
+// reports network errors already pending on the new connection here.
+static bool isTransientAcceptError(int error) {
+  switch (error) {
+    case EINTR: case EAGAIN: case ECONNABORTED: case EPROTO: case EPERM:
+    case EMFILE: case ENFILE: case ENOBUFS: case ENOMEM:
+    case ENETDOWN: case ENETUNREACH: case ENONET: case EHOSTDOWN: case EHOSTUNREACH: case ENOPROTOOPT: case EOPNOTSUPP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+//===================================================================================================================//
+
+// Read exactly `size` bytes. Returns false if the peer closed the connection (or it was shut down) first.
+static bool readFully(int fd, void* dst, size_t size) {
+  unsigned char* p = static_cast<unsigned char*>(dst);
+  while (size > 0) {
+    ssize_t n = ::recv(fd, p, size, 0);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    p += n;
+    size -= static_cast<size_t>(n);
+  }
+  return true;
+}
+
+//===================================================================================================================//
+
+static bool writeFully(int fd, const void* src, size_t size) {
+  const unsigned char* p = static_cast<const unsigned char*>(src);
+  while (size > 0) {
+    ssize_t n = ::send(fd, p, size, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    p += n;
+    size -= static_cast<size_t>(n);
+  }
+  return true;
+}
+
+//===================================================================================================================//
+
+static bool writeFrame(int fd, FrameFormat format, const std::vector<unsigned char>& payload) {
+  uint32_t size = static_cast<uint32_t>(payload.size());
+  unsigned char header[5] = {static_cast<unsigned char>(format),
+                             static_cast<unsigned char>(size), static_cast<unsigned char>(size >> 8),
+                             static_cast<unsigned char>(size >> 16), static_cast<unsigned char>(size >> 24)};
+  return writeFully(fd, header, sizeof(header)) && writeFully(fd, payload.data(), payload.size());
+}
+
+//===================================================================================================================//
+
+static std::vector<unsigned char> toBytes(const std::string& text) {
+  return std::vector<unsigned char>(text.begin(), text.end());
+}
+
+//===================================================================================================================//
+
+Server::Server(ulong numWorkers, Predictor predictor, LogLevel logLevel)
+    : numWorkers(std::max(numWorkers, static_cast<ulong>(1))), predictor(std::move(predictor)), logLevel(logLevel) {
+  this->freeWorkers.resize(this->numWorkers);
+  std::iota(this->freeWorkers.begin(), this->freeWorkers.end(), 0);
+}
+
+Server::~Server() {
+  if (this->listenFd >= 0) ::close(this->listenFd);
+  if (!this->socketPath.empty()) ::unlink(this->socketPath.c_str());
+}
+
+//===================================================================================================================//
+
+void Server::listenUnix(const std::string& socketPath) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (socketPath.size() >= sizeof(address.sun_path)) {
+    throw std::runtime_error("Socket path is too long: " + socketPath);
+  }
+  std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+  this->listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (this->listenFd < 0) {
+    throw std::runtime_error("Failed to create socket: " + std::string(std::strerror(errno)));
+  }
+
+  // Replace a socket left behind by a server that did not shut down cleanly, but never any other file
+  struct stat existing;
+  if (::lstat(socketPath.c_str(), &existing) == 0) {
+    if (!S_ISSOCK(existing.st_mode)) {
+      throw std::runtime_error("Failed to listen on " + socketPath + ": path exists and is not a socket");
+    }
+    ::unlink(socketPath.c_str());
+  }
+
+  if (::bind(this->listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+      ::listen(this->listenFd, SOMAXCONN) < 0) {
+    throw std::runtime_error("Failed to listen on " + socketPath + ": " + std::strerror(errno));
+  }
+  this->socketPath = socketPath;
+}
+
+//===================================================================================================================//
+
+void Server::listenTcp(uint16_t port) {
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK); // Local clients only
+
+  this->listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (this->listenFd < 0) {
+    throw std::runtime_error("Failed to create socket: " + std::string(std::strerror(errno)));
+  }
+
+  int reuse = 1;
+  ::setsockopt(this->listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  if (::bind(this->listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+      ::listen(this->listenFd, SOMAXCONN) < 0) {
+    throw std::runtime_error("Failed to listen on 127.0.0.1:" + std::to_string(port) + ": " + std::strerror(errno));
+  }
+}
+
+//===================================================================================================================//
+
+bool Server::run() {
+  if (this->listenFd < 0) throw std::runtime_error("Server is not listening");
+
+  QThreadPool connectionPool;
+  connectionPool.setMaxThreadCount(maxConnections);
+  QVector<QFuture<void>> handlers;
+
+  while (!this->stopping) {
+    int fd = ::accept(this->listenFd, nullptr, nullptr);
+    if (fd < 0) {
+      int errorCode = errno;
+      if (this->stopping) break; // Listening socket shut down by stop()
+      if (isTransientAcceptError(errorCode)) {
+        // Out of descriptors or memory: give open connections a moment to release some before retrying
+        if (errorCode == EMFILE || errorCode == ENFILE || errorCode == ENOBUFS || errorCode == ENOMEM) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        continue;
+      }
+      this->error = "Failed to accept connection: " + std::string(std::strerror(errorCode));
+      break;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(this->connectionMutex);
+      if (this->stopping) {
+        ::close(fd);
+        break;
+      }
+      this->connections.insert(fd);
+    }
+
+    handlers.erase(std::remove_if(handlers.begin(), handlers.end(),
+                                  [](const QFuture<void>& handler) { return handler.isFinished(); }),
+                   handlers.end());
+    handlers.append(QtConcurrent::run(&connectionPool, [this, fd]() { this->serveConnection(fd); }));
+  }
+
+  // Connections still open are shut down by stop(); wait for their handlers to finish
+  this->stop();
+  {
+    std::unique_lock<std::mutex> lock(this->connectionMutex);
+    this->connectionsClosed.wait(lock, [this]() { return this->connections.empty(); });
+  }
+  for (auto& handler : handlers) handler.waitForFinished();
+
+  if (this->logLevel >= LogLevel::INFO && this->numRequests > 0) {
+    std::cout << "Served " << this->numRequests << " request(s), latency mean "
+              << std::fixed << std::setprecision(3) << this->totalLatencyMs / static_cast<double>(this->numRequests)
+              << " ms, max " << this->maxLatencyMs << " ms\n";
+    std::cout.unsetf(std::ios_base::floatfield);
+  }
+
+  return this->error.empty();
+}
+
+//===================================================================================================================//
+
+void Server::interrupt() {
+  this->stopping = true;
+  if (this->listenFd >= 0) ::shutdown(this->listenFd, SHUT_RDWR);
+}
+
+//===================================================================================================================//
+
+void Server::stop() {
+  this->interrupt();
+
+  // A connection being accepted concurrently sees `stopping` and is closed by run() instead
+  std::lock_guard<std::mutex> lock(this->connectionMutex);
+  for (int fd : this->connections) ::shutdown(fd, SHUT_RDWR);
+}
+
+//===================================================================================================================//
+
+void Server::serveConnection(int fd) {
+  for (;;) {
+    unsigned char header[5];
+    if (!readFully(fd, header, sizeof(header))) break;
+
+    FrameFormat format = static_cast<FrameFormat>(header[0]);
+    uint32_t size = static_cast<uint32_t>(header[1]) | static_cast<uint32_t>(header[2]) << 8 |
+                    static_cast<uint32_t>(header[3]) << 16 | static_cast<uint32_t>(header[4]) << 24;
+
+    // An oversized or unknown frame leaves the stream unsynchronised: answer and drop the connection
+    if (size > maxPayloadSize || (format != FrameFormat::FLOAT32 && format != FrameFormat::JSON)) {
+      writeFrame(fd, FrameFormat::ERROR, toBytes(size > maxPayloadSize ? "Request payload is too large"
+                                                                       : "Unknown request format"));
+      break;
+    }
+
+    std::vector<unsigned char> payload(size);
+    if (!readFully(fd, payload.data(), size)) break;
+
+    std::vector<unsigned char> response;
+    FrameFormat responseFormat = format;
+    try {
+      response = this->handleRequest(format, payload);
+    } catch (const std::exception& e) {
+      responseFormat = FrameFormat::ERROR;
+      response = toBytes(e.what());
+    }
+
+    if (!writeFrame(fd, responseFormat, response)) break;
+  }
+
+  // Erase before closing, under the lock: once closed, accept() may hand the same fd number to a new connection
+  std::lock_guard<std::mutex> lock(this->connectionMutex);
+  this->connections.erase(fd);
+  ::close(fd);
+  if (this->connections.empty()) this->connectionsClosed.notify_all();
+}
+
+//===================================================================================================================//
+
+std::vector<unsigned char> Server::handleRequest(FrameFormat format, const std::vector<unsigned char>& payload) {
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<float> input;
+  if (format == FrameFormat::FLOAT32) {
+    if (payload.size() % sizeof(float) != 0) {
+      throw std::runtime_error("float32 request size is not a multiple of 4 bytes");
+    }
+    input.resize(payload.size() / sizeof(float));
+    std::memcpy(input.data(), payload.data(), payload.size()); // Little-endian hosts only, like packed datasets
+  } else {
+    const char* text = reinterpret_cast<const char*>(payload.data());
+    StreamedValue value = SamplesReader::parseValue(text, text + payload.size(), "request");
+    input = SamplesReader::takeData(value, "input");
+  }
+
+  ulong worker = this->acquireWorker();
+  std::vector<float> output;
+  try {
+    output = this->predictor(worker, std::move(input));
+  } catch (...) {
+    this->releaseWorker(worker);
+    throw;
+  }
+  this->releaseWorker(worker);
+
+  double latencyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  ulong requestNumber = ++this->numRequests;
+  {
+    std::lock_guard<std::mutex> lock(this->statsMutex);
+    this->totalLatencyMs += latencyMs;
+    this->maxLatencyMs = std::max(this->maxLatencyMs, latencyMs);
+    if (this->logLevel >= LogLevel::DEBUG) {
+      std::cout << "Request " << requestNumber << ": " << output.size() << " output value(s) in "
+                << std::fixed << std::setprecision(3) << latencyMs << " ms\n";
+      std::cout.unsetf(std::ios_base::floatfield);
+    }
+  }
+
+  if (format == FrameFormat::FLOAT32) {
+    std::vector<unsigned char> bytes(output.size() * sizeof(float));
+    std::memcpy(bytes.data(), output.data(), bytes.size());
+    return bytes;
+  }
+
+  nlohmann::ordered_json response;
+  response["output"] = output;
+  response["latencyMs"] = latencyMs;
+  return toBytes(response.dump());
+}
+
+//===================================================================================================================//
+
+ulong Server::acquireWorker() {
+  std::unique_lock<std::mutex> lock(this->workerMutex);
+  this->workerAvailable.wait(lock, [this]() { return !this->freeWorkers.empty(); });
+  ulong worker = this->freeWorkers.back();
+  this->freeWorkers.pop_back();
+  return worker;
+}
+
+//===================================================================================================================//
+
+void Server::releaseWorker(ulong worker) {
+  {
+    std::lock_guard<std::mutex> lock(this->workerMutex);
+    this->freeWorkers.push_back(worker);
+  }
+  this->workerAvailable.notify_one();
+}
+
+//===================================================================================================================//
+
+} // namespace NN_CLI
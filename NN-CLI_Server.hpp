@@ -0,0 +1,106 @@
+#ifndef NN_CLI_SERVER_HPP
+#define NN_CLI_SERVER_HPP
+
+#include "NN-CLI_LogLevel.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+//===================================================================================================================//
+
+namespace NN_CLI {
+
+// Frame formats. Requests use FLOAT32 or JSON; responses mirror the request's format, or carry ERROR.
+enum class FrameFormat : uint8_t {
+  FLOAT32 = 0, // Little-endian float32 values
+  JSON    = 1, // Request: a numeric array. Response: {"output": [...], "latencyMs": ...}
+  ERROR   = 2  // Response only: UTF-8 error message
+};
+
+/**
+ * Server: resident inference server for --mode serve.
+ *
+ * Listens on a Unix domain socket or a localhost TCP port. Each connection carries any number of
+ * length-prefixed frames:
+ *
+ *   [uint8 format][uint32 payload length, little-endian][payload]
+ *
+ * and gets one response frame per request, in order. Connections are served concurrently; every
+ * request borrows one of `numWorkers` workers (model replicas, owned by the caller and reached
+ * through the predictor) for the duration of its prediction. Per-request latency — from the
+ * request being read to its output being ready, including any wait for a free worker — is
+ * returned in JSON responses, logged at debug level and summarised when the server stops.
+ */
+class Server {
+  public:
+    // Predicts one input on the given worker. Only one request uses a worker at a time.
+    using Predictor = std::function<std::vector<float>(ulong worker, std::vector<float>&& input)>;
+
+    Server(ulong numWorkers, Predictor predictor, LogLevel logLevel);
+    ~Server();
+
+    // Bind and listen. Throws on failure. A stale socket at socketPath is replaced; any other file there is an error.
+    void listenUnix(const std::string& socketPath);
+    void listenTcp(uint16_t port);
+
+    // Accept and serve connections until stop() is called, riding out transient accept() errors. Returns once every
+    // connection has closed: true after stop(), false if the listening socket failed (see getError()).
+    bool run();
+
+    // Stop accepting and close open connections.
+    void stop();
+
+    // Stop accepting; run() then closes the open connections and returns. Async-signal-safe.
+    void interrupt();
+
+    ulong getNumRequests() const { return this->numRequests; }
+    const std::string& getError() const { return this->error; }
+
+    // Largest accepted request payload.
+    static constexpr uint32_t maxPayloadSize = 256u * 1024u * 1024u;
+
+  private:
+    ulong numWorkers;
+    Predictor predictor;
+    LogLevel logLevel;
+
+    int listenFd = -1;
+    std::string socketPath; // Unix socket file to remove on shutdown
+    std::atomic<bool> stopping{false};
+    std::string error; // Why run() stopped accepting, if not stop()
+
+    //-- Worker checkout --//
+    std::mutex workerMutex;
+    std::condition_variable workerAvailable;
+    std::vector<ulong> freeWorkers;
+
+    //-- Open connections (shut down by stop()) --//
+    std::mutex connectionMutex;
+    std::condition_variable connectionsClosed;
+    std::set<int> connections;
+
+    //-- Latency statistics --//
+    std::mutex statsMutex;
+    std::atomic<ulong> numRequests{0};
+    double totalLatencyMs = 0.0;
+    double maxLatencyMs = 0.0;
+
+    void serveConnection(int fd);
+    std::vector<unsigned char> handleRequest(FrameFormat format, const std::vector<unsigned char>& payload);
+    ulong acquireWorker();
+    void releaseWorker(ulong worker);
+};
+
+} // namespace NN_CLI
+
+//===================================================================================================================//
+
+#endif // NN_CLI_SERVER_HPP
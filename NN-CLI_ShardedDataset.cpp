@@ -0,0 +1,93 @@
+#include "NN-CLI_ShardedDataset.hpp"
+
+#include <QDir>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace NN_CLI {
+
+//===================================================================================================================//
+
+std::vector<std::string> ShardedDataset::listShards(const std::string& dirPath) {
+  QDir dir(QString::fromStdString(dirPath));
+  if (!dir.exists()) {
+    throw std::runtime_error("Shard directory does not exist: " + dirPath);
+  }
+
+  std::vector<std::string> shardPaths;
+  for (const QString& name : dir.entryList(QStringList() << "*.nnpack", QDir::Files, QDir::Name)) {
+    shardPaths.push_back(dir.filePath(name).toStdString());
+  }
+
+  if (shardPaths.empty()) {
+    throw std::runtime_error("No packed dataset shards (*.nnpack) in: " + dirPath);
+  }
+
+  return shardPaths;
+}
+
+//===================================================================================================================//
+
+void ShardedDataset::open(const std::vector<std::string>& shardPaths) {
+  this->shards.clear();
+  this->offsets.assign(1, 0);
+
+  for (const std::string& shardPath : shardPaths) {
+    auto shard = std::make_unique<PackedDataset>();
+    shard->open(shardPath);
+
+    if (!this->shards.empty()) {
+      const PackedHeader& first = this->shards.front()->getHeader();
+      const PackedHeader& header = shard->getHeader();
+      if (header.inputSize != first.inputSize || header.outputSize != first.outputSize ||
+          header.inputType != first.inputType || header.outputType != first.outputType) {
+        throw std::runtime_error("Shard record layout differs from the first shard: " + shardPath);
+      }
+    }
+
+    this->offsets.push_back(this->offsets.back() + shard->numSamples());
+    this->shards.push_back(std::move(shard));
+  }
+
+  if (this->shards.empty()) {
+    throw std::runtime_error("Sharded dataset has no shards");
+  }
+}
+
+//===================================================================================================================//
+
+ulong ShardedDataset::inputSize() const {
+  return this->shards.empty() ? 0 : this->shards.front()->inputSize();
+}
+
+ulong ShardedDataset::outputSize() const {
+  return this->shards.empty() ? 0 : this->shards.front()->outputSize();
+}
+
+//===================================================================================================================//
+
+std::pair<ulong, ulong> ShardedDataset::locate(ulong index) const {
+  // offsets is sorted; the shard is the last one starting at or before index
+  auto it = std::upper_bound(this->offsets.begin(), this->offsets.end(), index);
+  ulong shard = static_cast<ulong>(std::distance(this->offsets.begin(), it)) - 1;
+  return {shard, index - this->offsets[shard]};
+}
+
+//===================================================================================================================//
+
+void ShardedDataset::readInput(ulong index, float* dst) const {
+  auto [shard, local] = this->locate(index);
+  this->shards[shard]->readInput(local, dst);
+}
+
+//===================================================================================================================//
+
+void ShardedDataset::readOutput(ulong index, float* dst) const {
+  auto [shard, local] = this->locate(index);
+  this->shards[shard]->readOutput(local, dst);
+}
+
+//===================================================================================================================//
+
+} // namespace NN_CLI
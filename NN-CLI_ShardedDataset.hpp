@@ -0,0 +1,59 @@
+#ifndef NN_CLI_SHARDEDDATASET_HPP
+#define NN_CLI_SHARDEDDATASET_HPP
+
+#include "NN-CLI_MappedDataset.hpp"
+#include "NN-CLI_PackedDataset.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+//===================================================================================================================//
+
+namespace NN_CLI {
+
+/**
+ * ShardedDataset: a dataset split across several packed dataset files (shards).
+ *
+ * Every shard is memory-mapped and their records are concatenated in the given order,
+ * so global record i lives in the shard whose [shardBegin, shardEnd) range contains it.
+ * All shards must share the same record sizes and element types.
+ *
+ * DataLoader streams a sharded dataset shard by shard (see DataLoader::loadShards), so reads
+ * follow the file layout instead of jumping between random records.
+ */
+class ShardedDataset : public MappedDataset {
+  public:
+    // The packed dataset files in a directory, sorted by name. Throws if there are none.
+    static std::vector<std::string> listShards(const std::string& dirPath);
+
+    // Map every shard and check that their headers agree. Throws on I/O errors or mismatches.
+    void open(const std::vector<std::string>& shardPaths);
+
+    ulong numSamples() const override { return this->offsets.empty() ? 0 : this->offsets.back(); }
+    ulong inputSize() const override;
+    ulong outputSize() const override;
+
+    ulong numShards() const { return this->shards.size(); }
+    ulong shardBegin(ulong shard) const { return this->offsets[shard]; }
+    ulong shardEnd(ulong shard) const { return this->offsets[shard + 1]; }
+
+    // Header of the first shard (record sizes, encodings and shapes are the same in all of them).
+    const PackedHeader& getHeader() const { return this->shards.front()->getHeader(); }
+
+    void readInput(ulong index, float* dst) const override;
+    void readOutput(ulong index, float* dst) const override;
+
+  private:
+    std::vector<std::unique_ptr<PackedDataset>> shards;
+    std::vector<ulong> offsets;  // offsets[s] = first global record of shard s; back() = total
+
+    // Shard holding global record `index`, and the record's index within it.
+    std::pair<ulong, ulong> locate(ulong index) const;
+};
+
+} // namespace NN_CLI
+
+//===================================================================================================================//
+
+#endif // NN_CLI_SHARDEDDATASET_HPP
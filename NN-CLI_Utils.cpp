@@ -1,7 +1,11 @@
 #include "NN-CLI_Utils.hpp"
+#include "NN-CLI_IDXDataset.hpp"
+#include "NN-CLI_NpyDataset.hpp"
 #include "NN-CLI_ProgressBar.hpp"
 
+#include <algorithm>
 #include <stdexcept>
+#include <type_traits>
 
 using namespace NN_CLI;
 
@@ -16,40 +20,27 @@ using namespace NN_CLI;
 template <typename T>
 ANN::Samples<T> Utils<T>::loadANNIDX(const std::string& dataPath, const std::string& labelsPath,
                                       ulong progressReports) {
-  std::vector<std::vector<unsigned char>> data = loadIDXData(dataPath);
-  std::vector<unsigned char> labels = loadIDXLabels(labelsPath);
+  // Both files are memory-mapped; only the converted samples are allocated
+  IDXDataset dataset;
+  dataset.open(dataPath, labelsPath);
 
-  if (data.size() != labels.size()) {
-    throw std::runtime_error("IDX data and labels count mismatch");
-  }
-
-  // Determine the number of unique labels for one-hot encoding
-  unsigned char maxLabel = 0;
-  for (unsigned char label : labels) {
-    if (label > maxLabel) {
-      maxLabel = label;
-    }
-  }
-  size_t numClasses = static_cast<size_t>(maxLabel) + 1;
+  size_t totalSamples = dataset.numSamples();
+  size_t itemSize = dataset.inputSize();
+  size_t numClasses = dataset.outputSize();
 
-  ANN::Samples<T> samples;
-  samples.reserve(data.size());
-  size_t totalSamples = data.size();
+  ANN::Samples<T> samples(totalSamples);
 
   for (size_t i = 0; i < totalSamples; ++i) {
-    ANN::Sample<T> sample;
+    ANN::Sample<T>& sample = samples[i];
 
     // Convert data to normalized input (0-1 range)
-    sample.input.reserve(data[i].size());
-    for (unsigned char value : data[i]) {
-      sample.input.push_back(static_cast<T>(value) / static_cast<T>(255));
-    }
+    sample.input.resize(itemSize);
+    toNormalized(dataset.item(i), itemSize, sample.input.data());
 
     // Convert label to one-hot encoded output
-    sample.output.resize(numClasses, static_cast<T>(0));
-    sample.output[labels[i]] = static_cast<T>(1);
+    sample.output.assign(numClasses, static_cast<T>(0));
+    sample.output[dataset.label(i)] = static_cast<T>(1);
 
-    samples.push_back(std::move(sample));
     ProgressBar::printLoadingProgress("Loading samples:", i + 1, totalSamples, progressReports);
   }
 
@@ -59,118 +50,100 @@ ANN::Samples<T> Utils<T>::loadANNIDX(const std::string& dataPath, const std::str
 //===================================================================================================================//
 
 template <typename T>
-uint32_t Utils<T>::readBigEndianUInt32(std::ifstream& stream) {
-  unsigned char bytes[4];
-  stream.read(reinterpret_cast<char*>(bytes), 4);
-  
-  return (static_cast<uint32_t>(bytes[0]) << 24) |
-         (static_cast<uint32_t>(bytes[1]) << 16) |
-         (static_cast<uint32_t>(bytes[2]) << 8) |
-         (static_cast<uint32_t>(bytes[3]));
+void Utils<T>::toNormalized(const unsigned char* src, size_t count, T* dst) {
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = static_cast<T>(src[i]) / static_cast<T>(255);
+  }
 }
 
 //===================================================================================================================//
 
 template <typename T>
-std::vector<std::vector<unsigned char>> Utils<T>::loadIDXData(const std::string& path) {
-  std::ifstream file(path, std::ios::binary);
-
-  if (!file.is_open()) {
-    throw std::runtime_error("Failed to open IDX data file: " + path);
+CNN::Samples<T> Utils<T>::loadCNNIDX(const std::string& dataPath, const std::string& labelsPath,
+                                      const CNN::Shape3D& inputShape, ulong progressReports) {
+  // Both files are memory-mapped; only the converted samples are allocated
+  IDXDataset dataset;
+  dataset.open(dataPath, labelsPath);
+
+  // Validate data size matches input shape
+  if (dataset.numSamples() > 0 && dataset.inputSize() != inputShape.size()) {
+    throw std::runtime_error("IDX data item size (" + std::to_string(dataset.inputSize()) +
+      ") does not match expected input shape size (" + std::to_string(inputShape.size()) + ")");
   }
 
-  uint32_t magic = readBigEndianUInt32(file);
+  size_t totalSamples = dataset.numSamples();
+  size_t numClasses = dataset.outputSize();
 
-  if (magic != 0x00000803) {
-    throw std::runtime_error("Invalid IDX3 data file magic number");
-  }
+  CNN::Samples<T> samples(totalSamples);
+
+  for (size_t i = 0; i < totalSamples; ++i) {
+    CNN::Sample<T>& sample = samples[i];
 
-  uint32_t numItems = readBigEndianUInt32(file);
-  uint32_t numRows = readBigEndianUInt32(file);
-  uint32_t numCols = readBigEndianUInt32(file);
-  uint32_t itemSize = numRows * numCols;
+    // Reshape flat data into Tensor3D with given shape
+    sample.input = CNN::Tensor3D<T>(inputShape);
+    toNormalized(dataset.item(i), inputShape.size(), sample.input.data.data());
 
-  std::vector<std::vector<unsigned char>> data;
-  data.reserve(numItems);
+    // Convert label to one-hot encoded output
+    sample.output.assign(numClasses, static_cast<T>(0));
+    sample.output[dataset.label(i)] = static_cast<T>(1);
 
-  for (uint32_t i = 0; i < numItems; ++i) {
-    std::vector<unsigned char> item(itemSize);
-    file.read(reinterpret_cast<char*>(item.data()), itemSize);
-    data.push_back(std::move(item));
+    ProgressBar::printLoadingProgress("Loading samples:", i + 1, totalSamples, progressReports);
   }
 
-  return data;
+  return samples;
 }
 
 //===================================================================================================================//
 
 template <typename T>
-std::vector<unsigned char> Utils<T>::loadIDXLabels(const std::string& path) {
-  std::ifstream file(path, std::ios::binary);
-
-  if (!file.is_open()) {
-    throw std::runtime_error("Failed to open IDX labels file: " + path);
-  }
+ANN::Samples<T> Utils<T>::loadANNNpy(const std::string& inputsPath, const std::string& outputsPath,
+                                      ulong progressReports) {
+  // Both arrays are memory-mapped; rows are converted straight into the samples
+  NpyDataset dataset;
+  dataset.open(inputsPath, outputsPath);
 
-  uint32_t magic = readBigEndianUInt32(file);
+  size_t totalSamples = dataset.numSamples();
+  ANN::Samples<T> samples(totalSamples);
 
-  if (magic != 0x00000801) {
-    throw std::runtime_error("Invalid IDX1 labels file magic number");
-  }
+  for (size_t i = 0; i < totalSamples; ++i) {
+    ANN::Sample<T>& sample = samples[i];
 
-  uint32_t numLabels = readBigEndianUInt32(file);
+    sample.input.resize(dataset.inputSize());
+    readRecord(dataset, i, false, sample.input.data());
+    sample.output.resize(dataset.outputSize());
+    readRecord(dataset, i, true, sample.output.data());
 
-  std::vector<unsigned char> labels(numLabels);
-  file.read(reinterpret_cast<char*>(labels.data()), numLabels);
+    ProgressBar::printLoadingProgress("Loading samples:", i + 1, totalSamples, progressReports);
+  }
 
-  return labels;
+  return samples;
 }
 
 //===================================================================================================================//
 
 template <typename T>
-CNN::Samples<T> Utils<T>::loadCNNIDX(const std::string& dataPath, const std::string& labelsPath,
+CNN::Samples<T> Utils<T>::loadCNNNpy(const std::string& inputsPath, const std::string& outputsPath,
                                       const CNN::Shape3D& inputShape, ulong progressReports) {
-  std::vector<std::vector<unsigned char>> data = loadIDXData(dataPath);
-  std::vector<unsigned char> labels = loadIDXLabels(labelsPath);
-
-  if (data.size() != labels.size()) {
-    throw std::runtime_error("IDX data and labels count mismatch");
-  }
+  NpyDataset dataset;
+  dataset.open(inputsPath, outputsPath);
 
-  // Determine the number of unique labels for one-hot encoding
-  unsigned char maxLabel = 0;
-  for (unsigned char label : labels) {
-    if (label > maxLabel) {
-      maxLabel = label;
-    }
+  // Validate row size matches input shape
+  if (dataset.numSamples() > 0 && dataset.inputSize() != inputShape.size()) {
+    throw std::runtime_error("NumPy input row size (" + std::to_string(dataset.inputSize()) +
+      ") does not match expected input shape size (" + std::to_string(inputShape.size()) + ")");
   }
-  size_t numClasses = static_cast<size_t>(maxLabel) + 1;
 
-  CNN::Samples<T> samples;
-  samples.reserve(data.size());
-  size_t totalSamples = data.size();
+  size_t totalSamples = dataset.numSamples();
+  CNN::Samples<T> samples(totalSamples);
 
   for (size_t i = 0; i < totalSamples; ++i) {
-    CNN::Sample<T> sample;
-
-    // Validate data size matches input shape
-    if (data[i].size() != inputShape.size()) {
-      throw std::runtime_error("IDX data item size (" + std::to_string(data[i].size()) +
-        ") does not match expected input shape size (" + std::to_string(inputShape.size()) + ")");
-    }
+    CNN::Sample<T>& sample = samples[i];
 
-    // Reshape flat data into Tensor3D with given shape
     sample.input = CNN::Tensor3D<T>(inputShape);
-    for (size_t j = 0; j < data[i].size(); ++j) {
-      sample.input.data[j] = static_cast<T>(data[i][j]) / static_cast<T>(255);
-    }
-
-    // Convert label to one-hot encoded output
-    sample.output.resize(numClasses, static_cast<T>(0));
-    sample.output[labels[i]] = static_cast<T>(1);
+    readRecord(dataset, i, false, sample.input.data.data());
+    sample.output.resize(dataset.outputSize());
+    readRecord(dataset, i, true, sample.output.data());
 
-    samples.push_back(std::move(sample));
     ProgressBar::printLoadingProgress("Loading samples:", i + 1, totalSamples, progressReports);
   }
 
@@ -179,6 +152,19 @@ CNN::Samples<T> Utils<T>::loadCNNIDX(const std::string& dataPath, const std::str
 
 //===================================================================================================================//
 
+template <typename T>
+void Utils<T>::readRecord(const MappedDataset& dataset, ulong index, bool output, T* dst) {
+  if constexpr (std::is_same_v<T, float>) {
+    if (output) dataset.readOutput(index, dst);
+    else dataset.readInput(index, dst);
+  } else {
+    std::vector<float> record = output ? dataset.output(index) : dataset.input(index);
+    std::transform(record.begin(), record.end(), dst, [](float v) { return static_cast<T>(v); });
+  }
+}
+
+//===================================================================================================================//
+
 // Explicit template instantiations
 template class NN_CLI::Utils<int>;
 template class NN_CLI::Utils<float>;
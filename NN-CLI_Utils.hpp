@@ -1,11 +1,12 @@
 #ifndef NN_CLI_UTILS_HPP
 #define NN_CLI_UTILS_HPP
 
+#include "NN-CLI_MappedDataset.hpp"
+
 #include <ANN_Core.hpp>
 #include <CNN_Types.hpp>
 #include <CNN_Sample.hpp>
 
-#include <fstream>
 #include <string>
 #include <vector>
 
@@ -24,10 +25,20 @@ namespace NN_CLI {
       static CNN::Samples<T> loadCNNIDX(const std::string& dataPath, const std::string& labelsPath,
                                          const CNN::Shape3D& inputShape, ulong progressReports = 1000);
 
+      /// Load NumPy .npy inputs and outputs/labels as ANN samples
+      static ANN::Samples<T> loadANNNpy(const std::string& inputsPath, const std::string& outputsPath,
+                                         ulong progressReports = 1000);
+
+      /// Load NumPy .npy inputs and outputs/labels as CNN samples (rows reshaped to inputShape)
+      static CNN::Samples<T> loadCNNNpy(const std::string& inputsPath, const std::string& outputsPath,
+                                         const CNN::Shape3D& inputShape, ulong progressReports = 1000);
+
     private:
-      static uint32_t readBigEndianUInt32(std::ifstream& stream);
-      static std::vector<std::vector<unsigned char>> loadIDXData(const std::string& path);
-      static std::vector<unsigned char> loadIDXLabels(const std::string& path);
+      /// Convert 8-bit values to the 0-1 range
+      static void toNormalized(const unsigned char* src, size_t count, T* dst);
+
+      /// Decode one record of a mapped dataset into T storage (directly when T is float)
+      static void readRecord(const MappedDataset& dataset, ulong index, bool output, T* dst);
   };
 
 } // namespace NN_CLI
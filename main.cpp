@@ -13,19 +13,39 @@ void printUsage() {
   std::cout << "Usage:\n";
   std::cout << "  NN-CLI --config <file> --mode train [options]       # Training\n";
   std::cout << "  NN-CLI --config <file> --mode predict --input <f>   # Predict (batch)\n";
-  std::cout << "  NN-CLI --config <file> --mode test [options]        # Evaluation\n\n";
+  std::cout << "  NN-CLI --config <file> --mode test [options]        # Evaluation\n";
+  std::cout << "  NN-CLI --config <file> --mode pack [options]        # Build a packed dataset\n";
+  std::cout << "  NN-CLI --config <file> --mode serve --socket <path> # Inference server\n";
+  std::cout << "  NN-CLI --config <file> --mode convert [options]     # Convert a model between JSON and .nnmodel\n";
+  std::cout << "  NN-CLI --config <file> --mode info                  # Show model metadata\n\n";
   std::cout << "Options:\n";
   std::cout << "  --config, -c <file>    Path to JSON configuration file (required)\n";
-  std::cout << "  --mode, -m <mode>      Mode: 'train', 'predict', or 'test' (overrides config file)\n";
+  std::cout << "  --mode, -m <mode>      Mode: 'train', 'predict', 'test', 'pack', 'serve', 'convert', or 'info' (overrides config file)\n";
   std::cout << "  --device, -d <device>  Device: 'cpu' or 'gpu' (overrides config file)\n";
-  std::cout << "  --input, -i <file>     Path to JSON file with batch inputs (predict mode, required)\n";
+  std::cout << "  --input, -i <file>     Path to JSON, .npy or JSON Lines (.jsonl, '-' = stdin) predict inputs (required)\n";
   std::cout << "  --input-type <type>    Input data type: 'vector' or 'image' (overrides config file)\n";
-  std::cout << "  --samples, -s <file>   Path to JSON file with samples (train/test modes)\n";
+  std::cout << "  --samples, -s <file>   Path to JSON samples, packed dataset or shard dir (train/test/pack modes)\n";
   std::cout << "  --idx-data <file>      Path to IDX3 data file (alternative to --samples)\n";
   std::cout << "  --idx-labels <file>    Path to IDX1 labels file (requires --idx-data)\n";
-  std::cout << "  --output, -o <file>    Output file/dir (default: predict_<input>.json or folder for images)\n";
+  std::cout << "  --npy-inputs <file>    Path to .npy inputs array, one sample per row (alternative to --samples)\n";
+  std::cout << "  --npy-outputs <file>   Path to .npy class labels or outputs array (requires --npy-inputs)\n";
+  std::cout << "  --output, -o <file>    Output file/dir (default: predict_<input>.json, folder for images, <input>.nnpack)\n";
+  std::cout << "                         '-' streams JSON Lines predictions to stdout (log messages go to stderr)\n";
+  std::cout << "  --output-format <fmt>  Predict vector outputs: 'json', 'jsonl', 'npy' or 'f32' (default: from --output)\n";
   std::cout << "  --output-type <type>   Output data type: 'vector' or 'image' (overrides config file)\n";
   std::cout << "  --shuffle-samples <b>  Shuffle samples each epoch: true/false (overrides config file)\n";
+  std::cout << "  --resident <enc>       Preload JSON training samples in memory: uint8, fp16 or float32\n";
+  std::cout << "  --image-cache <dir>    Cache decoded, resized images in <dir> across runs\n";
+  std::cout << "  --image-decoder <name> Image decoder: 'stb' (default) or 'libjpeg' (scaled JPEG decoding)\n";
+  std::cout << "  --png-compression <n>  PNG level for predicted images: 0 (uncompressed, fastest) to 9 (default: 8)\n";
+  std::cout << "  --sample-cache <MiB>   Keep decoded training samples in memory across epochs (LRU)\n";
+  std::cout << "  --shard-size <n>       Pack mode: split the dataset into shards of <n> samples\n";
+  std::cout << "  --shuffle-buffer <n>   Samples held for shuffling when streaming shards (default: 10000)\n";
+  std::cout << "  --predict-threads <n>  Predict with <n> model replicas in parallel (CPU; 0 = all cores, default: 1)\n";
+  std::cout << "  --socket <path>        Serve mode: listen on a Unix domain socket\n";
+  std::cout << "  --port <n>             Serve mode: listen on 127.0.0.1:<n> (TCP)\n";
+  std::cout << "  --model-format <fmt>   Saved model format: 'json' or 'binary' (.nnmodel; default: from --output)\n";
+  std::cout << "  --model-precision <p>  Parameter encoding in .nnmodel files: 'float32' or 'fp16' (default: float32)\n";
   std::cout << "  --log-level, -l <lvl>  Log level: quiet, error, warning, info, debug (default: error)\n";
   std::cout << "  --help, -h             Show this help message\n";
 }
@@ -47,10 +67,10 @@ int main(int argc, char *argv[]) {
   );
   parser.addOption(configOption);
 
-  // Mode option (train, predict, or test)
+  // Mode option (train, predict, test, pack, serve, convert, or info)
   QCommandLineOption modeOption(
     QStringList() << "m" << "mode",
-    "Mode: 'train', 'predict', or 'test'.",
+    "Mode: 'train', 'predict', 'test', 'pack', 'serve', 'convert', or 'info'.",
     "mode"
   );
   parser.addOption(modeOption);
@@ -67,7 +87,7 @@ int main(int argc, char *argv[]) {
   // Input file for predict mode
   QCommandLineOption inputOption(
     QStringList() << "i" << "input",
-    "Path to JSON file with input values for predict mode.",
+    "Path to JSON, .npy or JSON Lines (.jsonl/.ndjson) file with input values for predict mode. '-' reads JSON Lines from stdin.",
     "file"
   );
   parser.addOption(inputOption);
@@ -104,10 +124,26 @@ int main(int argc, char *argv[]) {
   );
   parser.addOption(idxLabelsOption);
 
+  // NumPy inputs array (.npy, one sample per row)
+  QCommandLineOption npyInputsOption(
+    QStringList() << "npy-inputs",
+    "Path to .npy inputs array, one sample per row (alternative to --samples).",
+    "file"
+  );
+  parser.addOption(npyInputsOption);
+
+  // NumPy outputs array: 1-D integer class labels or one output row per sample
+  QCommandLineOption npyOutputsOption(
+    QStringList() << "npy-outputs",
+    "Path to .npy class labels or outputs array (requires --npy-inputs).",
+    "file"
+  );
+  parser.addOption(npyOutputsOption);
+
   // Output file (train: model, predict: predict result with metadata)
   QCommandLineOption outputOption(
     QStringList() << "o" << "output",
-    "Output file. Train mode: saves trained model. Predict mode: saves predict result with model metadata.",
+    "Output file. Train mode: saves trained model. Predict mode: saves predict result with model metadata ('-' = stdout for JSON Lines). Pack mode: saves packed dataset.",
     "file"
   );
   parser.addOption(outputOption);
@@ -120,6 +156,15 @@ int main(int argc, char *argv[]) {
   );
   parser.addOption(outputTypeOption);
 
+  // Predict output format option (vector outputs)
+  QCommandLineOption outputFormatOption(
+    QStringList() << "output-format",
+    "Predict vector output format: 'json', 'jsonl', 'npy' or 'f32'. Default: from the --output extension, else json "
+    "(jsonl for JSON Lines input).",
+    "format"
+  );
+  parser.addOption(outputFormatOption);
+
   // Log level option
   QCommandLineOption logLevelOption(
     QStringList() << "l" << "log-level",
@@ -137,6 +182,100 @@ int main(int argc, char *argv[]) {
   );
   parser.addOption(shuffleSamplesOption);
 
+  // Resident sample storage option (training with JSON samples)
+  QCommandLineOption residentOption(
+    QStringList() << "resident",
+    "Preload JSON training samples into memory: 'uint8' (images), 'fp16' (vectors) or 'float32'.",
+    "encoding"
+  );
+  parser.addOption(residentOption);
+
+  // Decoded image cache option
+  QCommandLineOption imageCacheOption(
+    QStringList() << "image-cache",
+    "Directory for a persistent cache of decoded, resized images (created if missing).",
+    "dir"
+  );
+  parser.addOption(imageCacheOption);
+
+  // Image decoder backend
+  QCommandLineOption imageDecoderOption(
+    QStringList() << "image-decoder",
+    "Image decoder: 'stb' (default) or 'libjpeg' (JPEGs decoded at reduced scale when the target is smaller).",
+    "name"
+  );
+  parser.addOption(imageDecoderOption);
+
+  // PNG compression of predicted images
+  QCommandLineOption pngCompressionOption(
+    QStringList() << "png-compression",
+    "PNG compression level for predicted images: 0 (uncompressed, fastest) to 9 (default: 8).",
+    "level"
+  );
+  parser.addOption(pngCompressionOption);
+
+  // In-process sample cache option (training with JSON samples)
+  QCommandLineOption sampleCacheOption(
+    QStringList() << "sample-cache",
+    "Keep up to <MiB> of decoded training samples in memory across epochs.",
+    "MiB"
+  );
+  parser.addOption(sampleCacheOption);
+
+  // Shard size option (pack mode)
+  QCommandLineOption shardSizeOption(
+    QStringList() << "shard-size",
+    "Pack mode: write the dataset as a directory of shards of <n> samples each.",
+    "n"
+  );
+  parser.addOption(shardSizeOption);
+
+  // Shuffle buffer option (training from a shard directory)
+  QCommandLineOption shuffleBufferOption(
+    QStringList() << "shuffle-buffer",
+    "Number of samples held in the shuffle buffer when streaming shards (default: 10000).",
+    "n"
+  );
+  parser.addOption(shuffleBufferOption);
+
+  // Parallel predict: number of model replicas scoring inputs side by side
+  QCommandLineOption predictThreadsOption(
+    QStringList() << "predict-threads",
+    "Number of model replicas predicting in parallel on the CPU (0 = one per core, default: 1).",
+    "n"
+  );
+  parser.addOption(predictThreadsOption);
+
+  // Serve mode endpoints
+  QCommandLineOption socketOption(
+    QStringList() << "socket",
+    "Serve mode: path of the Unix domain socket to listen on.",
+    "path"
+  );
+  parser.addOption(socketOption);
+
+  QCommandLineOption portOption(
+    QStringList() << "port",
+    "Serve mode: TCP port to listen on (127.0.0.1 only).",
+    "n"
+  );
+  parser.addOption(portOption);
+
+  // Saved model format (train checkpoints and final model, convert mode)
+  QCommandLineOption modelFormatOption(
+    QStringList() << "model-format",
+    "Saved model format: 'json' or 'binary' (.nnmodel). Default: binary if --output ends in .nnmodel, else json.",
+    "format"
+  );
+  parser.addOption(modelFormatOption);
+
+  QCommandLineOption modelPrecisionOption(
+    QStringList() << "model-precision",
+    "Parameter encoding in binary model files: 'float32' or 'fp16' (default: float32).",
+    "precision"
+  );
+  parser.addOption(modelPrecisionOption);
+
   parser.process(app);
 
   // Validate that --config is provided
@@ -149,8 +288,9 @@ int main(int argc, char *argv[]) {
   // Validate mode if provided
   if (parser.isSet(modeOption)) {
     QString modeStr = parser.value(modeOption).toLower();
-    if (modeStr != "train" && modeStr != "predict" && modeStr != "test") {
-      std::cerr << "Error: Mode must be 'train', 'predict', or 'test'.\n";
+    if (modeStr != "train" && modeStr != "predict" && modeStr != "test" && modeStr != "pack" && modeStr != "serve" &&
+        modeStr != "convert" && modeStr != "info") {
+      std::cerr << "Error: Mode must be 'train', 'predict', 'test', 'pack', 'serve', 'convert', or 'info'.\n";
       return 1;
     }
   }
@@ -191,6 +331,117 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  // Validate resident if provided
+  if (parser.isSet(residentOption)) {
+    QString residentStr = parser.value(residentOption).toLower();
+    if (residentStr != "uint8" && residentStr != "fp16" && residentStr != "float32") {
+      std::cerr << "Error: --resident must be 'uint8', 'fp16', or 'float32'.\n";
+      return 1;
+    }
+  }
+
+  // Validate sample-cache if provided
+  if (parser.isSet(sampleCacheOption)) {
+    bool ok = false;
+    parser.value(sampleCacheOption).toULong(&ok);
+    if (!ok) {
+      std::cerr << "Error: --sample-cache must be a size in MiB.\n";
+      return 1;
+    }
+  }
+
+  // Resident samples are never decoded again, so a sample cache would have nothing to hold
+  if (parser.isSet(residentOption) && parser.isSet(sampleCacheOption)) {
+    std::cerr << "Error: Cannot use both --resident and --sample-cache. Use --sample-cache when the decoded dataset does not fit in memory.\n";
+    return 1;
+  }
+
+  // Validate shard-size if provided
+  if (parser.isSet(shardSizeOption)) {
+    bool ok = false;
+    bool positive = parser.value(shardSizeOption).toULong(&ok) > 0;
+    if (!ok || !positive) {
+      std::cerr << "Error: --shard-size must be a positive number of samples.\n";
+      return 1;
+    }
+  }
+
+  // Validate shuffle-buffer if provided
+  if (parser.isSet(shuffleBufferOption)) {
+    bool ok = false;
+    parser.value(shuffleBufferOption).toULong(&ok);
+    if (!ok) {
+      std::cerr << "Error: --shuffle-buffer must be a number of samples.\n";
+      return 1;
+    }
+  }
+
+  // Validate image-decoder if provided
+  if (parser.isSet(imageDecoderOption)) {
+    QString decoderStr = parser.value(imageDecoderOption).toLower();
+    if (decoderStr != "stb" && decoderStr != "libjpeg") {
+      std::cerr << "Error: --image-decoder must be 'stb' or 'libjpeg'.\n";
+      return 1;
+    }
+  }
+
+  // Validate png-compression if provided
+  if (parser.isSet(pngCompressionOption)) {
+    bool ok = false;
+    int level = parser.value(pngCompressionOption).toInt(&ok);
+    if (!ok || level < 0 || level > 9) {
+      std::cerr << "Error: --png-compression must be a level from 0 to 9.\n";
+      return 1;
+    }
+  }
+
+  // Validate predict-threads if provided
+  if (parser.isSet(predictThreadsOption)) {
+    bool ok = false;
+    parser.value(predictThreadsOption).toULong(&ok);
+    if (!ok) {
+      std::cerr << "Error: --predict-threads must be a number of threads.\n";
+      return 1;
+    }
+  }
+
+  // Validate port if provided
+  if (parser.isSet(portOption)) {
+    bool ok = false;
+    ulong port = parser.value(portOption).toULong(&ok);
+    if (!ok || port == 0 || port > 65535) {
+      std::cerr << "Error: --port must be a TCP port number (1-65535).\n";
+      return 1;
+    }
+  }
+
+  // Validate output-format if provided
+  if (parser.isSet(outputFormatOption)) {
+    QString formatStr = parser.value(outputFormatOption).toLower();
+    if (formatStr != "json" && formatStr != "jsonl" && formatStr != "npy" && formatStr != "f32") {
+      std::cerr << "Error: --output-format must be 'json', 'jsonl', 'npy' or 'f32'.\n";
+      return 1;
+    }
+  }
+
+  // Validate model-format if provided
+  if (parser.isSet(modelFormatOption)) {
+    QString formatStr = parser.value(modelFormatOption).toLower();
+    if (formatStr != "json" && formatStr != "binary") {
+      std::cerr << "Error: --model-format must be 'json' or 'binary'.\n";
+      return 1;
+    }
+  }
+
+  // Validate model-precision if provided
+  if (parser.isSet(modelPrecisionOption)) {
+    QString precisionStr = parser.value(modelPrecisionOption).toLower();
+    if (precisionStr != "float32" && precisionStr != "fp16") {
+      std::cerr << "Error: --model-precision must be 'float32' or 'fp16'.\n";
+      return 1;
+    }
+  }
+
   // Parse log level
   NN_CLI::LogLevel logLevel = NN_CLI::LogLevel::ERROR;
   if (parser.isSet(logLevelOption)) {
@@ -206,6 +457,11 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  // Predictions streamed to stdout must not be interleaved with log output: send the log to stderr
+  if (parser.isSet(outputOption) && parser.value(outputOption) == "-") {
+    std::cout.rdbuf(std::cerr.rdbuf());
+  }
+
   try {
     NN_CLI::Runner runner(parser, logLevel);
     return runner.run();
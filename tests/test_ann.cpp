@@ -6,6 +6,9 @@
 #include <QJsonObject>
 #include <QJsonArray>
 
+#include <cstring>
+#include <vector>
+
 // Trained model paths shared between chained tests
 QString trainedANNModelPath;                    // XOR model — used by detection/override/error tests
 static QString trainedANNMNISTModelPath;        // MNIST model — used by --full predict/test tests
@@ -197,6 +200,163 @@ static void testANNModeOverride() {
   std::cout << std::endl;
 }
 
+static void testANNModelInfo() {
+  std::cout << "  testANNModelInfo... ";
+
+  if (trainedANNModelPath.isEmpty() || !QFile::exists(trainedANNModelPath)) {
+    CHECK(false, "ANN model info: skipped — no trained model available (testANNTrainXOR must run first)");
+    std::cout << std::endl;
+    return;
+  }
+
+  auto result = runNNCLI({
+    "--config", trainedANNModelPath,
+    "--mode", "info"
+  });
+
+  CHECK(result.exitCode == 0, "ANN model info: exit code 0");
+  CHECK(result.stdOut.contains("Network type: ANN"), "ANN model info: 'Network type: ANN'");
+  CHECK(result.stdOut.contains("Layers: 2 -> 8 (relu) -> 2 (sigmoid)"), "ANN model info: layer summary");
+  CHECK(result.stdOut.contains("Parameters: ") && !result.stdOut.contains("Parameters: none"), "ANN model info: parameter count");
+  std::cout << std::endl;
+}
+
+static void testANNPredictNpyOutput() {
+  std::cout << "  testANNPredictNpyOutput... ";
+
+  if (trainedANNModelPath.isEmpty() || !QFile::exists(trainedANNModelPath)) {
+    CHECK(false, "ANN predict npy: skipped — no trained model available (testANNTrainXOR must run first)");
+    std::cout << std::endl;
+    return;
+  }
+
+  QString predictInputPath = tempDir() + "/ann_npy_input.json";
+  QFile inputFile(predictInputPath);
+  if (inputFile.open(QIODevice::WriteOnly)) {
+    inputFile.write(R"({"inputs": [[0.0, 0.0], [0.0, 1.0], [1.0, 0.0], [1.0, 1.0]]})");
+    inputFile.close();
+  }
+
+  QString outputPath = tempDir() + "/ann_npy_output.npy";
+  auto result = runNNCLI({
+    "--config", trainedANNModelPath,
+    "--mode", "predict",
+    "--input", predictInputPath,
+    "--output", outputPath,
+    "--output-format", "npy"
+  });
+
+  CHECK(result.exitCode == 0, "ANN predict npy: exit code 0");
+  CHECK(result.stdOut.contains("Format: npy (4 x 2)"), "ANN predict npy: 4 rows of 2 outputs");
+
+  // 128-byte header, then 4 x 2 float32 values
+  QFile outputFile(outputPath);
+  if (outputFile.open(QIODevice::ReadOnly)) {
+    QByteArray bytes = outputFile.readAll();
+    CHECK(bytes.size() == 128 + 4 * 2 * 4, "ANN predict npy: file size");
+    CHECK(bytes.startsWith("\x93NUMPY"), "ANN predict npy: .npy magic");
+    CHECK(bytes.contains("'shape': (4, 2)"), "ANN predict npy: shape in header");
+  } else {
+    CHECK(false, "ANN predict npy: failed to open output file");
+  }
+
+  QFile sidecarFile(tempDir() + "/ann_npy_output.meta.json");
+  if (sidecarFile.open(QIODevice::ReadOnly)) {
+    QJsonObject root = QJsonDocument::fromJson(sidecarFile.readAll()).object();
+    CHECK(root["predictMetadata"].toObject()["numInputs"].toInt() == 4, "ANN predict npy: sidecar numInputs");
+    CHECK(root["outputs"].toObject()["format"].toString() == "npy", "ANN predict npy: sidecar format");
+  } else {
+    CHECK(false, "ANN predict npy: sidecar written");
+  }
+  std::cout << std::endl;
+}
+
+static void testANNPredictThreadsMatchSerial() {
+  std::cout << "  testANNPredictThreadsMatchSerial... ";
+
+  if (trainedANNModelPath.isEmpty() || !QFile::exists(trainedANNModelPath)) {
+    CHECK(false, "ANN predict threads: skipped — no trained model available (testANNTrainXOR must run first)");
+    std::cout << std::endl;
+    return;
+  }
+
+  // 40 distinct inputs, so three replicas each get a share and a reordering would show
+  const int numInputs = 40;
+  QString inputs, lines;
+  for (int i = 0; i < numInputs; i++) {
+    QString row = "[" + QString::number(i / 39.0) + ", " + QString::number((i % 7) / 6.0) + "]";
+    inputs += (i == 0 ? "" : ", ") + row;
+    lines += row + "\n";
+  }
+
+  QString batchInputPath = tempDir() + "/ann_threads_input.json";
+  QString streamInputPath = tempDir() + "/ann_threads_input.jsonl";
+  QFile batchInputFile(batchInputPath), streamInputFile(streamInputPath);
+  if (batchInputFile.open(QIODevice::WriteOnly) && streamInputFile.open(QIODevice::WriteOnly)) {
+    batchInputFile.write(("{\"inputs\": [" + inputs + "]}").toUtf8());
+    streamInputFile.write(lines.toUtf8());
+    batchInputFile.close();
+    streamInputFile.close();
+  }
+
+  // Batch predict: raw float32 rows, serial and with 3 replicas
+  QByteArray batchOutputs[2];
+  const char* threadCounts[2] = {"1", "3"};
+  for (int t = 0; t < 2; t++) {
+    QString outputPath = tempDir() + "/ann_threads_batch_" + threadCounts[t] + ".f32";
+    auto result = runNNCLI({
+      "--config", trainedANNModelPath,
+      "--mode", "predict",
+      "--input", batchInputPath,
+      "--output", outputPath,
+      "--output-format", "f32",
+      "--predict-threads", threadCounts[t]
+    });
+    CHECK(result.exitCode == 0, "ANN predict threads: batch exit code 0");
+    QFile outputFile(outputPath);
+    if (outputFile.open(QIODevice::ReadOnly)) batchOutputs[t] = outputFile.readAll();
+  }
+
+  CHECK(batchOutputs[0].size() == static_cast<int>(numInputs * 2 * sizeof(float)), "ANN predict threads: one row per input");
+  CHECK(batchOutputs[1] == batchOutputs[0], "ANN predict threads: 3 replicas give the serial outputs, in order");
+
+  std::vector<float> serial(batchOutputs[0].size() / sizeof(float));
+  std::memcpy(serial.data(), batchOutputs[0].constData(), serial.size() * sizeof(float));
+  bool distinct = false;
+  for (size_t i = 2; i < serial.size(); i += 2) distinct = distinct || serial[i] != serial[0];
+  CHECK(distinct, "ANN predict threads: inputs give distinguishable outputs");
+
+  // Streaming predict (JSON Lines) goes through the same replicas chunk by chunk
+  QByteArray streamOutputs[2];
+  for (int t = 0; t < 2; t++) {
+    QString outputPath = tempDir() + "/ann_threads_stream_" + threadCounts[t] + ".jsonl";
+    auto result = runNNCLI({
+      "--config", trainedANNModelPath,
+      "--mode", "predict",
+      "--input", streamInputPath,
+      "--output", outputPath,
+      "--predict-threads", threadCounts[t]
+    });
+    CHECK(result.exitCode == 0, "ANN predict threads: streaming exit code 0");
+    QFile outputFile(outputPath);
+    if (outputFile.open(QIODevice::ReadOnly)) streamOutputs[t] = outputFile.readAll();
+  }
+
+  CHECK(streamOutputs[1] == streamOutputs[0], "ANN predict threads: streamed outputs match a serial stream");
+
+  // Line k of the stream holds the outputs of input k, as in the batch run
+  QList<QByteArray> outputLines = streamOutputs[1].trimmed().split('\n');
+  bool inOrder = (outputLines.size() == numInputs && serial.size() == static_cast<size_t>(numInputs) * 2);
+  for (int i = 0; inOrder && i < numInputs; i++) {
+    QJsonArray row = QJsonDocument::fromJson(outputLines[i]).array();
+    inOrder = row.size() == 2 && static_cast<float>(row[0].toDouble()) == serial[i * 2] &&
+              static_cast<float>(row[1].toDouble()) == serial[i * 2 + 1];
+  }
+  CHECK(inOrder, "ANN predict threads: streamed outputs in input order");
+
+  std::cout << std::endl;
+}
+
 static void testANNTrainWithWeightedLoss() {
   std::cout << "  testANNTrainWithWeightedLoss... ";
 
@@ -626,11 +786,56 @@ static void testANNDropoutRateParsing() {
 
 //===================================================================================================================//
 
+static void testANNPackAndTrain() {
+  std::cout << "  testANNPackAndTrain... ";
+
+  QString packedPath = tempDir() + "/ann_xor_samples.nnpack";
+
+  auto packResult = runNNCLI({
+    "--config", fixturePath("ann_train_config.json"),
+    "--mode", "pack",
+    "--samples", fixturePath("ann_train_samples.json"),
+    "--output", packedPath
+  });
+
+  CHECK(packResult.exitCode == 0, "ANN pack: exit code 0");
+  CHECK(packResult.stdOut.contains("Packed dataset saved to:"), "ANN pack: 'Packed dataset saved to:'");
+  CHECK(QFile::exists(packedPath), "ANN pack: packed file exists");
+
+  // Train and test from the packed file exactly as from the JSON samples
+  QString modelPath = tempDir() + "/ann_packed_model.json";
+  auto trainResult = runNNCLI({
+    "--config", fixturePath("ann_train_config.json"),
+    "--mode", "train",
+    "--samples", packedPath,
+    "--output", modelPath
+  });
+
+  CHECK(trainResult.exitCode == 0, "ANN train from packed: exit code 0");
+  CHECK(trainResult.stdOut.contains("Training completed."), "ANN train from packed: 'Training completed.'");
+
+  auto testResult = runNNCLI({
+    "--config", modelPath,
+    "--mode", "test",
+    "--samples", packedPath
+  });
+
+  CHECK(testResult.exitCode == 0, "ANN test from packed: exit code 0");
+  CHECK(testResult.stdOut.contains("Samples evaluated: 4"), "ANN test from packed: 'Samples evaluated: 4'");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
 void runANNTests() {
   // Train XOR first — downstream tests use its output model
   testANNTrainXOR();
   testANNNetworkDetection();
   testANNModeOverride();
+  testANNModelInfo();
+  testANNPredictNpyOutput();
+  testANNPredictThreadsMatchSerial();
   testANNTrainWithWeightedLoss();
   testANNCheckpointParameters();
   testANNShuffleSamplesCLI();
@@ -638,6 +843,7 @@ void runANNTests() {
   testANNTrainWithDropout();
   testANNTrainWithAugmentation();
   testANNDropoutRateParsing();
+  testANNPackAndTrain();
   // MNIST tests (--full only): train first, then predict/test using trained model
   testANNTrainAndTestMNIST();
   testANNTrainAndTestMNISTGPU();
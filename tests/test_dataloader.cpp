@@ -7,6 +7,8 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <numeric>
 #include <thread>
 #include <vector>
@@ -166,10 +168,637 @@ static void testNewEpochResetsPrefetch() {
 
 //===================================================================================================================//
 
+static void testPackedDatasetProvider() {
+  std::cout << "  testPackedDatasetProvider... ";
+
+  // 4 samples of a 1x2x2 image: uint8 inputs (k / 255) and float32 one-hot outputs
+  QString packedPath = tempDir() + "/dataloader_packed.nnpack";
+  QFile::remove(packedPath);
+  {
+    PackedDatasetWriter writer(packedPath.toStdString(), 4,
+                               4, PackedElementType::UINT8,
+                               2, PackedElementType::FLOAT32,
+                               1, 2, 2);
+    for (ulong i = 0; i < 4; i++) {
+      std::vector<float> input(4);
+      for (ulong j = 0; j < 4; j++) input[j] = static_cast<float>(i * 4 + j) / 255.0f;
+      std::vector<float> output = {i % 2 == 0 ? 1.0f : 0.0f, i % 2 == 0 ? 0.0f : 1.0f};
+      writer.writeSample(i, input.data(), output.data());
+      if (i == 1) {
+        CHECK(!QFile::exists(packedPath), "packed file only appears once finished");
+      }
+    }
+    writer.finish();
+  }
+
+  CHECK(PackedDataset::isPackedFile(packedPath.toStdString()), "packed file detected by magic");
+  CHECK(!QFile::exists(packedPath + ".tmp"), "temporary pack file renamed into place");
+
+  // Re-packing over an existing file replaces it in one step
+  QString replacedPath = tempDir() + "/dataloader_replaced.nnpack";
+  QFile previous(replacedPath);
+  if (previous.open(QIODevice::WriteOnly)) {
+    previous.write("previous dataset");
+    previous.close();
+  }
+  {
+    PackedDatasetWriter writer(replacedPath.toStdString(), 1, 1, PackedElementType::FLOAT32, 1, PackedElementType::FLOAT32);
+    float value = 1.0f;
+    writer.writeSample(0, &value, &value);
+    writer.finish();
+  }
+  CHECK(PackedDataset::isPackedFile(replacedPath.toStdString()), "existing file replaced by the finished pack");
+
+  // A writer abandoned before finish() (an aborted pack) leaves nothing that opens as a dataset
+  QString abortedPath = tempDir() + "/dataloader_aborted.nnpack";
+  {
+    PackedDatasetWriter writer(abortedPath.toStdString(), 2, 1, PackedElementType::FLOAT32, 1, PackedElementType::FLOAT32);
+    float value = 1.0f;
+    writer.writeSample(0, &value, &value);
+  }
+  CHECK(!QFile::exists(abortedPath) && !QFile::exists(abortedPath + ".tmp"), "aborted pack leaves no file behind");
+
+  // A header whose sample count overflows the size check is rejected rather than mapped
+  QString corruptPath = tempDir() + "/dataloader_corrupt.nnpack";
+  QFile::remove(corruptPath);
+  QFile::copy(packedPath, corruptPath);
+  QFile corrupt(corruptPath);
+  if (corrupt.open(QIODevice::ReadWrite)) {
+    uint64_t hugeCount = UINT64_MAX / 2;
+    corrupt.seek(offsetof(PackedHeader, numSamples));
+    corrupt.write(reinterpret_cast<const char*>(&hugeCount), sizeof(hugeCount));
+    corrupt.close();
+  }
+  bool rejected = false;
+  try {
+    PackedDataset dataset;
+    dataset.open(corruptPath.toStdString());
+  } catch (const std::runtime_error&) {
+    rejected = true;
+  }
+  CHECK(rejected, "packed header with overflowing sizes rejected");
+  CHECK(!PackedDataset::isPackedFile(fixturePath("ann_train_samples.json").toStdString()),
+        "JSON samples file is not detected as packed");
+
+  DataLoader<CNN::Sample<float>> loader;
+  loader.loadPacked(packedPath.toStdString(), 1, 2, 2);
+  CHECK(loader.numSamples() == 4, "packed loader has 4 samples");
+
+  auto provider = loader.makeSampleProvider();
+  std::vector<ulong> indices = {3, 2, 1, 0};
+
+  auto batch = provider(indices, 4, 0);
+  CHECK(batch.size() == 4, "packed batch has 4 samples");
+  CHECK(batch[0].input.data.size() == 4, "packed input has 4 values");
+  CHECK(batch[0].input.data[1] == 13.0f / 255.0f, "packed uint8 input decodes bit-exactly");
+  CHECK(batch[3].input.data[3] == 3.0f / 255.0f, "packed input follows shuffled indices");
+  CHECK(batch[0].output[1] == 1.0f && batch[1].output[0] == 1.0f, "packed outputs correct");
+
+  bool sizeMismatchThrown = false;
+  try {
+    DataLoader<CNN::Sample<float>> wrongShape;
+    wrongShape.loadPacked(packedPath.toStdString(), 1, 3, 3);
+  } catch (const std::runtime_error&) {
+    sizeMismatchThrown = true;
+  }
+  CHECK(sizeMismatchThrown, "packed input size mismatch is rejected");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+static void testManifestStreamingParse() {
+  std::cout << "  testManifestStreamingParse... ";
+
+  // Unknown keys (before and inside samples), escapes and exponents must all be handled by the streaming reader
+  QString samplesPath = tempDir() + "/dataloader_manifest.json";
+  QFile samplesFile(samplesPath);
+  if (samplesFile.open(QIODevice::WriteOnly)) {
+    samplesFile.write(R"({"note": {"text": "a \"quoted\" ] }", "list": [1, [2]]},
+      "samples": [
+        {"input": [0.1, -2.5e-1, 3], "output": [1, 0], "id": "s0"},
+        {"output": [0, 1], "input": [1E2, 0, -0.0]}
+      ]})");
+    samplesFile.close();
+  }
+
+  DataLoader<ANN::Sample<float>> loader;
+  loader.loadManifest(samplesPath.toStdString(), IOConfig(), 0, 0, 0);
+  CHECK(loader.numSamples() == 2, "manifest has 2 samples");
+
+  auto provider = loader.makeSampleProvider();
+  auto batch = provider({0, 1}, 2, 0);
+  CHECK(batch.size() == 2, "manifest batch has 2 samples");
+  CHECK(batch[0].input == std::vector<float>({0.1f, -0.25f, 3.0f}), "manifest input parsed");
+  CHECK(batch[1].input[0] == 100.0f, "manifest exponent parsed");
+  CHECK(batch[1].output == std::vector<float>({0.0f, 1.0f}), "manifest output parsed regardless of key order");
+
+  // Nested arrays are not valid sample vectors
+  QString badPath = tempDir() + "/dataloader_manifest_bad.json";
+  QFile badFile(badPath);
+  if (badFile.open(QIODevice::WriteOnly)) {
+    badFile.write(R"({"samples": [{"input": [[1, 2]], "output": [1]}]})");
+    badFile.close();
+  }
+
+  bool nestedThrown = false;
+  try {
+    DataLoader<ANN::Sample<float>> badLoader;
+    badLoader.loadManifest(badPath.toStdString(), IOConfig(), 0, 0, 0);
+  } catch (const std::runtime_error&) {
+    nestedThrown = true;
+  }
+  CHECK(nestedThrown, "nested input array is rejected");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+static void testParallelManifestParse() {
+  std::cout << "  testParallelManifestParse... ";
+
+  // Enough elements to be split across every parser thread
+  const ulong count = 5000;
+  auto writeSamples = [&](const QString& path, ulong missingOutput, ulong missingInput) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return;
+    file.write("{\"samples\": [");
+    for (ulong i = 0; i < count; i++) {
+      std::string input = "\"input\": [" + std::to_string(i) + ", " + std::to_string(i * 0.5) + "]";
+      std::string output = "\"output\": [" + std::to_string(i % 2) + "]";
+      std::string element = "{";
+      if (i != missingInput) element += input;
+      if (i != missingInput && i != missingOutput) element += ", ";
+      if (i != missingOutput) element += output;
+      element += (i + 1 < count) ? "}, " : "}";
+      file.write(element.c_str());
+    }
+    file.write("]}");
+  };
+
+  QString samplesPath = tempDir() + "/dataloader_parallel.json";
+  writeSamples(samplesPath, count, count);
+
+  DataLoader<ANN::Sample<float>> loader;
+  loader.loadManifest(samplesPath.toStdString(), IOConfig(), 0, 0, 0);
+  CHECK(loader.numSamples() == count, "parallel parse keeps every element");
+
+  std::vector<ulong> indices(count);
+  std::iota(indices.begin(), indices.end(), 0);
+  auto batch = loader.makeSampleProvider()(indices, count, 0);
+  bool ordered = batch.size() == count;
+  for (ulong i = 0; ordered && i < count; i++) {
+    ordered = batch[i].input == std::vector<float>({static_cast<float>(i), static_cast<float>(i * 0.5)}) &&
+              batch[i].output[0] == static_cast<float>(i % 2);
+  }
+  CHECK(ordered, "elements land in their serial order");
+
+  // With several malformed elements, the error is the one a serial parse would hit first
+  QString badPath = tempDir() + "/dataloader_parallel_bad.json";
+  writeSamples(badPath, 3000, 4500);
+
+  std::string error;
+  try {
+    DataLoader<ANN::Sample<float>> badLoader;
+    badLoader.loadManifest(badPath.toStdString(), IOConfig(), 0, 0, 0);
+  } catch (const std::runtime_error& e) {
+    error = e.what();
+  }
+  CHECK(error.find("Sample 3000 is missing 'output'") != std::string::npos, "lowest failing element is reported");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+static void testIDXProvider() {
+  std::cout << "  testIDXProvider... ";
+
+  // 3 items of 2x2 pixels with labels {2, 0, 1}; headers are big-endian
+  QString dataPath = tempDir() + "/dataloader_idx_images";
+  QString labelsPath = tempDir() + "/dataloader_idx_labels";
+  {
+    const unsigned char images[] = {0, 0, 8, 3,  0, 0, 0, 3,  0, 0, 0, 2,  0, 0, 0, 2,
+                                    0, 51, 102, 255,  10, 20, 30, 40,  1, 2, 3, 4};
+    const unsigned char labels[] = {0, 0, 8, 1,  0, 0, 0, 3,  2, 0, 1};
+    QFile dataFile(dataPath);
+    if (dataFile.open(QIODevice::WriteOnly)) {
+      dataFile.write(reinterpret_cast<const char*>(images), sizeof(images));
+      dataFile.close();
+    }
+    QFile labelsFile(labelsPath);
+    if (labelsFile.open(QIODevice::WriteOnly)) {
+      labelsFile.write(reinterpret_cast<const char*>(labels), sizeof(labels));
+      labelsFile.close();
+    }
+  }
+
+  DataLoader<CNN::Sample<float>> loader;
+  loader.loadIDX(dataPath.toStdString(), labelsPath.toStdString(), 1, 2, 2);
+  CHECK(loader.numSamples() == 3, "IDX loader has 3 samples");
+
+  auto outputs = loader.getAllOutputs();
+  CHECK(outputs.size() == 3 && outputs[0] == std::vector<float>({0.0f, 0.0f, 1.0f}), "IDX label one-hot encoded");
+
+  auto provider = loader.makeSampleProvider();
+  auto batch = provider({1, 0}, 2, 0);
+  CHECK(batch.size() == 2, "IDX batch has 2 samples");
+  CHECK(batch[1].input.data[1] == 51.0f / 255.0f && batch[1].input.data[3] == 1.0f, "IDX input normalised to [0, 1]");
+  CHECK(batch[0].input.data[0] == 10.0f / 255.0f, "IDX input follows indices");
+  CHECK(batch[0].output == std::vector<float>({1.0f, 0.0f, 0.0f}), "IDX output follows indices");
+
+  bool sizeMismatchThrown = false;
+  try {
+    DataLoader<CNN::Sample<float>> wrongShape;
+    wrongShape.loadIDX(dataPath.toStdString(), labelsPath.toStdString(), 1, 3, 3);
+  } catch (const std::runtime_error&) {
+    sizeMismatchThrown = true;
+  }
+  CHECK(sizeMismatchThrown, "IDX item size mismatch is rejected");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+// Write a version 1.0 .npy file with the given header fields and raw little-endian data.
+static void writeNpy(const QString& path, const std::string& descr, const std::string& shape,
+                     const void* data, size_t bytes) {
+  std::string header = "{'descr': '" + descr + "', 'fortran_order': False, 'shape': " + shape + ", }";
+  while ((10 + header.size() + 1) % 64 != 0) header += ' ';
+  header += '\n';
+
+  std::string prefix = std::string("\x93NUMPY", 6) + '\x01' + '\x00';
+  prefix += static_cast<char>(header.size() & 0xFF);
+  prefix += static_cast<char>(header.size() >> 8);
+
+  QFile file(path);
+  if (file.open(QIODevice::WriteOnly)) {
+    file.write(prefix.data(), prefix.size());
+    file.write(header.data(), header.size());
+    file.write(static_cast<const char*>(data), bytes);
+    file.close();
+  }
+}
+
+//===================================================================================================================//
+
+static void testNpyProvider() {
+  std::cout << "  testNpyProvider... ";
+
+  // 3 float32 inputs of shape (1, 2, 2) with int64 class labels {2, 0, 1}
+  QString inputsPath = tempDir() + "/dataloader_inputs.npy";
+  QString labelsPath = tempDir() + "/dataloader_labels.npy";
+  QString outputsPath = tempDir() + "/dataloader_outputs.npy";
+  QString bytesPath = tempDir() + "/dataloader_bytes.npy";
+  QString bigEndianPath = tempDir() + "/dataloader_big_endian.npy";
+
+  const float inputs[] = {0.5f, -1.25f, 3.0f, 1e-7f,  1.0f, 2.0f, 3.0f, 4.0f,  -0.0f, 0.1f, 0.2f, 0.3f};
+  const int64_t labels[] = {2, 0, 1};
+  const double outputs[] = {0.25, 0.75,  1.0, 0.0,  0.5, 0.5};
+  const unsigned char bytes[] = {0, 51, 102, 255};
+  writeNpy(inputsPath, "<f4", "(3, 1, 2, 2)", inputs, sizeof(inputs));
+  writeNpy(labelsPath, "<i8", "(3,)", labels, sizeof(labels));
+  writeNpy(outputsPath, "<f8", "(3, 2)", outputs, sizeof(outputs));
+  writeNpy(bytesPath, "|u1", "(1, 4)", bytes, sizeof(bytes));
+  writeNpy(bigEndianPath, ">f4", "(3, 4)", inputs, sizeof(inputs));
+
+  CHECK(NpyDataset::isNpyFile(inputsPath.toStdString()), ".npy file detected by magic");
+
+  DataLoader<CNN::Sample<float>> loader;
+  loader.loadNpy(inputsPath.toStdString(), labelsPath.toStdString(), 1, 2, 2);
+  CHECK(loader.numSamples() == 3, ".npy loader has 3 samples");
+
+  auto batch = loader.makeSampleProvider()({1, 0}, 2, 0);
+  CHECK(batch[1].input.data == std::vector<float>({0.5f, -1.25f, 3.0f, 1e-7f}), "float32 rows copied exactly");
+  CHECK(batch[0].input.data[3] == 4.0f, ".npy input follows indices");
+  CHECK(batch[1].output == std::vector<float>({0.0f, 0.0f, 1.0f}), "integer labels one-hot encoded");
+
+  // float64 output rows are used as-is; uint8 inputs are normalised like IDX images
+  NpyDataset regression;
+  regression.open(inputsPath.toStdString(), outputsPath.toStdString());
+  CHECK(regression.outputSize() == 2 && regression.output(0) == std::vector<float>({0.25f, 0.75f}),
+        "float64 outputs converted");
+
+  NpyDataset byteInputs;
+  byteInputs.open(bytesPath.toStdString());
+  CHECK(byteInputs.outputSize() == 0 && byteInputs.input(0)[1] == 51.0f / 255.0f, "uint8 inputs normalised");
+
+  bool bigEndianThrown = false;
+  try {
+    NpyDataset bigEndian;
+    bigEndian.open(bigEndianPath.toStdString());
+  } catch (const std::runtime_error&) {
+    bigEndianThrown = true;
+  }
+  CHECK(bigEndianThrown, "big-endian arrays are rejected");
+
+  bool countMismatchThrown = false;
+  try {
+    NpyDataset mismatch;
+    mismatch.open(bytesPath.toStdString(), labelsPath.toStdString());
+  } catch (const std::runtime_error&) {
+    countMismatchThrown = true;
+  }
+  CHECK(countMismatchThrown, "inputs/outputs row count mismatch is rejected");
+
+  // Predict inputs load straight from the array
+  IOConfig ioConfig;
+  auto predictInputs = Loader::loadANNInputs(inputsPath.toStdString(), ioConfig, 0);
+  CHECK(predictInputs.size() == 3 && predictInputs[2][2] == 0.2f, "predict inputs read from .npy");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+static void testParallelImageInputs() {
+  std::cout << "  testParallelImageInputs... ";
+
+  // Distinct 1x2 grayscale images, so any reordering during the concurrent decode shows up
+  const ulong count = 40;
+  QString inputsPath = tempDir() + "/parallel_images.json";
+  std::string json = "{\"inputs\": [";
+  for (ulong i = 0; i < count; i++) {
+    std::string name = "parallel_image_" + std::to_string(i) + ".png";
+    std::vector<float> pixels = {static_cast<float>(i) / 255.0f, static_cast<float>(i + 100) / 255.0f};
+    ImageLoader::saveImage((tempDir() + "/").toStdString() + name, pixels, 1, 1, 2);
+    json += "\"" + name + "\"" + ((i + 1 < count) ? ", " : "");
+  }
+  json += "]}";
+
+  QFile inputsFile(inputsPath);
+  if (inputsFile.open(QIODevice::WriteOnly)) {
+    inputsFile.write(json.c_str());
+    inputsFile.close();
+  }
+
+  IOConfig ioConfig;
+  ioConfig.inputType = DataType::IMAGE;
+  ioConfig.inputC = 1;
+  ioConfig.inputH = 1;
+  ioConfig.inputW = 2;
+  auto inputs = Loader::loadANNInputs(inputsPath.toStdString(), ioConfig, 0);
+
+  bool ordered = inputs.size() == count;
+  for (ulong i = 0; ordered && i < count; i++) {
+    ordered = inputs[i] == std::vector<float>({static_cast<float>(i) / 255.0f, static_cast<float>(i + 100) / 255.0f});
+  }
+  CHECK(ordered, "concurrently decoded images keep input order");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+static void testResidentStorage() {
+  std::cout << "  testResidentStorage... ";
+
+  // uint8: values on the k/255 grid survive exactly, at a quarter of the size
+  ANN::Samples<float> imageSamples(4);
+  for (ulong i = 0; i < 4; i++) {
+    imageSamples[i].input = {static_cast<float>(i) / 255.0f, 1.0f, 0.0f, static_cast<float>(200 + i) / 255.0f};
+    imageSamples[i].output = {static_cast<float>(i)};
+  }
+
+  DataLoader<ANN::Sample<float>> uint8Loader;
+  uint8Loader.loadFromMemory(std::move(imageSamples), 1, 2, 2, PackedElementType::UINT8);
+  CHECK(uint8Loader.numSamples() == 4, "uint8 resident loader has 4 samples");
+
+  auto uint8Batch = uint8Loader.makeSampleProvider()({2, 3}, 2, 0);
+  CHECK(uint8Batch[0].input[0] == 2.0f / 255.0f && uint8Batch[0].input[3] == 202.0f / 255.0f,
+        "uint8 resident input decodes bit-exactly");
+  CHECK(uint8Batch[1].output[0] == 3.0f, "resident output kept as float32");
+
+  // fp16: vectors are rounded to half precision
+  ANN::Samples<float> vectorSamples(2);
+  vectorSamples[0].input = {0.5f, -2.0f, 1000.25f};
+  vectorSamples[0].output = {1.0f};
+  vectorSamples[1].input = {0.1f, 65504.0f, 1e-8f};
+  vectorSamples[1].output = {0.0f};
+
+  DataLoader<ANN::Sample<float>> fp16Loader;
+  size_t bytes = fp16Loader.makeResident(PackedElementType::FLOAT16);
+  CHECK(bytes == 0, "makeResident on an empty loader holds nothing");
+  fp16Loader.loadFromMemory(std::move(vectorSamples), 0, 0, 0, PackedElementType::FLOAT16);
+
+  auto fp16Batch = fp16Loader.makeSampleProvider()({0, 1}, 2, 0);
+  CHECK(fp16Batch[0].input == std::vector<float>({0.5f, -2.0f, 1000.0f}), "fp16 resident input rounds to nearest half");
+  CHECK(fp16Batch[1].input[1] == 65504.0f, "fp16 resident keeps the largest half");
+  CHECK_NEAR(fp16Batch[1].input[0], 0.1f, 1e-4f, "fp16 resident input is close to the original");
+
+  // Ragged samples cannot be stored as fixed-size records
+  ANN::Samples<float> ragged(2);
+  ragged[0].input = {1.0f};
+  ragged[0].output = {1.0f};
+  ragged[1].input = {1.0f, 2.0f};
+  ragged[1].output = {1.0f};
+
+  bool raggedThrown = false;
+  try {
+    DataLoader<ANN::Sample<float>> raggedLoader;
+    raggedLoader.loadFromMemory(std::move(ragged), 0, 0, 0, PackedElementType::FLOAT16);
+  } catch (const std::runtime_error&) {
+    raggedThrown = true;
+  }
+  CHECK(raggedThrown, "resident storage rejects samples of different sizes");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+static void testImageCache() {
+  std::cout << "  testImageCache... ";
+
+  // 4x2 RGB image, loaded at 2x1 so the cached entry holds resized pixels
+  QString imagePath = tempDir() + "/cache_source.png";
+  std::vector<float> image(3 * 2 * 4);
+  for (size_t i = 0; i < image.size(); i++) image[i] = static_cast<float>(i * 10) / 255.0f;
+  ImageLoader::saveImage(imagePath.toStdString(), image, 3, 2, 4);
+
+  QString cacheDir = tempDir() + "/image_cache";
+  QDir(cacheDir).removeRecursively();
+
+  std::vector<float> uncached = ImageLoader::loadImage(imagePath.toStdString(), 3, 1, 2);
+
+  ImageLoader::setCacheDirectory(cacheDir.toStdString());
+  std::vector<float> firstLoad = ImageLoader::loadImage(imagePath.toStdString(), 3, 1, 2);
+  ulong entries = QDir(cacheDir).entryList(QDir::Files).size();
+  std::vector<float> secondLoad = ImageLoader::loadImage(imagePath.toStdString(), 3, 1, 2);
+  std::vector<float> otherShape = ImageLoader::loadImage(imagePath.toStdString(), 1, 2, 4);
+  ulong entriesAfterOtherShape = QDir(cacheDir).entryList(QDir::Files).size();
+  ImageLoader::setCacheDirectory("");
+
+  CHECK(entries == 1, "decoded image written to cache");
+  CHECK(firstLoad == uncached && secondLoad == uncached, "cached image is bit-identical to a fresh decode");
+  CHECK(otherShape.size() == 8 && entriesAfterOtherShape == 2, "different target shape gets its own entry");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+static void testSampleCache() {
+  std::cout << "  testSampleCache... ";
+
+  // Two 2x2 grayscale image samples
+  QString samplesPath = tempDir() + "/dataloader_cache_samples.json";
+  for (int i = 0; i < 2; i++) {
+    std::vector<float> pixels = {0.0f, 0.2f, 0.4f + 0.2f * i, 1.0f};
+    ImageLoader::saveImage((tempDir() + "/cache_sample" + QString::number(i) + ".png").toStdString(), pixels, 1, 2, 2);
+  }
+  QFile samplesFile(samplesPath);
+  if (samplesFile.open(QIODevice::WriteOnly)) {
+    samplesFile.write(R"({"samples": [{"input": "cache_sample0.png", "output": [1, 0]},
+                                      {"input": "cache_sample1.png", "output": [0, 1]}]})");
+    samplesFile.close();
+  }
+
+  IOConfig ioConfig;
+  ioConfig.inputType = DataType::IMAGE;
+
+  DataLoader<CNN::Sample<float>> loader;
+  loader.loadManifest(samplesPath.toStdString(), ioConfig, 1, 2, 2);
+  loader.setCacheBudget(1024 * 1024);
+  loader.planAugmentation(2, false); // 2 originals + 2 augmented entries
+
+  // Augmentation that always fires and always changes the pixels
+  Loader::AugmentationTransforms transforms;
+  transforms.horizontalFlip = true;
+  transforms.rotation = 0.0f;
+  transforms.translation = 0.0f;
+  transforms.brightness = 0.0f;
+  transforms.contrast = 0.0f;
+  transforms.gaussianNoise = 0.0f;
+
+  auto provider = loader.makeSampleProvider(transforms, 1.0f);
+  auto firstEpoch = provider({0, 1}, 2, 0);
+  auto cache = loader.getCache();
+  CHECK(cache && cache->getMisses() == 2 && cache->getHits() == 0, "first epoch decodes and caches");
+
+  auto augmented = loader.makeSampleProvider(transforms, 1.0f)({2, 3}, 2, 0);
+  auto secondEpoch = loader.makeSampleProvider(transforms, 1.0f)({1, 0}, 2, 0);
+  CHECK(cache->getHits() == 4, "later loads are served from the cache");
+  CHECK(augmented[0].input.data[0] == 0.2f || augmented[1].input.data[0] == 0.2f,
+        "augmented entries are transformed");
+  CHECK(secondEpoch[1].input.data == firstEpoch[0].input.data && secondEpoch[1].input.data[0] == 0.0f,
+        "augmentation does not modify the cached base sample");
+
+  // A budget smaller than one sample caches nothing
+  DataLoader<CNN::Sample<float>> tinyLoader;
+  tinyLoader.loadManifest(samplesPath.toStdString(), ioConfig, 1, 2, 2);
+  tinyLoader.setCacheBudget(1);
+  tinyLoader.makeSampleProvider()({0, 1}, 2, 0);
+  CHECK(tinyLoader.getCache()->getBytesUsed() == 0, "samples larger than the budget are not cached");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+static void testShardedStreaming() {
+  std::cout << "  testShardedStreaming... ";
+
+  // 3 shards of 4, 3 and 5 samples with input = {global index}
+  QString shardDir = tempDir() + "/dataloader_shards";
+  QDir(shardDir).removeRecursively();
+  QDir().mkpath(shardDir);
+
+  ulong shardSizes[] = {4, 3, 5};
+  ulong next = 0;
+  for (ulong s = 0; s < 3; s++) {
+    PackedDatasetWriter writer((shardDir + "/shard-" + QString::number(s) + ".nnpack").toStdString(), shardSizes[s],
+                               1, PackedElementType::FLOAT32, 3, PackedElementType::FLOAT32);
+    for (ulong i = 0; i < shardSizes[s]; i++, next++) {
+      float input = static_cast<float>(next);
+      std::vector<float> output(3, 0.0f);
+      output[next % 3] = 1.0f;
+      writer.writeSample(i, &input, output.data());
+    }
+    writer.finish();
+  }
+
+  std::vector<std::string> shardPaths = ShardedDataset::listShards(shardDir.toStdString());
+  CHECK(shardPaths.size() == 3, "three shards listed");
+
+  // Every epoch must yield every sample exactly once, whatever the shard order and buffer draw
+  Loader::AugmentationTransforms noNoise;
+  noNoise.gaussianNoise = 0.0f;
+  auto runEpoch = [&noNoise](DataLoader<ANN::Sample<float>>& loader, ulong batchSize) {
+    auto provider = loader.makeSampleProvider(noNoise);
+    std::vector<ulong> indices(loader.numSamples());
+    std::vector<float> seen;
+    for (ulong b = 0; b * batchSize < indices.size(); b++) {
+      for (const auto& sample : provider(indices, batchSize, b)) seen.push_back(sample.input[0]);
+    }
+    return seen;
+  };
+
+  DataLoader<ANN::Sample<float>> loader;
+  loader.loadShards(shardPaths, 0, 0, 0, 4);
+  CHECK(loader.numSamples() == 12, "sharded loader has 12 samples");
+
+  std::vector<float> expected(12);
+  std::iota(expected.begin(), expected.end(), 0.0f);
+  for (int epoch = 0; epoch < 2; epoch++) {
+    std::vector<float> seen = runEpoch(loader, 5);
+    std::sort(seen.begin(), seen.end());
+    CHECK(seen == expected, "epoch streams every sample exactly once");
+  }
+
+  // Without a shuffle buffer the stream is each shard front to back, so the order only breaks between shards
+  DataLoader<ANN::Sample<float>> sequential;
+  sequential.loadShards(shardPaths, 0, 0, 0, 0);
+  std::vector<float> order = runEpoch(sequential, 1);
+  int breaks = 0;
+  for (size_t i = 1; i < order.size(); i++) {
+    if (order[i] != order[i - 1] + 1.0f) breaks++;
+  }
+  CHECK(order.size() == 12 && breaks <= 2, "shards are read sequentially");
+
+  // Not streamed (re-packing): records come back at exactly the requested indices, every time
+  DataLoader<ANN::Sample<float>> indexed;
+  indexed.loadShards(shardPaths, 0, 0, 0, 0, false);
+  auto indexedProvider = indexed.makeSampleProvider(noNoise);
+  std::vector<ulong> forward(12);
+  std::iota(forward.begin(), forward.end(), 0);
+  std::vector<float> indexedOrder;
+  for (ulong b = 0; b * 5 < forward.size(); b++) {
+    for (const auto& sample : indexedProvider(forward, 5, b)) indexedOrder.push_back(sample.input[0]);
+  }
+  CHECK(indexedOrder == expected, "unstreamed shards are read in index order");
+
+  // Augmented copies (unchanged here, without noise) are streamed along with their source record
+  DataLoader<ANN::Sample<float>> augmented;
+  augmented.loadShards(shardPaths, 0, 0, 0, 4);
+  augmented.planAugmentation(2, false);
+  std::vector<float> seen = runEpoch(augmented, 5);
+  bool allPresent = true;
+  for (float v : expected) allPresent = allPresent && std::count(seen.begin(), seen.end(), v) >= 1;
+  CHECK(seen.size() == 24 && allPresent, "augmented epoch streams originals plus their copies");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
 void runDataLoaderTests() {
   testProviderReturnsCorrectBatches();
   testProviderRespectsShuffledIndices();
   testPrefetchOverlapsWithProcessing();
   testNewEpochResetsPrefetch();
+  testPackedDatasetProvider();
+  testManifestStreamingParse();
+  testParallelManifestParse();
+  testIDXProvider();
+  testNpyProvider();
+  testParallelImageInputs();
+  testResidentStorage();
+  testImageCache();
+  testSampleCache();
+  testShardedStreaming();
 }
 
@@ -20,7 +20,7 @@ static void testInvalidMode() {
   });
 
   CHECK(result.exitCode == 1, "Invalid mode: exit code 1");
-  CHECK(result.stdErr.contains("Error: Mode must be 'train', 'predict', or 'test'."),
+  CHECK(result.stdErr.contains("Error: Mode must be 'train', 'predict', 'test', 'pack', 'serve', 'convert', or 'info'."),
         "Invalid mode: error message");
   std::cout << std::endl;
 }
@@ -92,6 +92,39 @@ static void testPredictWithoutInput() {
   std::cout << std::endl;
 }
 
+static void testStreamingPredictToJsonFile() {
+  std::cout << "  testStreamingPredictToJsonFile... ";
+
+  if (trainedANNModelPath.isEmpty() || !QFile::exists(trainedANNModelPath)) {
+    CHECK(false, "Streaming predict to .json: skipped — no trained model available (testANNTrainXOR must run first)");
+    std::cout << std::endl;
+    return;
+  }
+
+  QString inputPath = tempDir() + "/stream_json_output.jsonl";
+  QFile inputFile(inputPath);
+  if (inputFile.open(QIODevice::WriteOnly)) {
+    inputFile.write("[0, 1]\n");
+    inputFile.close();
+  }
+
+  // A *.json output would otherwise silently receive JSON Lines
+  QString outputPath = tempDir() + "/stream_json_output.json";
+  QFile::remove(outputPath);
+  auto result = runNNCLI({
+    "--config", trainedANNModelPath,
+    "--mode", "predict",
+    "--input", inputPath,
+    "--output", outputPath
+  });
+
+  CHECK(result.exitCode == 1, "Streaming predict to .json: exit code 1");
+  CHECK(result.stdErr.contains("not json") && result.stdErr.contains(".jsonl"),
+        "Streaming predict to .json: error message");
+  CHECK(!QFile::exists(outputPath), "Streaming predict to .json: no output written");
+  std::cout << std::endl;
+}
+
 static void testIdxWithoutLabels() {
   std::cout << "  testIdxWithoutLabels... ";
 
@@ -126,6 +159,24 @@ static void testBothSamplesAndIdx() {
   std::cout << std::endl;
 }
 
+static void testResidentWithSampleCache() {
+  std::cout << "  testResidentWithSampleCache... ";
+
+  auto result = runNNCLI({
+    "--config", fixturePath("ann_train_config.json"),
+    "--mode", "train",
+    "--device", "cpu",
+    "--samples", fixturePath("ann_train_samples.json"),
+    "--resident", "fp16",
+    "--sample-cache", "64"
+  });
+
+  CHECK(result.exitCode == 1, "Resident with sample cache: exit code 1");
+  CHECK(result.stdErr.contains("Cannot use both --resident and --sample-cache"),
+        "Resident with sample cache: error message");
+  std::cout << std::endl;
+}
+
 static void testInvalidActvFuncANN() {
   std::cout << "  testInvalidActvFuncANN... ";
 
@@ -181,8 +232,10 @@ void runErrorTests() {
   testMissingSamplesANN();
   testMissingSamplesCNN();
   testPredictWithoutInput();
+  testStreamingPredictToJsonFile();
   testIdxWithoutLabels();
   testBothSamplesAndIdx();
+  testResidentWithSampleCache();
   testInvalidActvFuncANN();
   testInvalidActvFuncCNN();
   testInvalidCostFuncANN();
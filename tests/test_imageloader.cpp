@@ -0,0 +1,169 @@
+#include "test_helpers.hpp"
+#include "../NN-CLI_ImageLoader.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace NN_CLI;
+
+//===================================================================================================================//
+
+static void testImageDecoderBackends() {
+  std::cout << "  testImageDecoderBackends... ";
+
+  CHECK(ImageLoader::parseDecoderBackend("stb") == ImageLoader::DecoderBackend::STB, "stb decoder parsed");
+  CHECK(ImageLoader::parseDecoderBackend("libjpeg") == ImageLoader::DecoderBackend::LIBJPEG, "libjpeg decoder parsed");
+  CHECK(ImageLoader::isDecoderBackendAvailable(ImageLoader::DecoderBackend::STB), "stb decoder always available");
+
+  if (!ImageLoader::isDecoderBackendAvailable(ImageLoader::DecoderBackend::LIBJPEG)) {
+    bool threw = false;
+    try {
+      ImageLoader::setDecoderBackend(ImageLoader::DecoderBackend::LIBJPEG);
+    } catch (const std::runtime_error&) {
+      threw = true;
+    }
+    CHECK(threw, "unavailable decoder rejected");
+    std::cout << "(libjpeg checks skipped — built without libjpeg)" << std::endl;
+    return;
+  }
+
+  // A smooth 3x240x320 image, so scaled and full-size decodes agree closely after resizing
+  const int c = 3, h = 240, w = 320;
+  std::vector<float> image(c * h * w);
+  for (int ch = 0; ch < c; ch++) {
+    for (int y = 0; y < h; y++) {
+      for (int x = 0; x < w; x++) {
+        image[(ch * h + y) * w + x] = 0.5f + 0.4f * std::sin(x * 0.02f + ch) * std::cos(y * 0.03f);
+      }
+    }
+  }
+
+  QString dir = tempDir() + "/image_decoder";
+  QDir(dir).removeRecursively();
+  QDir().mkpath(dir);
+  std::string jpgPath = (dir + "/image.jpg").toStdString();
+  std::string pngPath = (dir + "/image.png").toStdString();
+  ImageLoader::saveImage(jpgPath, image, c, h, w);
+  ImageLoader::saveImage(pngPath, image, c, h, w);
+
+  // 30x40 is 1/8 of the source: libjpeg decodes it straight at that size
+  bool jpegClose = true, pngIdentical = true;
+  for (int targetC : {1, 3}) {
+    for (auto [targetH, targetW] : {std::pair<int, int>{h, w}, {30, 40}, {24, 32}}) {
+      ImageLoader::setDecoderBackend(ImageLoader::DecoderBackend::STB);
+      std::vector<float> stbJpeg = ImageLoader::loadImage(jpgPath, targetC, targetH, targetW);
+      std::vector<float> stbPng = ImageLoader::loadImage(pngPath, targetC, targetH, targetW);
+
+      ImageLoader::setDecoderBackend(ImageLoader::DecoderBackend::LIBJPEG);
+      std::vector<float> libJpeg = ImageLoader::loadImage(jpgPath, targetC, targetH, targetW);
+      std::vector<float> libPng = ImageLoader::loadImage(pngPath, targetC, targetH, targetW);
+
+      for (size_t i = 0; i < stbJpeg.size(); i++) {
+        if (std::fabs(stbJpeg[i] - libJpeg[i]) > 0.05f) jpegClose = false;
+      }
+      if (libPng != stbPng) pngIdentical = false;
+    }
+  }
+  CHECK(jpegClose, "libjpeg decodes (full size and scaled) match stb closely");
+  CHECK(pngIdentical, "non-JPEG files still decoded by stb");
+
+  // 8x8 blocks of two levels: a 1/8 IDCT decode keeps each block's exact level (its DC term), while a full-size
+  // decode resized down blends neighbouring blocks, so only the scaled path reproduces the pattern
+  std::vector<float> blocks(h * w);
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) blocks[y * w + x] = ((x / 8 + y / 8) % 2) ? 0.8f : 0.2f;
+  }
+  std::string blocksPath = (dir + "/blocks.jpg").toStdString();
+  ImageLoader::saveImage(blocksPath, blocks, 1, h, w);
+
+  ImageLoader::setDecoderBackend(ImageLoader::DecoderBackend::STB);
+  std::vector<float> resizedBlocks = ImageLoader::loadImage(blocksPath, 1, h / 8, w / 8);
+  ImageLoader::setDecoderBackend(ImageLoader::DecoderBackend::LIBJPEG);
+  std::vector<float> scaledBlocks = ImageLoader::loadImage(blocksPath, 1, h / 8, w / 8);
+
+  float resizedError = 0.0f, scaledError = 0.0f;
+  for (int y = 0; y < h / 8; y++) {
+    for (int x = 0; x < w / 8; x++) {
+      float level = ((x + y) % 2) ? 0.8f : 0.2f;
+      resizedError = std::max(resizedError, std::fabs(resizedBlocks[y * (w / 8) + x] - level));
+      scaledError = std::max(scaledError, std::fabs(scaledBlocks[y * (w / 8) + x] - level));
+    }
+  }
+  CHECK(scaledError < 0.02f && resizedError > 0.1f, "libjpeg decodes 1/8 targets straight from the DCT");
+
+  // Files libjpeg rejects fall back to stb, which reports the failure
+  std::string brokenPath = (dir + "/broken.jpg").toStdString();
+  QFile broken(QString::fromStdString(brokenPath));
+  const char brokenBytes[] = "\xFF\xD8\xFF\x00 not a jpeg";
+  broken.open(QIODevice::WriteOnly);
+  broken.write(brokenBytes, sizeof(brokenBytes) - 1);
+  broken.close();
+  bool threw = false;
+  try {
+    ImageLoader::loadImage(brokenPath, c, h, w);
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  CHECK(threw, "corrupt JPEG reported");
+
+  ImageLoader::setDecoderBackend(ImageLoader::DecoderBackend::STB);
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+static void testImageLoadScratch() {
+  std::cout << "  testImageLoadScratch... ";
+
+  // Two images of different sizes, so the per-thread scratch buffers grow and are reused smaller
+  QString dir = tempDir() + "/image_scratch";
+  QDir(dir).removeRecursively();
+  QDir().mkpath(dir);
+  std::string smallPath = (dir + "/small.png").toStdString();
+  std::string largePath = (dir + "/large.png").toStdString();
+  std::vector<float> small(3 * 4 * 6), large(3 * 20 * 30);
+  for (size_t i = 0; i < small.size(); i++) small[i] = static_cast<float>((i * 37) % 256) / 255.0f;
+  for (size_t i = 0; i < large.size(); i++) large[i] = static_cast<float>((i * 11) % 256) / 255.0f;
+  ImageLoader::saveImage(smallPath, small, 3, 4, 6);
+  ImageLoader::saveImage(largePath, large, 3, 20, 30);
+
+  std::vector<float> expectedLarge = ImageLoader::loadImage(largePath, 3, 10, 15);
+  std::vector<float> expectedSmall = ImageLoader::loadImage(smallPath, 1, 4, 6);
+
+  // Decoding into caller buffers gives the same tensors, whatever the scratch held before
+  bool identical = true;
+  std::vector<float> largeSlot(3 * 10 * 15), smallSlot(1 * 4 * 6);
+  for (int round = 0; round < 3; round++) {
+    ImageLoader::loadImage(largePath, 3, 10, 15, largeSlot.data());
+    ImageLoader::loadImage(smallPath, 1, 4, 6, smallSlot.data());
+    if (largeSlot != expectedLarge || smallSlot != expectedSmall) identical = false;
+  }
+  CHECK(identical, "images decoded into existing buffers match fresh decodes");
+
+  // Rotation and translation write through scratch and swap it in: same seed, same result, same size
+  bool deterministic = true;
+  for (int round = 0; round < 3; round++) {
+    std::vector<float> first = (round % 2 == 0) ? expectedLarge : expectedSmall;
+    std::vector<float> second = first;
+    int c = (round % 2 == 0) ? 3 : 1, h = (round % 2 == 0) ? 10 : 4, w = (round % 2 == 0) ? 15 : 6;
+    for (std::vector<float>* data : {&first, &second}) {
+      std::mt19937 rng(42);
+      ImageLoader::randomRotation(*data, c, h, w, 30.0f, rng);
+      ImageLoader::randomTranslation(*data, c, h, w, 0.3f, rng);
+    }
+    if (first != second || first.size() != static_cast<size_t>(c) * h * w) deterministic = false;
+  }
+  CHECK(deterministic, "geometric transforms repeatable across scratch reuse");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+void runImageLoaderTests() {
+  testImageDecoderBackends();
+  testImageLoadScratch();
+}
@@ -0,0 +1,65 @@
+#include "test_helpers.hpp"
+#include "../NN-CLI_ImageLoader.hpp"
+#include "../NN-CLI_ImageWriter.hpp"
+
+#include <vector>
+
+using namespace NN_CLI;
+
+//===================================================================================================================//
+
+static void testImageWriter() {
+  std::cout << "  testImageWriter... ";
+
+  // 3x5x7 RGB outputs on exact 8-bit levels, so they survive the round trip unchanged
+  const int c = 3, h = 5, w = 7;
+  const ulong numImages = 24;
+  std::vector<std::vector<float>> images(numImages, std::vector<float>(c * h * w));
+  for (ulong n = 0; n < numImages; n++) {
+    for (size_t i = 0; i < images[n].size(); i++) images[n][i] = static_cast<float>((n * 31 + i * 7) % 256) / 255.0f;
+  }
+
+  QString dir = tempDir() + "/image_writer";
+  QDir(dir).removeRecursively();
+  QDir().mkpath(dir);
+
+  // Compressed (default level) and stored PNGs decode to the same pixels
+  for (int level : {8, 0}) {
+    ImageLoader::setPngCompressionLevel(level);
+    {
+      ImageWriter writer(c, h, w, 4, 2);
+      for (ulong n = 0; n < numImages; n++) {
+        writer.submit((dir + "/" + QString::number(n) + ".png").toStdString(), images[n]);
+      }
+      writer.wait();
+      CHECK(writer.getNumWritten() == numImages, "every submitted image written");
+    }
+
+    bool identical = true;
+    for (ulong n = 0; n < numImages; n++) {
+      std::vector<float> loaded = ImageLoader::loadImage((dir + "/" + QString::number(n) + ".png").toStdString(), c, h, w);
+      if (loaded != images[n]) identical = false;
+    }
+    CHECK(identical, (level == 0 ? "stored PNGs read back exactly" : "compressed PNGs read back exactly"));
+  }
+  ImageLoader::setPngCompressionLevel(8);
+
+  // A failed image is reported by wait()
+  bool threw = false;
+  try {
+    ImageWriter writer(c, h, w);
+    writer.submit((dir + "/missing/0.png").toStdString(), images[0]);
+    writer.wait();
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  CHECK(threw, "image write failure reported");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+void runImageWriterTests() {
+  testImageWriter();
+}
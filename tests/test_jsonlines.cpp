@@ -0,0 +1,83 @@
+#include "test_helpers.hpp"
+#include "../NN-CLI_JsonLinesReader.hpp"
+
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+using namespace NN_CLI;
+
+//===================================================================================================================//
+
+static void testJsonLinesReader() {
+  std::cout << "  testJsonLinesReader... ";
+
+  CHECK(JsonLinesReader::isJsonLinesPath("-") && JsonLinesReader::isJsonLinesPath("inputs.NDJSON") &&
+        !JsonLinesReader::isJsonLinesPath("inputs.json"), "JSON Lines inputs recognised by path");
+
+  // Blank lines are skipped; arrays and image paths may be mixed, and the last line needs no newline
+  QString linesPath = tempDir() + "/predict_inputs.jsonl";
+  QFile linesFile(linesPath);
+  if (linesFile.open(QIODevice::WriteOnly)) {
+    linesFile.write("[1, 2]\n\n  [3.5, -4]  \r\n\"img/a.png\"\n[5, 6]");
+    linesFile.close();
+  }
+
+  JsonLinesReader reader(linesPath.toStdString());
+  auto first = reader.readChunk(2);
+  auto second = reader.readChunk(2);
+  auto third = reader.readChunk(2);
+  CHECK(first.size() == 2 && second.size() == 2 && third.empty(), "lines are read in bounded chunks");
+  CHECK(first[0].data == std::vector<float>({1.0f, 2.0f}) && first[1].data == std::vector<float>({3.5f, -4.0f}),
+        "numeric lines parsed in order");
+  CHECK(second[0].isPath && second[0].path == "img/a.png" && second[1].data == std::vector<float>({5.0f, 6.0f}),
+        "path line parsed");
+
+  // Errors name the offending line
+  QString badPath = tempDir() + "/predict_inputs_bad.jsonl";
+  QFile badFile(badPath);
+  if (badFile.open(QIODevice::WriteOnly)) {
+    badFile.write("[1, 2]\n[3, 4] 5\n");
+    badFile.close();
+  }
+
+  std::string error;
+  try {
+    JsonLinesReader badReader(badPath.toStdString());
+    badReader.readChunk(10);
+  } catch (const std::runtime_error& e) {
+    error = e.what();
+  }
+  CHECK(error.find("line 2") != std::string::npos, "malformed line is reported by number");
+
+  // Standard input hands over the lines that have arrived instead of waiting for a full chunk
+  int pipeFds[2];
+  int savedStdin = ::dup(STDIN_FILENO);
+  if (savedStdin >= 0 && ::pipe(pipeFds) == 0) {
+    ::dup2(pipeFds[0], STDIN_FILENO);
+    ::close(pipeFds[0]);
+
+    const char pending[] = "[7, 8]\n\n[9, 10]\n";
+    bool written = ::write(pipeFds[1], pending, sizeof(pending) - 1) == static_cast<ssize_t>(sizeof(pending) - 1);
+    JsonLinesReader stdinReader("-");
+    auto arrived = stdinReader.readChunk(256);
+    ::close(pipeFds[1]);
+    auto rest = stdinReader.readChunk(256);
+
+    CHECK(written && arrived.size() == 2 && arrived[1].data == std::vector<float>({9.0f, 10.0f}),
+          "stdin chunk returned without waiting for more lines");
+    CHECK(rest.empty(), "stdin end of input reported once the writer closes");
+
+    ::dup2(savedStdin, STDIN_FILENO);
+  }
+  if (savedStdin >= 0) ::close(savedStdin);
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+void runJsonLinesTests() {
+  testJsonLinesReader();
+}
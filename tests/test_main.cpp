@@ -12,6 +12,13 @@ void runANNTests();
 void runCNNTests();
 void runErrorTests();
 void runDataLoaderTests();
+void runJsonLinesTests();
+void runModelFileTests();
+void runPredictWriterTests();
+void runImageWriterTests();
+void runPixelConvertTests();
+void runImageLoaderTests();
+void runServerTests();
 
 int main(int argc, char* argv[]) {
   // Parse --full flag before QCoreApplication consumes argv
@@ -46,6 +53,34 @@ int main(int argc, char* argv[]) {
   std::cout << "=== DataLoader Tests ===" << std::endl;
   runDataLoaderTests();
 
+  std::cout << std::endl;
+  std::cout << "=== JSON Lines Tests ===" << std::endl;
+  runJsonLinesTests();
+
+  std::cout << std::endl;
+  std::cout << "=== Model File Tests ===" << std::endl;
+  runModelFileTests();
+
+  std::cout << std::endl;
+  std::cout << "=== Predict Writer Tests ===" << std::endl;
+  runPredictWriterTests();
+
+  std::cout << std::endl;
+  std::cout << "=== Image Writer Tests ===" << std::endl;
+  runImageWriterTests();
+
+  std::cout << std::endl;
+  std::cout << "=== Pixel Convert Tests ===" << std::endl;
+  runPixelConvertTests();
+
+  std::cout << std::endl;
+  std::cout << "=== Image Loader Tests ===" << std::endl;
+  runImageLoaderTests();
+
+  std::cout << std::endl;
+  std::cout << "=== Server Tests ===" << std::endl;
+  runServerTests();
+
   // Cleanup temp files
   cleanupTemp();
 
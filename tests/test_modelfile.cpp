@@ -0,0 +1,271 @@
+#include "test_helpers.hpp"
+#include "../NN-CLI_CheckpointWriter.hpp"
+#include "../NN-CLI_ModelFile.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NN_CLI;
+
+//===================================================================================================================//
+
+static void testModelFileRoundTrip() {
+  std::cout << "  testModelFileRoundTrip... ";
+
+  // Per-layer weight matrices of different sizes (the input layer has none), as in ANN parameters
+  std::vector<std::vector<std::vector<float>>> weights = {{}, {{0.1f, -0.2f}, {0.3f, 0.4f}, {-0.5f, 0.6f}},
+                                                          {{0.7f, 0.8f, -0.9f}}};
+  std::vector<std::vector<float>> biases = {{}, {0.01f, 0.02f, 0.03f}, {-0.04f}};
+  std::vector<float> filters(1000);
+  for (size_t i = 0; i < filters.size(); i++) filters[i] = static_cast<float>(i) * 0.001f - 0.5f;
+
+  nlohmann::ordered_json json;
+  json["mode"] = "train";
+  json["parameters"]["weights"] = weights;
+  json["parameters"]["biases"] = biases;
+  json["parameters"]["filters"] = filters;
+
+  ModelFileWriter writer;
+  nlohmann::ordered_json document = json;
+  document["parameters"]["weights"] = writer.addTensor(weights);
+  document["parameters"]["biases"] = writer.addTensor(biases);
+  document["parameters"]["filters"] = writer.addTensor(filters);
+
+  QString binaryPath = tempDir() + "/model_roundtrip.nnmodel";
+  writer.write(binaryPath.toStdString(), document);
+
+  CHECK(ModelFile::isModelFile(binaryPath.toStdString()) && ModelFile::isBinaryModelPath("a/b.NNMODEL") &&
+        !ModelFile::isBinaryModelPath("a/b.json"), "binary models recognised by magic and extension");
+
+  ModelFile model(binaryPath.toStdString());
+  const auto& params = model.getDocument().at("parameters");
+  CHECK(model.isBinary() && model.getDocument().at("mode") == "train", "document read from binary model");
+  CHECK(ModelFile::isTensorReference(params.at("filters")) && params.at("filters").at("offset").get<ulong>() % 64 == 0,
+        "tensors stored as aligned references");
+  CHECK(model.getTensor<std::vector<std::vector<std::vector<float>>>>(params.at("weights")) == weights &&
+        model.getTensor<std::vector<std::vector<float>>>(params.at("biases")) == biases &&
+        model.getTensor<std::vector<float>>(params.at("filters")) == filters, "tensors read back exactly");
+  CHECK(model.toJson() == json, "binary model expands to the original document");
+
+  // A crafted shape whose size wraps around to 0 is rejected instead of read past the data block
+  nlohmann::ordered_json wrappedDocument = document;
+  wrappedDocument["parameters"]["filters"]["shape"] = std::vector<ulong>{1ul << 32, 1ul << 32};
+  QString wrappedPath = tempDir() + "/model_wrapped.nnmodel";
+  writer.write(wrappedPath.toStdString(), wrappedDocument);
+  bool rejected = false;
+  try {
+    ModelFile wrapped(wrappedPath.toStdString());
+    wrapped.getTensor<std::vector<std::vector<float>>>(wrapped.getDocument().at("parameters").at("filters"));
+  } catch (const std::runtime_error&) {
+    rejected = true;
+  }
+  CHECK(rejected, "tensor shape that overflows rejected");
+
+  // JSON -> binary -> JSON conversion reproduces the file byte for byte
+  QString jsonPath = tempDir() + "/model_roundtrip.json";
+  QFile jsonFile(jsonPath);
+  if (jsonFile.open(QIODevice::WriteOnly)) {
+    jsonFile.write(json.dump(4).c_str());
+    jsonFile.close();
+  }
+  QString convertedPath = tempDir() + "/model_converted.nnmodel";
+  QString restoredPath = tempDir() + "/model_restored.json";
+  ModelFile::convert(jsonPath.toStdString(), convertedPath.toStdString(), true);
+  ModelFile::convert(convertedPath.toStdString(), restoredPath.toStdString(), false);
+
+  QFile original(jsonPath);
+  QFile restored(restoredPath);
+  bool identical = original.open(QIODevice::ReadOnly) && restored.open(QIODevice::ReadOnly) &&
+                   original.readAll() == restored.readAll();
+  CHECK(identical, "JSON model survives conversion unchanged");
+
+  // fp16 parameters: half the data, values within half precision
+  QString halfPath = tempDir() + "/model_half.nnmodel";
+  ModelFile::convert(jsonPath.toStdString(), halfPath.toStdString(), true, PackedElementType::FLOAT16);
+  ModelFile halfModel(halfPath.toStdString());
+  auto halfFilters = halfModel.getTensor<std::vector<float>>(halfModel.getDocument().at("parameters").at("filters"));
+  float maxError = 0.0f;
+  for (size_t i = 0; i < filters.size(); i++) maxError = std::max(maxError, std::abs(halfFilters[i] - filters[i]));
+  CHECK(halfModel.getElementType() == PackedElementType::FLOAT16 && halfFilters.size() == filters.size() &&
+        maxError < 1e-3f, "fp16 parameters decoded within half precision");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+static void testModelFileHeaderOnly() {
+  std::cout << "  testModelFileHeaderOnly... ";
+
+  // Parameters between other members, with strings that look like JSON structure
+  nlohmann::ordered_json json;
+  json["mode"] = "predict";
+  json["note"] = "brackets ]} and \"quotes\" in a string";
+  json["parameters"]["weights"] = std::vector<std::vector<std::vector<float>>>{{}, {{0.5f, -1.5e-3f}, {2.0f, 3.0f}}};
+  json["parameters"]["biases"] = std::vector<std::vector<float>>{{}, {1.0f, -2.0f}};
+  json["inputShape"] = {{"c", 1}, {"h", 2}, {"w", 2}};
+
+  nlohmann::ordered_json expected = json;
+  expected.erase("parameters");
+
+  bool headersMatch = true;
+  for (int indent : {-1, 4}) {
+    QString jsonPath = tempDir() + "/model_header.json";
+    QFile jsonFile(jsonPath);
+    if (jsonFile.open(QIODevice::WriteOnly)) {
+      jsonFile.write(json.dump(indent).c_str());
+      jsonFile.close();
+    }
+
+    ModelFile header(jsonPath.toStdString(), false);
+    headersMatch = headersMatch && header.getDocument() == expected && header.hasParameters() &&
+                   header.getNumParameters() == 6;
+  }
+  CHECK(headersMatch, "JSON header read without its parameters");
+
+  QString binaryPath = tempDir() + "/model_header.nnmodel";
+  ModelFileWriter writer;
+  nlohmann::ordered_json document = json;
+  document["parameters"] = writer.addTensors(json.at("parameters"));
+  writer.write(binaryPath.toStdString(), document);
+
+  ModelFile binaryHeader(binaryPath.toStdString(), false);
+  CHECK(binaryHeader.isBinary() && binaryHeader.getDocument().at("mode") == "predict" &&
+        binaryHeader.getNumParameters() == 6, "binary header read without mapping the data block");
+
+  bool threw = false;
+  try {
+    binaryHeader.getTensor<std::vector<float>>(binaryHeader.getDocument().at("parameters").at("biases").at(1));
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  CHECK(threw, "tensors unavailable from a header-only model");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+static void testModelFileJsonWriter() {
+  std::cout << "  testModelFileJsonWriter... ";
+
+  // Streamed files match json.dump(4) byte for byte, for any float values
+  std::vector<std::vector<std::vector<float>>> weights = {{}, {{0.5f, -1.25f, 3.0f}, {0.1f, 1048576.0f, -0.0f},
+                                                               {1e-7f, -3.4e38f, 123456.789f}}};
+  std::vector<std::vector<float>> biases = {{}, {0.25f, -2.0f, std::numeric_limits<float>::quiet_NaN()}};
+
+  nlohmann::ordered_json json;
+  json["mode"] = "train";
+  json["trainingConfig"]["learningRate"] = 0.1f;
+  json["parameters"]["weights"] = weights;
+  json["parameters"]["biases"] = biases;
+  json["parameters"]["empty"] = std::vector<float>{};
+
+  ModelFileWriter writer;
+  nlohmann::ordered_json document = json;
+  document["parameters"]["weights"] = writer.addTensor(weights);
+  document["parameters"]["biases"] = writer.addTensor(biases);
+  document["parameters"]["empty"] = writer.addTensor(std::vector<float>{});
+
+  QString jsonPath = tempDir() + "/model_streamed.json";
+  writer.writeJson(jsonPath.toStdString(), document);
+
+  QFile file(jsonPath);
+  bool identical = file.open(QIODevice::ReadOnly) && file.readAll().toStdString() == json.dump(4);
+  CHECK(identical, "streamed JSON matches json.dump(4)");
+
+  // Arbitrary values, more than one parallel chunk of them, read back exactly and print as json.dump(4) does
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> filters(300000);
+  for (auto& value : filters) value = dist(rng) * std::pow(10.0f, static_cast<float>(static_cast<int>(rng() % 20) - 10));
+
+  ModelFileWriter filtersWriter;
+  nlohmann::ordered_json filtersDocument;
+  filtersDocument["parameters"]["filters"] = filtersWriter.addTensor(filters);
+  QString filtersPath = tempDir() + "/model_streamed_filters.json";
+  filtersWriter.writeJson(filtersPath.toStdString(), filtersDocument);
+
+  ModelFile model(filtersPath.toStdString());
+  CHECK(model.getTensor<std::vector<float>>(model.getDocument().at("parameters").at("filters")) == filters,
+        "streamed floats read back exactly");
+
+  nlohmann::ordered_json filtersJson;
+  filtersJson["parameters"]["filters"] = filters;
+  QFile filtersFile(filtersPath);
+  CHECK(filtersFile.open(QIODevice::ReadOnly) && filtersFile.readAll().toStdString() == filtersJson.dump(4),
+        "streamed floats match json.dump(4)");
+
+  // A reference reaching past the stored values is rejected instead of read out of bounds
+  nlohmann::ordered_json overrunDocument;
+  overrunDocument["parameters"]["filters"] = filtersWriter.addTensor(std::vector<float>{1.0f, 2.0f});
+  overrunDocument["parameters"]["filters"]["shape"] = std::vector<ulong>{3};
+  bool rejected = false;
+  try {
+    filtersWriter.writeJson((tempDir() + "/model_overrun.json").toStdString(), overrunDocument);
+  } catch (const std::runtime_error&) {
+    rejected = true;
+  }
+  CHECK(rejected, "tensor reference past the stored values rejected");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+static void testCheckpointWriterCoalesces() {
+  std::cout << "  testCheckpointWriterCoalesces... ";
+
+  CheckpointWriter writer(LogLevel::QUIET);
+  std::mutex mutex;
+  std::vector<std::string> written;
+  std::atomic<bool> started{false};
+  std::atomic<bool> release{false};
+
+  auto record = [&](const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    written.push_back(name);
+  };
+
+  // Hold the writer busy on the first checkpoint while three more arrive
+  writer.submit("a", [&]() {
+    started = true;
+    while (!release) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    record("a");
+  });
+  while (!started) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  writer.submit("b", [&]() { record("b"); });
+  writer.submit("c", [&]() { record("c"); });
+  writer.submit("d", [&]() { record("d"); });
+  release = true;
+  writer.wait();
+
+  CHECK((written == std::vector<std::string>{"a", "d"}), "only the newest waiting checkpoint is written");
+  CHECK(writer.getNumWritten() == 2 && writer.getNumSkipped() == 2, "skipped checkpoints counted");
+
+  // A failing checkpoint does not stop later ones
+  writer.submit("e", []() { throw std::runtime_error("disk full"); });
+  writer.wait();
+  writer.submit("f", [&]() { record("f"); });
+  writer.wait();
+  CHECK(written.back() == "f" && writer.getNumWritten() == 3, "writer continues after a failed checkpoint");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+void runModelFileTests() {
+  testModelFileRoundTrip();
+  testModelFileHeaderOnly();
+  testModelFileJsonWriter();
+  testCheckpointWriterCoalesces();
+}
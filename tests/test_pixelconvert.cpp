@@ -0,0 +1,69 @@
+#include "test_helpers.hpp"
+#include "../NN-CLI_PixelConvert.hpp"
+
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace NN_CLI;
+
+//===================================================================================================================//
+
+static void testPixelConvertKernels() {
+  std::cout << "  testPixelConvertKernels... ";
+
+  // Sizes around the 16-pixel blocks, so every kernel also runs its scalar tail
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::uniform_real_distribution<float> value(-0.25f, 1.25f);
+  const float specials[] = {0.0f, -0.0f, 1.0f, 0.5f / 255.0f, 254.5f / 255.0f, std::nextafter(1.0f, 0.0f),
+                            std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                            std::numeric_limits<float>::quiet_NaN()};
+
+  bool planarMatches = true, interleavedMatches = true;
+  for (int c = 1; c <= 4; c++) {
+    for (size_t numPixels : {size_t(1), size_t(15), size_t(16), size_t(17), size_t(64), size_t(1000)}) {
+      std::vector<unsigned char> pixels(c * numPixels);
+      for (unsigned char& p : pixels) p = static_cast<unsigned char>(byte(rng));
+      std::vector<float> planes(c * numPixels);
+      for (size_t i = 0; i < planes.size(); i++) planes[i] = (i % 5 == 0) ? specials[i / 5 % 9] : value(rng);
+
+      std::vector<float> expectedPlanes(planes.size());
+      std::vector<unsigned char> expectedPixels(pixels.size());
+      PixelConvert::toPlanar(PixelConvert::Isa::SCALAR, pixels.data(), expectedPlanes.data(), c, numPixels);
+      PixelConvert::toInterleaved(PixelConvert::Isa::SCALAR, planes.data(), expectedPixels.data(), c, numPixels);
+
+      for (PixelConvert::Isa isa : PixelConvert::supportedIsas()) {
+        std::vector<float> gotPlanes(planes.size());
+        std::vector<unsigned char> gotPixels(pixels.size());
+        PixelConvert::toPlanar(isa, pixels.data(), gotPlanes.data(), c, numPixels);
+        PixelConvert::toInterleaved(isa, planes.data(), gotPixels.data(), c, numPixels);
+        if (std::memcmp(gotPlanes.data(), expectedPlanes.data(), gotPlanes.size() * sizeof(float)) != 0) {
+          planarMatches = false;
+        }
+        if (gotPixels != expectedPixels) interleavedMatches = false;
+      }
+    }
+  }
+  CHECK(planarMatches, "every kernel matches the scalar planar conversion bit for bit");
+  CHECK(interleavedMatches, "every kernel matches the scalar interleaved conversion");
+
+  // The reference itself: p / 255 in, clamp then round half up out
+  unsigned char pixel = 51;
+  float plane = 0.0f;
+  PixelConvert::toPlanar(&pixel, &plane, 1, 1);
+  CHECK(plane == 51.0f / 255.0f, "pixel normalised to p / 255");
+  const float outOfRange[] = {-1.0f, 2.0f, 0.5f};
+  unsigned char clamped[3];
+  PixelConvert::toInterleaved(outOfRange, clamped, 1, 3);
+  CHECK(clamped[0] == 0 && clamped[1] == 255 && clamped[2] == 128, "values clamped and rounded");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+void runPixelConvertTests() {
+  testPixelConvertKernels();
+}
@@ -0,0 +1,101 @@
+#include "test_helpers.hpp"
+#include "../NN-CLI_JsonLinesReader.hpp"
+#include "../NN-CLI_NpyDataset.hpp"
+#include "../NN-CLI_PredictWriter.hpp"
+
+#include <cstring>
+#include <vector>
+
+using namespace NN_CLI;
+
+//===================================================================================================================//
+
+static void testPredictWriterFormats() {
+  std::cout << "  testPredictWriterFormats... ";
+
+  std::vector<std::vector<float>> first = {{0.5f, -1.0f, 2.25f}, {3.0f, 0.0f, 1e-3f}};
+  std::vector<std::vector<float>> second = {{7.0f, 8.0f, 9.5f}};
+
+  // .npy streamed in two chunks: the row count is completed on close
+  QString npyPath = tempDir() + "/predict_writer.npy";
+  {
+    PredictWriter writer(npyPath.toStdString(), PredictOutputFormat::NPY);
+    writer.write(first);
+    writer.write(second);
+    writer.close();
+    CHECK(writer.getNumRows() == 3 && writer.getRowSize() == 3, "npy rows counted");
+
+    nlohmann::ordered_json metadata;
+    metadata["numInputs"] = 3;
+    writer.writeSidecar(metadata);
+  }
+
+  NpyDataset npy;
+  npy.open(npyPath.toStdString());
+  CHECK(npy.numSamples() == 3 && npy.inputSize() == 3, "npy shape (3, 3)");
+  std::vector<float> row(3);
+  npy.readInput(1, row.data());
+  CHECK(row == first[1], "npy row read back exactly");
+  npy.readInput(2, row.data());
+  CHECK(row == second[0], "npy streamed row read back exactly");
+
+  QFile sidecarFile(QString::fromStdString(PredictWriter::sidecarPath(npyPath.toStdString())));
+  bool sidecarOpened = sidecarFile.open(QIODevice::ReadOnly);
+  CHECK(sidecarOpened, "sidecar written next to the outputs");
+  if (sidecarOpened) {
+    nlohmann::json sidecar = nlohmann::json::parse(sidecarFile.readAll().toStdString());
+    CHECK(sidecar["predictMetadata"]["numInputs"] == 3, "sidecar holds predictMetadata");
+    CHECK(sidecar["outputs"]["format"] == "npy" && sidecar["outputs"]["shape"] == nlohmann::json({3, 3}),
+          "sidecar describes the outputs");
+  }
+
+  // Raw float32: rows back to back, nothing else
+  QString f32Path = tempDir() + "/predict_writer.f32";
+  {
+    PredictWriter writer(f32Path.toStdString(), PredictOutputFormat::F32, first.size());
+    writer.write(first);
+    writer.close();
+  }
+  QFile f32File(f32Path);
+  if (f32File.open(QIODevice::ReadOnly)) {
+    QByteArray bytes = f32File.readAll();
+    CHECK(bytes.size() == 6 * static_cast<int>(sizeof(float)), "f32 file holds exactly the values");
+    std::vector<float> values(6);
+    std::memcpy(values.data(), bytes.data(), bytes.size());
+    CHECK(values[2] == 2.25f && values[5] == 1e-3f, "f32 values in row order");
+  } else {
+    CHECK(false, "f32 file opened");
+  }
+
+  // JSON Lines: one array per row
+  QString jsonlPath = tempDir() + "/predict_writer.jsonl";
+  {
+    PredictWriter writer(jsonlPath.toStdString(), PredictOutputFormat::JSONL);
+    writer.write(first);
+    writer.close();
+  }
+  JsonLinesReader reader(jsonlPath.toStdString());
+  std::vector<StreamedValue> lines = reader.readChunk(10);
+  CHECK(lines.size() == 2, "jsonl has one line per output");
+
+  // Mixed row sizes cannot form a matrix
+  bool threw = false;
+  try {
+    PredictWriter writer(f32Path.toStdString(), PredictOutputFormat::F32);
+    writer.write({{1.0f, 2.0f}, {3.0f}});
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  CHECK(threw, "ragged outputs rejected for binary formats");
+
+  CHECK(PredictWriter::formatFromPath("out/predict.npy") == PredictOutputFormat::NPY, "format from .npy path");
+  CHECK(!PredictWriter::formatFromPath("out/predict").has_value(), "no format without an extension");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+void runPredictWriterTests() {
+  testPredictWriterFormats();
+}
@@ -0,0 +1,237 @@
+#include "test_helpers.hpp"
+#include "../NN-CLI_Server.hpp"
+
+#include <QProcess>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NN_CLI;
+
+//===================================================================================================================//
+
+static int connectUnix(const std::string& path) {
+  int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+  if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+    ::close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+//===================================================================================================================//
+
+// Send one request frame and read the response frame. Returns the response format byte (or -1 on failure).
+static int exchange(int fd, FrameFormat format, const std::string& payload, std::string& response) {
+  uint32_t size = static_cast<uint32_t>(payload.size());
+  std::string frame;
+  frame.push_back(static_cast<char>(format));
+  for (int i = 0; i < 4; i++) frame.push_back(static_cast<char>((size >> (8 * i)) & 0xFF));
+  frame += payload;
+  if (::send(fd, frame.data(), frame.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(frame.size())) return -1;
+
+  unsigned char header[5];
+  if (::recv(fd, header, sizeof(header), MSG_WAITALL) != static_cast<ssize_t>(sizeof(header))) return -1;
+  uint32_t responseSize = static_cast<uint32_t>(header[1]) | static_cast<uint32_t>(header[2]) << 8 |
+                          static_cast<uint32_t>(header[3]) << 16 | static_cast<uint32_t>(header[4]) << 24;
+  response.assign(responseSize, '\0');
+  if (responseSize > 0 && ::recv(fd, &response[0], responseSize, MSG_WAITALL) != static_cast<ssize_t>(responseSize)) {
+    return -1;
+  }
+  return header[0];
+}
+
+//===================================================================================================================//
+
+static void testServeRequests() {
+  std::cout << "  testServeRequests... ";
+
+  // Stand-in model: doubles every value, on whichever worker the request gets
+  Server server(2, [](ulong, std::vector<float>&& input) {
+    for (float& v : input) v *= 2.0f;
+    return std::move(input);
+  }, LogLevel::ERROR);
+
+  std::string socketPath = (tempDir() + "/serve_test.sock").toStdString();
+  server.listenUnix(socketPath);
+  std::thread serving([&server]() { server.run(); });
+
+  int fd = connectUnix(socketPath);
+  CHECK(fd >= 0, "client connects to the Unix socket");
+
+  // Raw float32 request and response
+  std::vector<float> values = {1.0f, -2.5f, 0.25f};
+  std::string rawRequest(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+  std::string response;
+  int format = exchange(fd, FrameFormat::FLOAT32, rawRequest, response);
+  std::vector<float> doubled(response.size() / sizeof(float));
+  std::memcpy(doubled.data(), response.data(), response.size());
+  CHECK(format == static_cast<int>(FrameFormat::FLOAT32) && doubled == std::vector<float>({2.0f, -5.0f, 0.5f}),
+        "float32 request answered with float32 outputs");
+
+  // JSON on the same connection, answered with the output and its latency
+  format = exchange(fd, FrameFormat::JSON, "[1, 2]", response);
+  CHECK(format == static_cast<int>(FrameFormat::JSON) && response.find("\"output\":[2.0,4.0]") != std::string::npos &&
+        response.find("\"latencyMs\"") != std::string::npos, "JSON request answered with output and latency");
+
+  // A malformed request gets an error frame; the connection stays usable
+  format = exchange(fd, FrameFormat::JSON, "[1, oops]", response);
+  CHECK(format == static_cast<int>(FrameFormat::ERROR), "malformed request answered with an error frame");
+  format = exchange(fd, FrameFormat::JSON, "[3]", response);
+  CHECK(format == static_cast<int>(FrameFormat::JSON), "connection usable after an error");
+
+  // Stopping shuts down the idle connection, so run() returns
+  server.stop();
+  serving.join();
+  char byte;
+  CHECK(::recv(fd, &byte, 1, 0) == 0, "open connection closed on stop");
+  ::close(fd);
+  CHECK(server.getNumRequests() == 3, "successful requests counted");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+static void testServeOutlivesDescriptorShortage() {
+  std::cout << "  testServeOutlivesDescriptorShortage... ";
+
+  Server server(1, [](ulong, std::vector<float>&& input) { return std::move(input); }, LogLevel::ERROR);
+  std::string socketPath = (tempDir() + "/serve_shortage.sock").toStdString();
+  server.listenUnix(socketPath);
+  bool stopped = false;
+  std::thread serving([&server, &stopped]() { stopped = server.run(); });
+
+  // Use up every descriptor under a lowered limit, the last one by a client, so accept() fails with EMFILE
+  rlimit savedLimit{};
+  ::getrlimit(RLIMIT_NOFILE, &savedLimit);
+  rlimit lowLimit = savedLimit;
+  lowLimit.rlim_cur = std::min<rlim_t>(savedLimit.rlim_cur, 512);
+  ::setrlimit(RLIMIT_NOFILE, &lowLimit);
+
+  std::vector<int> fillers;
+  for (int fd = ::open("/dev/null", O_RDONLY); fd >= 0; fd = ::open("/dev/null", O_RDONLY)) fillers.push_back(fd);
+  if (!fillers.empty()) {
+    ::close(fillers.back());
+    fillers.pop_back();
+  }
+  int client = connectUnix(socketPath);
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  for (int fd : fillers) ::close(fd);
+  ::setrlimit(RLIMIT_NOFILE, &savedLimit);
+
+  // Once descriptors are free again the waiting client is accepted and answered (the timeout catches a server that gave up)
+  timeval timeout{5, 0};
+  if (client >= 0) ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  std::string response;
+  int format = (client >= 0) ? exchange(client, FrameFormat::JSON, "[5]", response) : -1;
+  CHECK(client >= 0 && format == static_cast<int>(FrameFormat::JSON), "client served after a descriptor shortage");
+
+  server.stop();
+  serving.join();
+  if (client >= 0) ::close(client);
+  CHECK(stopped && server.getError().empty(), "run() reports a clean stop");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+static void testServeKeepsNonSocketPath() {
+  std::cout << "  testServeKeepsNonSocketPath... ";
+
+  // A mistyped --socket pointing at a regular file must not delete it
+  QString filePath = tempDir() + "/not_a_socket.txt";
+  QFile file(filePath);
+  if (file.open(QIODevice::WriteOnly)) {
+    file.write("keep me");
+    file.close();
+  }
+
+  Server server(1, [](ulong, std::vector<float>&& input) { return std::move(input); }, LogLevel::ERROR);
+  bool threw = false;
+  try {
+    server.listenUnix(filePath.toStdString());
+  } catch (const std::exception&) {
+    threw = true;
+  }
+  CHECK(threw, "listening on a regular file fails");
+  CHECK(QFile::exists(filePath), "regular file at the socket path is left in place");
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+static void testServeModeThroughRunner() {
+  std::cout << "  testServeModeThroughRunner... ";
+
+  if (trainedANNModelPath.isEmpty() || !QFile::exists(trainedANNModelPath)) {
+    CHECK(false, "Serve mode: skipped — no trained model available (testANNTrainXOR must run first)");
+    std::cout << std::endl;
+    return;
+  }
+
+  // Run the real binary so the Runner builds the core that serve mode answers with
+  QString socketPath = tempDir() + "/serve_runner.sock";
+  QProcess process;
+  process.setWorkingDirectory(projectRoot());
+  process.start(nncliPath(), {
+    "--config", trainedANNModelPath,
+    "--mode", "serve",
+    "--device", "cpu",
+    "--socket", socketPath
+  });
+  CHECK(process.waitForStarted(5000), "Serve mode: process starts");
+
+  QString startup;
+  while (!startup.contains("Serving on") && process.waitForReadyRead(10000)) {
+    startup += QString::fromUtf8(process.readAllStandardOutput());
+  }
+  CHECK(startup.contains("Serving on"), "Serve mode: server reports it is listening");
+
+  int fd = connectUnix(socketPath.toStdString());
+  CHECK(fd >= 0, "Serve mode: client connects to the Unix socket");
+
+  if (fd >= 0) {
+    std::string response;
+    int format = exchange(fd, FrameFormat::JSON, "[0, 1]", response);
+    CHECK(format == static_cast<int>(FrameFormat::JSON) && response.find("\"output\":[") != std::string::npos,
+          "Serve mode: request answered by the loaded model");
+    ::close(fd);
+  }
+
+  // SIGTERM stops the server cleanly
+  process.terminate();
+  CHECK(process.waitForFinished(10000), "Serve mode: process exits on SIGTERM");
+  CHECK(process.exitStatus() == QProcess::NormalExit && process.exitCode() == 0, "Serve mode: exit code 0");
+  if (process.state() != QProcess::NotRunning) {
+    process.kill();
+    process.waitForFinished(3000);
+  }
+
+  std::cout << std::endl;
+}
+
+//===================================================================================================================//
+
+void runServerTests() {
+  testServeRequests();
+  testServeOutlivesDescriptorShortage();
+  testServeKeepsNonSocketPath();
+  testServeModeThroughRunner();
+}